@@ -45,6 +45,56 @@ void NAME ## _row_ ## LEFT ## _ ## RIGHT(char *Target, ml_array_dimension_t *Lef
 	} \
 }
 
+#define COMPARE_ROW_DENSE_IMPL(NAME, OP, TYPE) \
+\
+static ML_ARRAY_KERNEL void NAME ## _dense_ ## TYPE(char *Target, const TYPE *Left, const TYPE *Right, int Size) { \
+	for (int I = 0; I < Size; ++I) Target[I] = OP(Left[I], Right[I]); \
+} \
+\
+static ML_ARRAY_KERNEL void NAME ## _dense_scalar_ ## TYPE(char *Target, const TYPE *Left, TYPE Right, int Size) { \
+	for (int I = 0; I < Size; ++I) Target[I] = OP(Left[I], Right); \
+} \
+\
+void NAME ## _row_dense_ ## TYPE(char *Target, ml_array_dimension_t *LeftDimension, char *LeftData, ml_array_dimension_t *RightDimension, char *RightData) { \
+	if (LeftDimension->Indices || RightDimension->Indices || LeftDimension->Stride != sizeof(TYPE)) { \
+		NAME ## _row_ ## TYPE ## _ ## TYPE(Target, LeftDimension, LeftData, RightDimension, RightData); \
+	} else if (RightDimension->Stride == sizeof(TYPE)) { \
+		NAME ## _dense_ ## TYPE(Target, (TYPE *)LeftData, (TYPE *)RightData, LeftDimension->Size); \
+	} else if (RightDimension->Stride == 0) { \
+		NAME ## _dense_scalar_ ## TYPE(Target, (TYPE *)LeftData, *(TYPE *)RightData, LeftDimension->Size); \
+	} else { \
+		NAME ## _row_ ## TYPE ## _ ## TYPE(Target, LeftDimension, LeftData, RightDimension, RightData); \
+	} \
+}
+
+#define COMPARE_ROW_DENSE_IMPLS(NAME, OP) \
+COMPARE_ROW_DENSE_IMPL(NAME, OP, uint8_t) \
+COMPARE_ROW_DENSE_IMPL(NAME, OP, int8_t) \
+COMPARE_ROW_DENSE_IMPL(NAME, OP, uint16_t) \
+COMPARE_ROW_DENSE_IMPL(NAME, OP, int16_t) \
+COMPARE_ROW_DENSE_IMPL(NAME, OP, uint32_t) \
+COMPARE_ROW_DENSE_IMPL(NAME, OP, int32_t) \
+COMPARE_ROW_DENSE_IMPL(NAME, OP, uint64_t) \
+COMPARE_ROW_DENSE_IMPL(NAME, OP, int64_t) \
+COMPARE_ROW_DENSE_IMPL(NAME, OP, float) \
+COMPARE_ROW_DENSE_IMPL(NAME, OP, double)
+
+#define COMPARE_ROW_DENSE_ENTRY(FORMAT, NAME, TYPE) \
+	[MAX_FORMATS * (FORMAT) + (FORMAT)] = NAME ## _row_dense_ ## TYPE
+
+// Listed after the generic entries so that they override the same-format slots.
+#define COMPARE_ROW_DENSE_ENTRIES(NAME) \
+COMPARE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_U8, NAME, uint8_t), \
+COMPARE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_I8, NAME, int8_t), \
+COMPARE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_U16, NAME, uint16_t), \
+COMPARE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_I16, NAME, int16_t), \
+COMPARE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_U32, NAME, uint32_t), \
+COMPARE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_I32, NAME, int32_t), \
+COMPARE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_U64, NAME, uint64_t), \
+COMPARE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_I64, NAME, int64_t), \
+COMPARE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_F32, NAME, float), \
+COMPARE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_F64, NAME, double)
+
 #define ml_number(X) _Generic(X, ml_value_t *: ml_nop, double: ml_real, default: ml_integer)(X)
 
 #define COMPARE_ROW_VALUE_IMPL(NAME, OP, METH, RIGHT) \
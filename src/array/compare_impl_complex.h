@@ -147,7 +147,9 @@ typedef void (*compare_row_fn_t)(char *Target, ml_array_dimension_t *LeftDimensi
 
 #define COMPARE_FNS(TITLE, NAME, OP, METH) \
 	COMPARE_ROW_OPS_IMPL(NAME, OP, METH) \
+	COMPARE_ROW_DENSE_IMPLS(NAME, OP) \
 \
 compare_row_fn_t Compare ## TITLE ## RowFns[MAX_FORMATS * MAX_FORMATS] = { \
-	COMPARE_ROW_OPS_ENTRIES(NAME) \
+	COMPARE_ROW_OPS_ENTRIES(NAME), \
+	COMPARE_ROW_DENSE_ENTRIES(NAME) \
 }
@@ -0,0 +1,173 @@
+#include "../ml_array.h"
+#include "../ml_macros.h"
+#include <string.h>
+
+// Packed matrix multiply in the GotoBLAS / BLIS style. For each GEMM_KC x GEMM_NC
+// block of B and GEMM_MC x GEMM_KC block of A, the operands are copied into
+// contiguous MR / NR wide micro-panels and every MR x NR tile of C is accumulated
+// in registers. Complex operands are packed as separate real and imaginary
+// planes so that the inner loops stay purely real and vectorise.
+
+#define GEMM_MC 96
+#define GEMM_KC 256
+#define GEMM_NC 2048
+
+// Minimum number of multiply-adds before the rows of C are split across threads.
+#define GEMM_THREAD_WORK (1 << 24)
+
+#define MIN(X, Y) (((X) < (Y)) ? (X) : (Y))
+
+typedef void (*gemm_rows_fn)(int M, int N, int K, char **RowsA, int StrideA, char **RowsB, int StrideB, char **RowsC, int Mode, void *PackedA, void *PackedB);
+
+#define GEMM_IMPL(NAME, RTYPE, PARTS, MR, NR) \
+\
+static void gemm_pack_a_ ## NAME(int MC, int KC, char **Rows, size_t Offset, int Stride, RTYPE *Packed) { \
+	int Plane = ((MC + MR - 1) / MR) * MR * KC; \
+	for (int I = 0; I < MC; I += MR) { \
+		for (int K = 0; K < KC; ++K) { \
+			for (int R = 0; R < MR; ++R) { \
+				if (I + R < MC) { \
+					RTYPE *Value = (RTYPE *)(Rows[I + R] + Offset + (size_t)K * Stride); \
+					for (int P = 0; P < PARTS; ++P) Packed[P * Plane] = Value[P]; \
+				} else { \
+					for (int P = 0; P < PARTS; ++P) Packed[P * Plane] = 0; \
+				} \
+				++Packed; \
+			} \
+		} \
+	} \
+} \
+\
+static void gemm_pack_b_ ## NAME(int KC, int NC, char **Rows, size_t Offset, int Stride, RTYPE *Packed) { \
+	int Plane = ((NC + NR - 1) / NR) * NR * KC; \
+	for (int J = 0; J < NC; J += NR) { \
+		for (int K = 0; K < KC; ++K) { \
+			char *Row = Rows[K] + Offset + (size_t)J * Stride; \
+			for (int C = 0; C < NR; ++C) { \
+				if (J + C < NC) { \
+					RTYPE *Value = (RTYPE *)(Row + (size_t)C * Stride); \
+					for (int P = 0; P < PARTS; ++P) Packed[P * Plane] = Value[P]; \
+				} else { \
+					for (int P = 0; P < PARTS; ++P) Packed[P * Plane] = 0; \
+				} \
+				++Packed; \
+			} \
+		} \
+	} \
+} \
+\
+static ML_ARRAY_KERNEL void gemm_block_ ## NAME(int MC, int NC, int KC, const RTYPE *PackedA, const RTYPE *PackedB, char **RowsC, size_t Offset, int Mode) { \
+	int PlaneA = ((MC + MR - 1) / MR) * MR * KC; \
+	int PlaneB = ((NC + NR - 1) / NR) * NR * KC; \
+	for (int J = 0; J < NC; J += NR) { \
+		for (int I = 0; I < MC; I += MR) { \
+			const RTYPE *A = PackedA + I * KC; \
+			const RTYPE *B = PackedB + J * KC; \
+			RTYPE Acc[PARTS][MR][NR]; \
+			for (int P = 0; P < PARTS; ++P) { \
+				for (int R = 0; R < MR; ++R) { \
+					for (int C = 0; C < NR; ++C) Acc[P][R][C] = 0; \
+				} \
+			} \
+			for (int K = 0; K < KC; ++K) { \
+				for (int R = 0; R < MR; ++R) { \
+					for (int C = 0; C < NR; ++C) { \
+						if (PARTS == 1) { \
+							Acc[0][R][C] += A[R] * B[C]; \
+						} else { \
+							Acc[0][R][C] += A[R] * B[C] - A[PlaneA + R] * B[PlaneB + C]; \
+							Acc[PARTS - 1][R][C] += A[R] * B[PlaneB + C] + A[PlaneA + R] * B[C]; \
+						} \
+					} \
+				} \
+				A += MR; \
+				B += NR; \
+			} \
+			int Rows = MIN(MR, MC - I), Cols = MIN(NR, NC - J); \
+			for (int R = 0; R < Rows; ++R) { \
+				RTYPE *Target = (RTYPE *)(RowsC[I + R] + Offset) + J * PARTS; \
+				for (int C = 0; C < Cols; ++C) { \
+					for (int P = 0; P < PARTS; ++P) { \
+						if (Mode == ML_ARRAY_GEMM_SET) { \
+							Target[C * PARTS + P] = Acc[P][R][C]; \
+						} else if (Mode == ML_ARRAY_GEMM_ADD) { \
+							Target[C * PARTS + P] += Acc[P][R][C]; \
+						} else { \
+							Target[C * PARTS + P] -= Acc[P][R][C]; \
+						} \
+					} \
+				} \
+			} \
+		} \
+	} \
+} \
+\
+static void gemm_rows_ ## NAME(int M, int N, int K, char **RowsA, int StrideA, char **RowsB, int StrideB, char **RowsC, int Mode, void *PackedA, void *PackedB) { \
+	for (int J0 = 0; J0 < N; J0 += GEMM_NC) { \
+		int NC = MIN(GEMM_NC, N - J0); \
+		for (int K0 = 0; K0 < K; K0 += GEMM_KC) { \
+			int KC = MIN(GEMM_KC, K - K0); \
+			int BlockMode = (Mode == ML_ARRAY_GEMM_SET && K0) ? ML_ARRAY_GEMM_ADD : Mode; \
+			gemm_pack_b_ ## NAME(KC, NC, RowsB + K0, (size_t)J0 * StrideB, StrideB, PackedB); \
+			for (int I0 = 0; I0 < M; I0 += GEMM_MC) { \
+				int MC = MIN(GEMM_MC, M - I0); \
+				gemm_pack_a_ ## NAME(MC, KC, RowsA + I0, (size_t)K0 * StrideA, StrideA, PackedA); \
+				gemm_block_ ## NAME(MC, NC, KC, PackedA, PackedB, RowsC + I0, (size_t)J0 * PARTS * sizeof(RTYPE), BlockMode); \
+			} \
+		} \
+	} \
+} \
+\
+void ml_array_gemm_ ## NAME(int M, int N, int K, char **RowsA, int StrideA, char **RowsB, int StrideB, char **RowsC, ml_array_gemm_mode_t Mode) { \
+	if (!M || !N) return; \
+	if (!K) { \
+		if (Mode == ML_ARRAY_GEMM_SET) { \
+			for (int I = 0; I < M; ++I) memset(RowsC[I], 0, (size_t)N * PARTS * sizeof(RTYPE)); \
+		} \
+		return; \
+	} \
+	size_t SizeA = GEMM_MC * GEMM_KC * PARTS; \
+	size_t SizeB = ((MIN(N, GEMM_NC) + NR - 1) / NR) * NR * GEMM_KC * PARTS; \
+	gemm_run(gemm_rows_ ## NAME, M, N, K, RowsA, StrideA, RowsB, StrideB, RowsC, Mode, SizeA * sizeof(RTYPE), SizeB * sizeof(RTYPE)); \
+}
+
+typedef struct {
+	gemm_rows_fn rows;
+	char **RowsA, **RowsB, **RowsC;
+	void **PackedA, **PackedB;
+	int M, N, K, StrideA, StrideB, Mode, RowsPerTask;
+} gemm_task_t;
+
+static void gemm_task_fn(gemm_task_t *Task, int Index) {
+	int Start = Index * Task->RowsPerTask;
+	int M = MIN(Task->RowsPerTask, Task->M - Start);
+	Task->rows(M, Task->N, Task->K, Task->RowsA + Start, Task->StrideA, Task->RowsB, Task->StrideB, Task->RowsC + Start, Task->Mode, Task->PackedA[Index], Task->PackedB[Index]);
+}
+
+static void gemm_run(gemm_rows_fn rows, int M, int N, int K, char **RowsA, int StrideA, char **RowsB, int StrideB, char **RowsC, int Mode, size_t SizeA, size_t SizeB) {
+	// Each task takes a contiguous range of row blocks of C and packs its own copy of B.
+	int NumBlocks = (M + GEMM_MC - 1) / GEMM_MC;
+	int NumTasks = 1;
+	if ((double)M * N * K >= GEMM_THREAD_WORK) NumTasks = MIN(ml_array_threads(), NumBlocks);
+	int BlocksPerTask = (NumBlocks + NumTasks - 1) / NumTasks;
+	int RowsPerTask = BlocksPerTask * GEMM_MC;
+	NumTasks = (M + RowsPerTask - 1) / RowsPerTask;
+	// The packing buffers are allocated by the calling thread so that the workers do not allocate from the collector.
+	void **PackedA = anew(void *, NumTasks), **PackedB = anew(void *, NumTasks);
+	for (int I = 0; I < NumTasks; ++I) {
+		PackedA[I] = snew(SizeA);
+		PackedB[I] = snew(SizeB);
+	}
+	gemm_task_t Task[1] = {{rows, RowsA, RowsB, RowsC, PackedA, PackedB, M, N, K, StrideA, StrideB, Mode, RowsPerTask}};
+	ml_array_parallel(NumTasks, (ml_array_parallel_fn)gemm_task_fn, Task);
+}
+
+GEMM_IMPL(float, float, 1, 4, 32)
+GEMM_IMPL(double, double, 1, 4, 8)
+
+#ifdef ML_COMPLEX
+
+GEMM_IMPL(complex_float, float, 2, 2, 16)
+GEMM_IMPL(complex_double, double, 2, 2, 16)
+
+#endif
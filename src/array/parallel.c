@@ -0,0 +1,138 @@
+#include "../ml_array.h"
+#include "../ml_macros.h"
+#include <stdlib.h>
+
+#ifdef ML_THREADS
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <unistd.h>
+#endif
+
+// Array thread pool. Workers are started on first use and then wait for jobs,
+// each job is a number of independent chunks claimed in turn by the workers and
+// the calling thread. Callers choose the chunks, so results do not depend on the
+// number of threads.
+
+#define ML_ARRAY_MAX_THREADS 256
+
+int MLArrayParallelGrain = 1 << 15;
+
+static int PoolThreads = 0;
+
+static int ml_array_threads_clamp(int Threads) {
+	if (Threads < 1) return 1;
+	if (Threads > ML_ARRAY_MAX_THREADS) return ML_ARRAY_MAX_THREADS;
+	return Threads;
+}
+
+int ml_array_threads(void) {
+#ifdef ML_THREADS
+	if (!PoolThreads) {
+		const char *Env = getenv("MINILANG_ARRAY_THREADS");
+		PoolThreads = ml_array_threads_clamp(Env ? atoi(Env) : sysconf(_SC_NPROCESSORS_ONLN));
+	}
+	return PoolThreads;
+#else
+	return 1;
+#endif
+}
+
+void ml_array_threads_set(int Threads) {
+	PoolThreads = ml_array_threads_clamp(Threads);
+}
+
+#ifdef ML_THREADS
+
+typedef struct {
+	ml_array_parallel_fn Fn;
+	void *Data;
+	int Count;
+	atomic_int Next, Running;
+} ml_array_job_t;
+
+static pthread_mutex_t JobLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t PoolLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t PoolStart = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t PoolDone = PTHREAD_COND_INITIALIZER;
+static ml_array_job_t *PoolJob = NULL;
+static unsigned int PoolGeneration = 0;
+static unsigned int PoolBorn[ML_ARRAY_MAX_THREADS];
+static int PoolWorkers = 0, PoolActive = 0;
+static __thread int InParallel = 0;
+
+static void ml_array_job_run(ml_array_job_t *Job) {
+	int Index;
+	while ((Index = atomic_fetch_add(&Job->Next, 1)) < Job->Count) Job->Fn(Job->Data, Index);
+	if (atomic_fetch_sub(&Job->Running, 1) == 1) {
+		pthread_mutex_lock(&PoolLock);
+		pthread_cond_broadcast(&PoolDone);
+		pthread_mutex_unlock(&PoolLock);
+	}
+}
+
+static void *ml_array_worker_fn(void *Arg) {
+	int Id = (intptr_t)Arg;
+	InParallel = 1;
+	pthread_mutex_lock(&PoolLock);
+	unsigned int Seen = PoolBorn[Id];
+	for (;;) {
+		while (PoolGeneration == Seen) pthread_cond_wait(&PoolStart, &PoolLock);
+		Seen = PoolGeneration;
+		// Only the first PoolActive workers were counted in Job->Running.
+		ml_array_job_t *Job = Id < PoolActive ? PoolJob : NULL;
+		pthread_mutex_unlock(&PoolLock);
+		if (Job) ml_array_job_run(Job);
+		pthread_mutex_lock(&PoolLock);
+	}
+	return NULL;
+}
+
+void ml_array_parallel(int Count, ml_array_parallel_fn Fn, void *Data) {
+	int Threads = ml_array_threads();
+	if (Threads > Count) Threads = Count;
+	if (Threads <= 1 || InParallel || pthread_mutex_trylock(&JobLock)) {
+		for (int Index = 0; Index < Count; ++Index) Fn(Data, Index);
+		return;
+	}
+	ml_array_job_t Job[1];
+	Job->Fn = Fn;
+	Job->Data = Data;
+	Job->Count = Count;
+	atomic_init(&Job->Next, 0);
+	pthread_mutex_lock(&PoolLock);
+	if (PoolWorkers < Threads - 1) {
+		pthread_attr_t Attr;
+		pthread_attr_init(&Attr);
+		pthread_attr_setdetachstate(&Attr, PTHREAD_CREATE_DETACHED);
+		while (PoolWorkers < Threads - 1) {
+			pthread_t Thread;
+			PoolBorn[PoolWorkers] = PoolGeneration;
+			if (GC_pthread_create(&Thread, &Attr, ml_array_worker_fn, (void *)(intptr_t)PoolWorkers)) break;
+			++PoolWorkers;
+		}
+		pthread_attr_destroy(&Attr);
+	}
+	int Active = Threads - 1 < PoolWorkers ? Threads - 1 : PoolWorkers;
+	atomic_init(&Job->Running, Active + 1);
+	PoolJob = Job;
+	PoolActive = Active;
+	++PoolGeneration;
+	pthread_cond_broadcast(&PoolStart);
+	pthread_mutex_unlock(&PoolLock);
+	InParallel = 1;
+	ml_array_job_run(Job);
+	InParallel = 0;
+	pthread_mutex_lock(&PoolLock);
+	while (atomic_load(&Job->Running)) pthread_cond_wait(&PoolDone, &PoolLock);
+	pthread_mutex_unlock(&PoolLock);
+	pthread_mutex_unlock(&JobLock);
+}
+
+#else
+
+void ml_array_parallel(int Count, ml_array_parallel_fn Fn, void *Data) {
+	for (int Index = 0; Index < Count; ++Index) Fn(Data, Index);
+}
+
+#endif
@@ -43,6 +43,56 @@ void NAME ## _row_ ## TARGET ## _ ## SOURCE(ml_array_dimension_t *TargetDimensio
 	} \
 }
 
+#define UPDATE_ROW_DENSE_IMPL(NAME, OP, TYPE) \
+\
+static ML_ARRAY_KERNEL void NAME ## _dense_ ## TYPE(TYPE *Target, const TYPE *Source, int Size) { \
+	for (int I = 0; I < Size; ++I) Target[I] = OP(Target[I], Source[I]); \
+} \
+\
+static ML_ARRAY_KERNEL void NAME ## _dense_scalar_ ## TYPE(TYPE *Target, TYPE Source, int Size) { \
+	for (int I = 0; I < Size; ++I) Target[I] = OP(Target[I], Source); \
+} \
+\
+void NAME ## _row_dense_ ## TYPE(ml_array_dimension_t *TargetDimension, char *TargetData, ml_array_dimension_t *SourceDimension, char *SourceData) { \
+	if (TargetDimension->Indices || SourceDimension->Indices || TargetDimension->Stride != sizeof(TYPE)) { \
+		NAME ## _row_ ## TYPE ## _ ## TYPE(TargetDimension, TargetData, SourceDimension, SourceData); \
+	} else if (SourceDimension->Stride == sizeof(TYPE)) { \
+		NAME ## _dense_ ## TYPE((TYPE *)TargetData, (TYPE *)SourceData, TargetDimension->Size); \
+	} else if (SourceDimension->Stride == 0) { \
+		NAME ## _dense_scalar_ ## TYPE((TYPE *)TargetData, *(TYPE *)SourceData, TargetDimension->Size); \
+	} else { \
+		NAME ## _row_ ## TYPE ## _ ## TYPE(TargetDimension, TargetData, SourceDimension, SourceData); \
+	} \
+}
+
+#define UPDATE_ROW_DENSE_IMPLS(NAME, OP) \
+UPDATE_ROW_DENSE_IMPL(NAME, OP, uint8_t) \
+UPDATE_ROW_DENSE_IMPL(NAME, OP, int8_t) \
+UPDATE_ROW_DENSE_IMPL(NAME, OP, uint16_t) \
+UPDATE_ROW_DENSE_IMPL(NAME, OP, int16_t) \
+UPDATE_ROW_DENSE_IMPL(NAME, OP, uint32_t) \
+UPDATE_ROW_DENSE_IMPL(NAME, OP, int32_t) \
+UPDATE_ROW_DENSE_IMPL(NAME, OP, uint64_t) \
+UPDATE_ROW_DENSE_IMPL(NAME, OP, int64_t) \
+UPDATE_ROW_DENSE_IMPL(NAME, OP, float) \
+UPDATE_ROW_DENSE_IMPL(NAME, OP, double)
+
+#define UPDATE_ROW_DENSE_ENTRY(FORMAT, NAME, TYPE) \
+	[MAX_FORMATS * (FORMAT) + (FORMAT)] = NAME ## _row_dense_ ## TYPE
+
+// Listed after the generic entries so that they override the same-format slots.
+#define UPDATE_ROW_DENSE_ENTRIES(NAME) \
+UPDATE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_U8, NAME, uint8_t), \
+UPDATE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_I8, NAME, int8_t), \
+UPDATE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_U16, NAME, uint16_t), \
+UPDATE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_I16, NAME, int16_t), \
+UPDATE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_U32, NAME, uint32_t), \
+UPDATE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_I32, NAME, int32_t), \
+UPDATE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_U64, NAME, uint64_t), \
+UPDATE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_I64, NAME, int64_t), \
+UPDATE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_F32, NAME, float), \
+UPDATE_ROW_DENSE_ENTRY(ML_ARRAY_FORMAT_F64, NAME, double)
+
 #define ml_number(X) _Generic(X, ml_value_t *: ml_nop, double: ml_real, default: ml_integer)(X)
 
 #define UPDATE_ROW_VALUE_IMPL(NAME, OP, SOURCE) \
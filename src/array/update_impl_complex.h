@@ -171,7 +171,9 @@ typedef void (*update_row_fn_t)(ml_array_dimension_t *TargetDimension, char *Tar
 
 #define UPDATE_FNS(TITLE, NAME, OP, OP2) \
 	UPDATE_ROW_OPS_IMPL(NAME, OP, OP2) \
+	UPDATE_ROW_DENSE_IMPLS(NAME, OP) \
 \
 update_row_fn_t Update ## TITLE ## RowFns[MAX_FORMATS * MAX_FORMATS] = { \
-	UPDATE_ROW_OPS_ENTRIES(NAME) \
+	UPDATE_ROW_OPS_ENTRIES(NAME), \
+	UPDATE_ROW_DENSE_ENTRIES(NAME) \
 }
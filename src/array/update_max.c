@@ -1,6 +1,6 @@
 #include "update_impl_real.h"
 
-#define OP_MAX(A, B) (A > B ? A : B)
+#define OP_MAX(A, B) ({ typeof(A) _B = (B); A > _B ? A : _B; })
 
 extern ml_value_t *MaxMethod;
 
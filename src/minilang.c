@@ -383,6 +383,9 @@ int main(int Argc, const char *Argv[]) {
 #endif
 #ifdef ML_SCHEDULER
 	int SliceSize = 250;
+#ifdef ML_HOSTTHREADS
+	int NumWorkers = 0;
+#endif
 #endif
 	const char *DebugAddr = NULL;
 	const char *Command = NULL;
@@ -466,6 +469,15 @@ int main(int Argc, const char *Argv[]) {
 			case '-': {
 				if (!strcmp(Argv[I] + 2, "gc:disable")) {
 					GC_disable();
+#if defined(ML_SCHEDULER) && defined(ML_HOSTTHREADS)
+				} else if (!strcmp(Argv[I] + 2, "scheduler:workers")) {
+					if (++I < Argc) {
+						NumWorkers = atoi(Argv[I]);
+					} else {
+						fprintf(stderr, "Error: worker count required\n");
+						exit(-1);
+					}
+#endif
 				} else if (!strcmp(Argv[I] + 2, "gc:maxheap")) {
 					if (++I < Argc) {
 						char *End;
@@ -491,6 +503,11 @@ int main(int Argc, const char *Argv[]) {
 	ml_state_t *Main = ml_state(NULL);
 	Main->run = ml_main_state_run;
 #ifdef ML_SCHEDULER
+#ifdef ML_HOSTTHREADS
+	if (NumWorkers > 1) {
+		ml_default_pool_init(Main->Context, NumWorkers, SliceSize ?: 250);
+	} else
+#endif
 	if (SliceSize) ml_default_queue_init(Main->Context, SliceSize);
 #endif
 #ifdef Linux
@@ -8,6 +8,14 @@
 #include <float.h>
 #include <inttypes.h>
 
+#ifdef ML_MMAP
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #ifdef ML_COMPLEX
 #include <complex.h>
 #undef I
@@ -587,6 +595,7 @@ static void ml_array_typed_new_fnx(ml_state_t *Caller, void *Data, int Count, ml
 		size_t Size = Array->Dimensions[0].Size = ml_address_length(Args[0]) / MLArraySizes[Format];
 		size_t Stride = Array->Dimensions[0].Stride = MLArraySizes[Format];
 		Array->Base.Value = (void *)ml_address_value(Args[0]);
+		Array->View = 1;
 		Array->Base.Length = Size * Stride;
 		ML_RETURN(Array);
 	} else {
@@ -647,10 +656,267 @@ ML_FUNCTION(MLArrayWrap) {
 	Total += Array->Dimensions[Degree - 1].Stride;
 	if (Total > ml_address_length(Args[1])) return ml_error("ValueError", "Size larger than buffer");
 	Array->Base.Value = ((ml_address_t *)Args[1])->Value;
+	Array->View = 1;
 	Array->Base.Length = Total;
 	return (ml_value_t *)Array;
 }
 
+#ifdef ML_MMAP
+
+// Mapped arrays are stored in NumPy's .npy format: a magic string, version and
+// header length followed by a Python dictionary literal giving the element type
+// and shape, padded so that the values start on a 64 byte boundary. Mappings are
+// never unmapped since other arrays may share the same values.
+
+#define ML_ARRAY_NPY_MAX_DEGREE 32
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define ML_ARRAY_NPY_ORDER '<'
+#else
+#define ML_ARRAY_NPY_ORDER '>'
+#endif
+
+static const char *MLArrayNpyTypes[] = {
+	[ML_ARRAY_FORMAT_U8] = "u1",
+	[ML_ARRAY_FORMAT_I8] = "i1",
+	[ML_ARRAY_FORMAT_U16] = "u2",
+	[ML_ARRAY_FORMAT_I16] = "i2",
+	[ML_ARRAY_FORMAT_U32] = "u4",
+	[ML_ARRAY_FORMAT_I32] = "i4",
+	[ML_ARRAY_FORMAT_U64] = "u8",
+	[ML_ARRAY_FORMAT_I64] = "i8",
+	[ML_ARRAY_FORMAT_F32] = "f4",
+	[ML_ARRAY_FORMAT_F64] = "f8",
+#ifdef ML_COMPLEX
+	[ML_ARRAY_FORMAT_C32] = "c8",
+	[ML_ARRAY_FORMAT_C64] = "c16",
+#endif
+	[ML_ARRAY_FORMAT_ANY] = NULL
+};
+
+static size_t ml_array_npy_write_header(char *Header, ml_array_format_t Format, int Degree, const int64_t *Shape) {
+	char *End = Header + 10;
+	char Order = MLArraySizes[Format] == 1 ? '|' : ML_ARRAY_NPY_ORDER;
+	End += sprintf(End, "{'descr': '%c%s', 'fortran_order': False, 'shape': (", Order, MLArrayNpyTypes[Format]);
+	for (int I = 0; I < Degree; ++I) End += sprintf(End, I ? ", %" PRId64 : "%" PRId64, Shape[I]);
+	End += sprintf(End, Degree == 1 ? ",), }" : "), }");
+	while ((End - Header + 1) % 64) *End++ = ' ';
+	*End++ = '\n';
+	size_t Length = End - Header;
+	memcpy(Header, "\x93NUMPY\x01\x00", 8);
+	Header[8] = (Length - 10) & 0xFF;
+	Header[9] = (Length - 10) >> 8;
+	return Length;
+}
+
+static ml_value_t *ml_array_npy_read_header(const char *Header, ml_array_format_t *Format, int *Degree, int64_t *Shape) {
+	const char *Descr = strstr(Header, "'descr'");
+	if (!Descr || !(Descr = strchr(Descr + 7, '\''))) return ml_error("FormatError", "Missing array type in header");
+	++Descr;
+	if (Descr[0] == ML_ARRAY_NPY_ORDER || Descr[0] == '|' || Descr[0] == '=') {
+		++Descr;
+	} else if (Descr[0] == '<' || Descr[0] == '>') {
+		return ml_error("FormatError", "Unsupported byte order in header");
+	}
+	*Format = ML_ARRAY_FORMAT_NONE;
+	for (ml_array_format_t I = ML_ARRAY_FORMAT_U8; I < ML_ARRAY_FORMAT_ANY; ++I) {
+		size_t Length = strlen(MLArrayNpyTypes[I]);
+		if (!strncmp(Descr, MLArrayNpyTypes[I], Length) && Descr[Length] == '\'') {
+			*Format = I;
+			break;
+		}
+	}
+	if (!strncmp(Descr, "b1'", 3)) *Format = ML_ARRAY_FORMAT_U8;
+	if (*Format == ML_ARRAY_FORMAT_NONE) return ml_error("FormatError", "Unsupported array type in header");
+	const char *Order = strstr(Header, "'fortran_order'");
+	if (!Order) return ml_error("FormatError", "Missing array order in header");
+	Order += 15;
+	while (*Order == ':' || *Order == ' ') ++Order;
+	if (strncmp(Order, "False", 5)) return ml_error("FormatError", "Column-major arrays are not supported");
+	const char *Next = strstr(Header, "'shape'");
+	if (!Next || !(Next = strchr(Next + 7, '('))) return ml_error("FormatError", "Missing array shape in header");
+	++Next;
+	int Count = 0;
+	for (;;) {
+		while (*Next == ' ' || *Next == ',') ++Next;
+		if (*Next == ')') break;
+		char *End;
+		int64_t Size = strtoll(Next, &End, 10);
+		if (End == Next || Size < 0) return ml_error("FormatError", "Invalid array shape in header");
+		if (Count == ML_ARRAY_NPY_MAX_DEGREE) return ml_error("FormatError", "Too many dimensions in header");
+		Shape[Count++] = Size;
+		Next = End;
+		if (*Next == 'L') ++Next;
+	}
+	*Degree = Count;
+	return NULL;
+}
+
+ML_FUNCTION(MLArrayMMap) {
+//@array::mmap
+//<Path:string
+//<Type?:type
+//<Shape?:list[integer]
+//<Mode?:string
+//>array
+// Returns an array whose values are mapped from the file at :mini:`Path` instead of being loaded into memory. The file uses NumPy's ``.npy`` format so arrays can be shared with other tools.
+// :mini:`Mode` is :mini:`"r"` (read-only, the default when only :mini:`Path` is given), :mini:`"r+"` (changes are written back to the file), :mini:`"c"` (copy-on-write, changes are kept in memory) or :mini:`"w+"` (creates or overwrites the file).
+// If :mini:`Type` and :mini:`Shape` are given when opening an existing file then they must match its header. If they are given without :mini:`Mode` then an existing file is opened as with :mini:`"r+"` and a missing file is created, existing files are only overwritten with :mini:`"w+"`.
+	ML_CHECK_ARG_COUNT(1);
+	ML_CHECK_ARG_TYPE(0, MLStringT);
+	const char *Path = ml_string_value(Args[0]);
+	ml_array_format_t Format = ML_ARRAY_FORMAT_NONE;
+	int Degree = -1;
+	int64_t Shape[ML_ARRAY_NPY_MAX_DEGREE];
+	const char *Mode = "r";
+	if (Count > 2) {
+		ML_CHECK_ARG_TYPE(1, MLTypeT);
+		ML_CHECK_ARG_TYPE(2, MLListT);
+		Format = ml_array_format((ml_type_t *)Args[1]);
+		if (Format == ML_ARRAY_FORMAT_NONE || Format == ML_ARRAY_FORMAT_ANY) return ml_error("TypeError", "Unsupported type for mapped array");
+		Degree = ml_list_length(Args[2]);
+		if (Degree > ML_ARRAY_NPY_MAX_DEGREE) return ml_error("ValueError", "Too many dimensions");
+		int I = 0;
+		ML_LIST_FOREACH(Args[2], Iter) {
+			if (!ml_is(Iter->Value, MLIntegerT)) return ml_error("TypeError", "Dimension is not an integer");
+			int64_t Size = Shape[I++] = ml_integer_value(Iter->Value);
+			if (Size <= 0) return ml_error("ValueError", "Dimension must be positive");
+		}
+		Mode = NULL;
+		if (Count > 3) {
+			ML_CHECK_ARG_TYPE(3, MLStringT);
+			Mode = ml_string_value(Args[3]);
+		}
+	} else if (Count > 1) {
+		ML_CHECK_ARG_TYPE(1, MLStringT);
+		Mode = ml_string_value(Args[1]);
+	}
+	int OpenMode, Protect, Flags;
+	if (!Mode) {
+		OpenMode = O_RDWR | O_CREAT | O_EXCL;
+		Protect = PROT_READ | PROT_WRITE;
+		Flags = MAP_SHARED;
+	} else if (!strcmp(Mode, "r")) {
+		OpenMode = O_RDONLY;
+		Protect = PROT_READ;
+		Flags = MAP_SHARED;
+	} else if (!strcmp(Mode, "r+")) {
+		OpenMode = O_RDWR;
+		Protect = PROT_READ | PROT_WRITE;
+		Flags = MAP_SHARED;
+	} else if (!strcmp(Mode, "c")) {
+		OpenMode = O_RDONLY;
+		Protect = PROT_READ | PROT_WRITE;
+		Flags = MAP_PRIVATE;
+	} else if (!strcmp(Mode, "w+")) {
+		if (Degree < 0) return ml_error("ValueError", "Type and shape required to create mapped array");
+		OpenMode = O_RDWR | O_CREAT | O_TRUNC;
+		Protect = PROT_READ | PROT_WRITE;
+		Flags = MAP_SHARED;
+	} else {
+		return ml_error("ValueError", "Invalid mode for mapped array");
+	}
+	int Fd = open(Path, OpenMode, 0666);
+	// Without an explicit mode an existing file is opened and checked instead of being overwritten.
+	if (Fd < 0 && !Mode && errno == EEXIST) Fd = open(Path, OpenMode = O_RDWR);
+	if (Fd < 0) return ml_error("FileError", "Failed to open %s: %s", Path, strerror(errno));
+	size_t Offset;
+	if (OpenMode & O_CREAT) {
+		char Header[128 + ML_ARRAY_NPY_MAX_DEGREE * 24];
+		Offset = ml_array_npy_write_header(Header, Format, Degree, Shape);
+		if (write(Fd, Header, Offset) != Offset) {
+			close(Fd);
+			return ml_error("FileError", "Failed to write %s: %s", Path, strerror(errno));
+		}
+	} else {
+		unsigned char Prefix[12];
+		ssize_t Read = pread(Fd, Prefix, 12, 0);
+		if (Read < 10 || memcmp(Prefix, "\x93NUMPY", 6)) {
+			close(Fd);
+			return ml_error("FormatError", "%s is not a .npy file", Path);
+		}
+		if (Prefix[6] < 1 || Prefix[6] > 3) {
+			close(Fd);
+			return ml_error("FormatError", "%s has unsupported .npy version %d", Path, Prefix[6]);
+		}
+		if (Prefix[6] != 1 && Read < 12) {
+			close(Fd);
+			return ml_error("FormatError", "%s is not a .npy file", Path);
+		}
+		size_t PrefixLength, HeaderLength;
+		if (Prefix[6] == 1) {
+			PrefixLength = 10;
+			HeaderLength = Prefix[8] | (Prefix[9] << 8);
+		} else {
+			PrefixLength = 12;
+			HeaderLength = Prefix[8] | (Prefix[9] << 8) | (Prefix[10] << 16) | ((size_t)Prefix[11] << 24);
+		}
+		char *Header = snew(HeaderLength + 1);
+		if (pread(Fd, Header, HeaderLength, PrefixLength) != HeaderLength) {
+			close(Fd);
+			return ml_error("FormatError", "%s is not a .npy file", Path);
+		}
+		Header[HeaderLength] = 0;
+		ml_array_format_t FileFormat = ML_ARRAY_FORMAT_NONE;
+		int FileDegree = 0;
+		int64_t FileShape[ML_ARRAY_NPY_MAX_DEGREE];
+		ml_value_t *Error = ml_array_npy_read_header(Header, &FileFormat, &FileDegree, FileShape);
+		if (Error) {
+			close(Fd);
+			return Error;
+		}
+		if (Degree >= 0) {
+			int Match = FileFormat == Format && FileDegree == Degree;
+			for (int I = 0; Match && I < Degree; ++I) Match = FileShape[I] == Shape[I];
+			if (!Match) {
+				close(Fd);
+				return ml_error("ShapeError", "Type or shape does not match %s", Path);
+			}
+		}
+		Format = FileFormat;
+		Degree = FileDegree;
+		memcpy(Shape, FileShape, Degree * sizeof(int64_t));
+		Offset = PrefixLength + HeaderLength;
+	}
+	// Sizes and strides are stored as ints, so each dimension is limited to 2GB but the array as a whole is not.
+	ml_array_t *Array = (Protect & PROT_WRITE) ? ml_array_alloc(Format, Degree) : ml_array_const_alloc(Format, Degree);
+	size_t DataSize = MLArraySizes[Format];
+	for (int I = Degree; --I >= 0;) {
+		if (!Shape[I]) {
+			close(Fd);
+			return ml_error("ValueError", "Empty arrays cannot be mapped");
+		}
+		if (Shape[I] > INT_MAX || DataSize > INT_MAX) {
+			close(Fd);
+			return ml_error("ValueError", "Dimension too large for mapped array");
+		}
+		Array->Dimensions[I].Stride = DataSize;
+		Array->Dimensions[I].Size = Shape[I];
+		DataSize *= Shape[I];
+	}
+	if (OpenMode & O_CREAT) {
+		if (ftruncate(Fd, Offset + DataSize) < 0) {
+			close(Fd);
+			return ml_error("FileError", "Failed to resize %s: %s", Path, strerror(errno));
+		}
+	} else {
+		struct stat Stat[1];
+		if (fstat(Fd, Stat) < 0 || Stat->st_size < Offset + DataSize) {
+			close(Fd);
+			return ml_error("FormatError", "%s is smaller than its header describes", Path);
+		}
+	}
+	void *Mapping = mmap(NULL, Offset + DataSize, Protect, Flags, Fd, 0);
+	close(Fd);
+	if (Mapping == MAP_FAILED) return ml_error("MMapError", "Failed to map %s: %s", Path, strerror(errno));
+	Array->Base.Value = (char *)Mapping + Offset;
+	Array->View = 1;
+	Array->Base.Length = DataSize;
+	return (ml_value_t *)Array;
+}
+
+#endif
+
 ML_METHOD("degree", MLArrayT) {
 //<Array
 //>integer
@@ -694,6 +960,7 @@ static ml_array_t *ml_array_transpose(ml_array_t *Source) {
 		Target->Dimensions[I] = Source->Dimensions[Degree - I - 1];
 	}
 	Target->Base = Source->Base;
+	Target->View = 1;
 	return Target;
 }
 
@@ -734,6 +1001,7 @@ ML_METHOD("permute", MLArrayT, MLListT) {
 	}
 	if (Bits != 0) return ml_error("ArrayError", "Invalid permutation");
 	Target->Base = Source->Base;
+	Target->View = 1;
 	return (ml_value_t *)Target;
 }
 
@@ -766,6 +1034,7 @@ ML_METHODV("permute", MLArrayT, MLIntegerT) {
 	}
 	if (Bits != 0) return ml_error("ArrayError", "Invalid permutation");
 	Target->Base = Source->Base;
+	Target->View = 1;
 	return (ml_value_t *)Target;
 }
 
@@ -797,6 +1066,7 @@ ML_METHOD("swap", MLArrayT, MLIntegerT, MLIntegerT) {
 	Target->Dimensions[IndexA - 1] = Source->Dimensions[IndexB - 1];
 	Target->Dimensions[IndexB - 1] = Source->Dimensions[IndexA - 1];
 	Target->Base = Source->Base;
+	Target->View = 1;
 	return (ml_value_t *)Target;
 }
 
@@ -814,6 +1084,7 @@ ML_METHOD("reverse", MLArrayT, MLIntegerT) {
 	for (int I = 0; I < Degree; ++I) Target->Dimensions[I] = Source->Dimensions[I];
 	ml_array_dimension_t *Dimension = &Target->Dimensions[Index - 1];
 	Target->Base = Source->Base;
+	Target->View = 1;
 	if (Dimension->Indices) {
 		int *Indices = (int *)snew(Dimension->Size * sizeof(int));
 		for (int I = 0, J = Dimension->Size; --J >= 0; ++I) Indices[I] = Dimension->Indices[J];
@@ -857,6 +1128,7 @@ ML_METHOD("expand", MLArrayT, MLListT) {
 		++Dim;
 	}
 	Target->Base = Source->Base;
+	Target->View = 1;
 	return (ml_value_t *)Target;
 }
 
@@ -894,6 +1166,7 @@ ML_METHOD("split", MLArrayT, MLIntegerT, MLListT) {
 	}
 	for (int I = 0; I < Expand; ++I) *--TargetDimension = *--SourceDimension;
 	Target->Base = Source->Base;
+	Target->View = 1;
 	return (ml_value_t *)Target;
 }
 
@@ -928,6 +1201,7 @@ ML_METHOD("join", MLArrayT, MLIntegerT, MLIntegerT) {
 	TargetDimension->Size = Size;
 	for (int I = 0; I < Start; ++I) *--TargetDimension = *--SourceDimension;
 	Target->Base = Source->Base;
+	Target->View = 1;
 	return (ml_value_t *)Target;
 }
 
@@ -1042,7 +1316,7 @@ static ml_value_t *ML_TYPED_FN(ml_array_index_get, MLIntegerT, ml_value_t *Index
 	if (--IndexValue < 0) return (ml_value_t *)MLArrayNil;
 	if (IndexValue >= Indexer->Source->Size) return (ml_value_t *)MLArrayNil;
 	if (Indexer->Source->Indices) IndexValue = Indexer->Source->Indices[IndexValue];
-	Indexer->Address += Indexer->Source->Stride * IndexValue;
+	Indexer->Address += (ptrdiff_t)Indexer->Source->Stride * IndexValue;
 	++Indexer->Source;
 	return NULL;
 }
@@ -1098,7 +1372,7 @@ static ml_value_t *ML_TYPED_FN(ml_array_index_get, MLListT, ml_value_t *Index, m
 		}
 		int First = Indices[0];
 		for (int I = 0; I < Count; ++I) Indices[I] -= First;
-		Indexer->Address += Indexer->Source->Stride * First;
+		Indexer->Address += (ptrdiff_t)Indexer->Source->Stride * First;
 		Indexer->Target->Stride = Indexer->Source->Stride;
 		++Indexer->Source;
 	}
@@ -1121,7 +1395,7 @@ static ml_value_t *ML_TYPED_FN(ml_array_index_get, MLPermutationT, ml_array_t *I
 	}
 	int First = Indices[0];
 	for (int I = 0; I < Count; ++I) Indices[I] -= First;
-	Indexer->Address += Indexer->Source->Stride * First;
+	Indexer->Address += (ptrdiff_t)Indexer->Source->Stride * First;
 	Indexer->Target->Stride = Indexer->Source->Stride;
 	++Indexer->Source;
 	++Indexer->Target;
@@ -1151,7 +1425,7 @@ static ml_value_t *ML_TYPED_FN(ml_array_index_get, MLIntegerRangeT, ml_integer_r
 		Indexer->Target->Stride = Indexer->Source->Stride;
 	} else {
 		Indexer->Target->Indices = 0;
-		Indexer->Address += Indexer->Source->Stride * Min;
+		Indexer->Address += (ptrdiff_t)Indexer->Source->Stride * Min;
 		Indexer->Target->Stride = Indexer->Source->Stride * Step;
 	}
 	++Indexer->Target;
@@ -1182,7 +1456,7 @@ static ml_value_t *ML_TYPED_FN(ml_array_index_get, MLIntegerIntervalT, ml_intege
 		Indexer->Target->Stride = Indexer->Source->Stride;
 	} else {
 		Indexer->Target->Indices = 0;
-		Indexer->Address += Indexer->Source->Stride * Min;
+		Indexer->Address += (ptrdiff_t)Indexer->Source->Stride * Min;
 		Indexer->Target->Stride = Indexer->Source->Stride * Step;
 	}
 	++Indexer->Target;
@@ -1201,7 +1475,7 @@ static ml_value_t *ML_TYPED_FN(ml_array_index_get, MLTupleT, ml_tuple_t *Tuple,
 		if (--IndexValue < 0) return (ml_value_t *)MLArrayNil;
 		if (IndexValue >= Indexer->Source->Size) return (ml_value_t *)MLArrayNil;
 		if (Indexer->Source->Indices) IndexValue = Indexer->Source->Indices[IndexValue];
-		Indexer->Address += Indexer->Source->Stride * IndexValue;
+		Indexer->Address += (ptrdiff_t)Indexer->Source->Stride * IndexValue;
 		++Indexer->Source;
 	}
 	return NULL;
@@ -1565,11 +1839,13 @@ ml_value_t *ml_array_index(ml_array_t *Source, int Count, ml_value_t **Indices)
 		ml_array_ref_t *Ref = ml_array_ref_alloc(Source->Format, Degree);
 		for (int I = 0; I < Degree; ++I) Ref->Array->Dimensions[I] = TargetDimensions[I];
 		Ref->Array->Base.Value = Indexer->Address;
+		Ref->Array->View = 1;
 		return (ml_value_t *)Ref;
 	} else {
 		ml_array_t *Val = ml_array_const_alloc(Source->Format, Degree);
 		for (int I = 0; I < Degree; ++I) Val->Dimensions[I] = TargetDimensions[I];
 		Val->Base.Value = Indexer->Address;
+		Val->View = 1;
 		return (ml_value_t *)Val;
 	}
 }
@@ -1644,9 +1920,9 @@ static char *ml_array_indexv(ml_array_t *Array, va_list Indices) {
 		int Index = va_arg(Indices, int);
 		if (Index < 0 || Index >= Dimension->Size) return 0;
 		if (Dimension->Indices) {
-			Address += Dimension->Stride * Dimension->Indices[Index];
+			Address += (ptrdiff_t)Dimension->Stride * Dimension->Indices[Index];
 		} else {
-			Address += Dimension->Stride * Index;
+			Address += (ptrdiff_t)Dimension->Stride * Index;
 		}
 		++Dimension;
 	}
@@ -1663,6 +1939,7 @@ ML_METHOD("diag", MLArrayT) {
 	if (ml_is_subtype(Source->Base.Type, MLArrayMutableT)) {
 		ml_array_ref_t *Ref = ml_array_ref_alloc(Source->Format, Degree - 1);
 		Ref->Array->Base.Value = Source->Base.Value;
+		Ref->Array->View = 1;
 		ml_array_dimension_t *TargetDimensions = Ref->Array->Dimensions;
 		for (int I = 0; I < Degree - 2; ++I) TargetDimensions[I] = SourceDimensions[I];
 		TargetDimensions[Degree - 2].Size = MIN(SourceDimensions[Degree - 2].Size, SourceDimensions[Degree - 1].Size);
@@ -1671,6 +1948,7 @@ ML_METHOD("diag", MLArrayT) {
 	} else {
 		ml_array_t *Val = ml_array_const_alloc(Source->Format, Degree - 1);
 		Val->Base.Value = Source->Base.Value;
+		Val->View = 1;
 		ml_array_dimension_t *TargetDimensions = Val->Dimensions;
 		for (int I = 0; I < Degree - 2; ++I) TargetDimensions[I] = SourceDimensions[I];
 		TargetDimensions[Degree - 2].Size = MIN(SourceDimensions[Degree - 2].Size, SourceDimensions[Degree - 1].Size);
@@ -2080,6 +2358,71 @@ static void ML_TYPED_FN(ml_iterate, MLArrayMutableT, ml_state_t *Caller, ml_arra
 	ML_RETURN(Iterator);
 }
 
+// Large operations are split along their first dimension into chunks of at
+// least MLArrayParallelGrain elements, which are then run on the array thread
+// pool. Dense operands are viewed as vectors first so that any shape splits
+// evenly. Chunk boundaries depend only on the shape and the grain, reductions
+// combine their partial results in chunk order and so give the same answer
+// for any number of threads.
+
+#define ML_ARRAY_PARALLEL_CHUNKS 256
+
+static size_t ml_array_dims_count(int Degree, ml_array_dimension_t *Dimension) {
+	size_t Count = 1;
+	for (int I = 0; I < Degree; ++I) Count *= Dimension[I].Size;
+	return Count;
+}
+
+static int ml_array_dims_dense(int Degree, ml_array_dimension_t *Dimension, int Size) {
+	for (int I = Degree; --I >= 0;) {
+		if (Dimension[I].Indices) return 0;
+		if (Dimension[I].Stride != Size) return 0;
+		Size *= Dimension[I].Size;
+	}
+	return 1;
+}
+
+static int ml_array_parallel_rows(int Rows, size_t Count) {
+	if (Count < 2 * (size_t)MLArrayParallelGrain || Rows < 2) return 0;
+	size_t Inner = Count / Rows;
+	int Chunk = (MLArrayParallelGrain + Inner - 1) / Inner;
+	int Min = (Rows + ML_ARRAY_PARALLEL_CHUNKS - 1) / ML_ARRAY_PARALLEL_CHUNKS;
+	if (Chunk < Min) Chunk = Min;
+	return Chunk < Rows ? Chunk : 0;
+}
+
+static char *ml_array_split(int Degree, ml_array_dimension_t *Split, ml_array_dimension_t *Dimension, char *Data, int Start, int Size) {
+	memcpy(Split, Dimension, Degree * sizeof(ml_array_dimension_t));
+	Split->Size = Size;
+	if (Split->Indices) {
+		Split->Indices += Start;
+	} else {
+		Data += (size_t)Start * Split->Stride;
+	}
+	return Data;
+}
+
+ML_FUNCTION(MLArrayThreads) {
+//@array::threads
+//<Threads?:integer
+//<Grain?:integer
+//>integer
+// Returns the number of threads used for element-wise operations and reductions on large arrays, after setting it to :mini:`Threads` if provided.
+// Arrays are split into chunks of at least :mini:`Grain` values, results of floating point reductions depend on :mini:`Grain` but not on :mini:`Threads`.
+// The initial number of threads is taken from the environment variable :mini:`MINILANG_ARRAY_THREADS` or the number of processors.
+	if (Count > 0 && Args[0] != MLNil) {
+		ML_CHECK_ARG_TYPE(0, MLIntegerT);
+		ml_array_threads_set(ml_integer_value(Args[0]));
+	}
+	if (Count > 1) {
+		ML_CHECK_ARG_TYPE(1, MLIntegerT);
+		int64_t Grain = ml_integer_value(Args[1]);
+		if (Grain < 1 || Grain > INT_MAX / 2) return ml_error("ValueError", "Grain must be positive");
+		MLArrayParallelGrain = Grain;
+	}
+	return ml_integer(ml_array_threads());
+}
+
 typedef void (*update_row_fn_t)(ml_array_dimension_t *TargetDimension, char *TargetData, ml_array_dimension_t *SourceDimension, char *SourceData);
 
 #define UPDATE_FNS(TITLE) \
@@ -2157,6 +2500,59 @@ static void update_prefix(update_row_fn_t Update, int PrefixDegree, ml_array_dim
 	}
 }
 
+typedef struct {
+	update_row_fn_t Update;
+	ml_array_dimension_t *TargetDimension, *SourceDimension;
+	char *TargetData, *SourceData;
+	int PrefixDegree, TargetDegree, SourceDegree, Rows, Chunk;
+} update_parallel_t;
+
+static void update_parallel_fn(update_parallel_t *Parallel, int Index) {
+	int Start = Index * Parallel->Chunk;
+	int Size = MIN(Parallel->Chunk, Parallel->Rows - Start);
+	ml_array_dimension_t TargetDimension[Parallel->TargetDegree];
+	char *TargetData = ml_array_split(Parallel->TargetDegree, TargetDimension, Parallel->TargetDimension, Parallel->TargetData, Start, Size);
+	if (Parallel->PrefixDegree || !Parallel->SourceDegree) {
+		update_prefix(Parallel->Update, Parallel->PrefixDegree, TargetDimension, TargetData, Parallel->SourceDegree, Parallel->SourceDimension, Parallel->SourceData);
+	} else {
+		ml_array_dimension_t SourceDimension[Parallel->SourceDegree];
+		char *SourceData = ml_array_split(Parallel->SourceDegree, SourceDimension, Parallel->SourceDimension, Parallel->SourceData, Start, Size);
+		update_array(Parallel->Update, TargetDimension, TargetData, Parallel->SourceDegree, SourceDimension, SourceData);
+	}
+}
+
+static void update_parallel(update_row_fn_t Update, ml_array_t *Target, int PrefixDegree, ml_array_format_t SourceFormat, int SourceDegree, ml_array_dimension_t *SourceDimension, char *SourceData) {
+	// Only dense targets are split so that no two chunks can write to the same element.
+	int TargetDegree = Target->Degree;
+	ml_array_dimension_t *TargetDimension = Target->Dimensions;
+	size_t Count = ml_array_dims_count(TargetDegree, TargetDimension);
+	int TargetSize = MLArraySizes[Target->Format];
+	if (
+		Target->Format == ML_ARRAY_FORMAT_ANY || SourceFormat == ML_ARRAY_FORMAT_ANY ||
+		Count > INT_MAX || ml_array_threads() < 2 ||
+		!ml_array_dims_dense(TargetDegree, TargetDimension, TargetSize)
+	) return update_prefix(Update, PrefixDegree, TargetDimension, Target->Base.Value, SourceDegree, SourceDimension, SourceData);
+	ml_array_dimension_t Flat[2];
+	if (!SourceDegree || (!PrefixDegree && ml_array_dims_dense(SourceDegree, SourceDimension, MLArraySizes[SourceFormat]))) {
+		Flat[0] = (ml_array_dimension_t){Count, TargetSize, NULL};
+		TargetDimension = Flat;
+		TargetDegree = 1;
+		PrefixDegree = 0;
+		if (SourceDegree) {
+			Flat[1] = (ml_array_dimension_t){Count, MLArraySizes[SourceFormat], NULL};
+			SourceDimension = Flat + 1;
+			SourceDegree = 1;
+		}
+	}
+	int Chunk = ml_array_parallel_rows(TargetDimension->Size, Count);
+	if (!Chunk) return update_prefix(Update, PrefixDegree, TargetDimension, Target->Base.Value, SourceDegree, SourceDimension, SourceData);
+	update_parallel_t Parallel[1] = {{
+		Update, TargetDimension, SourceDimension, Target->Base.Value, SourceData,
+		PrefixDegree, TargetDegree, SourceDegree, TargetDimension->Size, Chunk
+	}};
+	ml_array_parallel((Parallel->Rows + Chunk - 1) / Chunk, (ml_array_parallel_fn)update_parallel_fn, Parallel);
+}
+
 static ml_value_t *update_array_fn(void *Data, int Count, ml_value_t **Args) {
 	update_row_fn_t *Updates = (update_row_fn_t *)Data;
 	ml_array_t *Target = (ml_array_t *)Args[0];
@@ -2171,7 +2567,7 @@ static ml_value_t *update_array_fn(void *Data, int Count, ml_value_t **Args) {
 	update_row_fn_t Update = Updates[Target->Format * MAX_FORMATS + Source->Format];
 	if (!Update) return ml_error("ArrayError", "Unsupported array format pair (%s, %s)", Target->Base.Type->Name, Source->Base.Type->Name);
 	if (Target->Degree) {
-		update_prefix(Update, PrefixDegree, Target->Dimensions, Target->Base.Value, Source->Degree, Source->Dimensions, Source->Base.Value);
+		update_parallel(Update, Target, PrefixDegree, Source->Format, Source->Degree, Source->Dimensions, Source->Base.Value);
 	} else {
 		ml_array_dimension_t ValueDimension[1] = {{1, 0, NULL}};
 		Update(ValueDimension, Target->Base.Value, ValueDimension, Source->Base.Value);
@@ -2284,7 +2680,7 @@ ML_FUNCTION(MLArrayVCat) {
 		ml_array_dimension_t ValueDimension[1] = {{1, 0, NULL}}; \
 		Update(ValueDimension, Array->Base.Value, ValueDimension, (char *)&Value); \
 	} else { \
-		update_prefix(Update, Array->Degree - 1, Array->Dimensions, Array->Base.Value, 0, NULL, (char *)&Value); \
+		update_parallel(Update, Array, Array->Degree - 1, FORMAT, 0, NULL, (char *)&Value); \
 	} \
 	return Args[0]; \
 }
@@ -2375,6 +2771,63 @@ static void compare_prefix(compare_row_fn_t Compare, ml_array_dimension_t *Targe
 	}
 }
 
+typedef struct {
+	compare_row_fn_t Compare;
+	ml_array_dimension_t *TargetDimension, *LeftDimension, *RightDimension;
+	char *TargetData, *LeftData, *RightData;
+	int PrefixDegree, Degree, RightDegree, Rows, Chunk;
+} compare_parallel_t;
+
+static void compare_parallel_fn(compare_parallel_t *Parallel, int Index) {
+	int Start = Index * Parallel->Chunk;
+	int Size = MIN(Parallel->Chunk, Parallel->Rows - Start);
+	ml_array_dimension_t TargetDimension[Parallel->Degree], LeftDimension[Parallel->Degree];
+	char *TargetData = ml_array_split(Parallel->Degree, TargetDimension, Parallel->TargetDimension, Parallel->TargetData, Start, Size);
+	char *LeftData = ml_array_split(Parallel->Degree, LeftDimension, Parallel->LeftDimension, Parallel->LeftData, Start, Size);
+	if (Parallel->PrefixDegree || !Parallel->RightDegree) {
+		compare_prefix(Parallel->Compare, TargetDimension, TargetData, Parallel->PrefixDegree, LeftDimension, LeftData, Parallel->RightDegree, Parallel->RightDimension, Parallel->RightData);
+	} else {
+		ml_array_dimension_t RightDimension[Parallel->RightDegree];
+		char *RightData = ml_array_split(Parallel->RightDegree, RightDimension, Parallel->RightDimension, Parallel->RightData, Start, Size);
+		compare_array(Parallel->Compare, TargetDimension, TargetData, LeftDimension, LeftData, Parallel->RightDegree, RightDimension, RightData);
+	}
+}
+
+static void compare_parallel(compare_row_fn_t Compare, ml_array_t *Target, int PrefixDegree, ml_array_t *Left, ml_array_format_t RightFormat, int RightDegree, ml_array_dimension_t *RightDimension, char *RightData) {
+	// Target is always a new dense array with the same shape as Left.
+	int Degree = Left->Degree;
+	ml_array_dimension_t *TargetDimension = Target->Dimensions, *LeftDimension = Left->Dimensions;
+	size_t Count = ml_array_dims_count(Degree, LeftDimension);
+	if (
+		Left->Format == ML_ARRAY_FORMAT_ANY || RightFormat == ML_ARRAY_FORMAT_ANY ||
+		Count > INT_MAX || ml_array_threads() < 2 || !Degree
+	) return compare_prefix(Compare, TargetDimension, Target->Base.Value, PrefixDegree, LeftDimension, Left->Base.Value, RightDegree, RightDimension, RightData);
+	ml_array_dimension_t Flat[3];
+	if (
+		ml_array_dims_dense(Degree, LeftDimension, MLArraySizes[Left->Format]) &&
+		(!RightDegree || (!PrefixDegree && ml_array_dims_dense(RightDegree, RightDimension, MLArraySizes[RightFormat])))
+	) {
+		Flat[0] = (ml_array_dimension_t){Count, 1, NULL};
+		Flat[1] = (ml_array_dimension_t){Count, MLArraySizes[Left->Format], NULL};
+		TargetDimension = Flat;
+		LeftDimension = Flat + 1;
+		Degree = 1;
+		PrefixDegree = 0;
+		if (RightDegree) {
+			Flat[2] = (ml_array_dimension_t){Count, MLArraySizes[RightFormat], NULL};
+			RightDimension = Flat + 2;
+			RightDegree = 1;
+		}
+	}
+	int Chunk = ml_array_parallel_rows(LeftDimension->Size, Count);
+	if (!Chunk) return compare_prefix(Compare, TargetDimension, Target->Base.Value, PrefixDegree, LeftDimension, Left->Base.Value, RightDegree, RightDimension, RightData);
+	compare_parallel_t Parallel[1] = {{
+		Compare, TargetDimension, LeftDimension, RightDimension, Target->Base.Value, Left->Base.Value, RightData,
+		PrefixDegree, Degree, RightDegree, LeftDimension->Size, Chunk
+	}};
+	ml_array_parallel((Parallel->Rows + Chunk - 1) / Chunk, (ml_array_parallel_fn)compare_parallel_fn, Parallel);
+}
+
 static ml_value_t *compare_array_fn(void *Data, int Count, ml_value_t **Args) {
 	compare_row_fn_t *Compares = (compare_row_fn_t *)Data;
 	ml_array_t *Left = (ml_array_t *)Args[0];
@@ -2396,7 +2849,7 @@ static ml_value_t *compare_array_fn(void *Data, int Count, ml_value_t **Args) {
 	compare_row_fn_t Compare = Compares[Left->Format * MAX_FORMATS + Right->Format];
 	if (!Compare) return ml_error("ArrayError", "Unsupported array format pair (%s, %s)", Left->Base.Type->Name, Right->Base.Type->Name);
 	if (Degree) {
-		compare_prefix(Compare, Target->Dimensions, Target->Base.Value, PrefixDegree, Left->Dimensions, Left->Base.Value, Right->Degree, Right->Dimensions, Right->Base.Value);
+		compare_parallel(Compare, Target, PrefixDegree, Left, Right->Format, Right->Degree, Right->Dimensions, Right->Base.Value);
 	} else {
 		ml_array_dimension_t ValueDimension[1] = {{1, 0, NULL}};
 		Compare(Target->Base.Value, ValueDimension, Left->Base.Value, ValueDimension, Right->Base.Value);
@@ -2621,7 +3074,7 @@ static void ml_array_ ## CTYPE ## _assign(ml_state_t *Caller, ml_array_t *Target
 		update_row_fn_t Update = UpdateSetRowFns[Target->Format * MAX_FORMATS + Source->Format]; \
 		if (!Update) ML_ERROR("ArrayError", "Unsupported array format pair (%s, %s)", Target->Base.Type->Name, Source->Base.Type->Name); \
 		if (Target->Degree) { \
-			update_prefix(Update, PrefixDegree, Target->Dimensions, Target->Base.Value, Source->Degree, Source->Dimensions, Source->Base.Value); \
+			update_parallel(Update, Target, PrefixDegree, Source->Format, Source->Degree, Source->Dimensions, Source->Base.Value); \
 		} else { \
 			ml_array_dimension_t ValueDimension[1] = {{1, 0, NULL}}; \
 			Update(ValueDimension, Target->Base.Value, ValueDimension, Source->Base.Value); \
@@ -2634,7 +3087,7 @@ static void ml_array_ ## CTYPE ## _assign(ml_state_t *Caller, ml_array_t *Target
 		if (Target->Degree == 0) { \
 			Update(ValueDimension, Target->Base.Value, ValueDimension, (char *)&Value); \
 		} else { \
-			update_prefix(Update, Target->Degree - 1, Target->Dimensions, Target->Base.Value, 0, NULL, (char *)&Value); \
+			update_parallel(Update, Target, Target->Degree - 1, ML_ARRAY_FORMAT_ANY, 0, NULL, (char *)&Value); \
 		} \
 		ML_RETURN(Value); \
 	} else if (ml_is(Value, MLNumberT)) { \
@@ -2645,7 +3098,7 @@ static void ml_array_ ## CTYPE ## _assign(ml_state_t *Caller, ml_array_t *Target
 		if (Target->Degree == 0) { \
 			Update(ValueDimension, Target->Base.Value, ValueDimension, (char *)&CValue); \
 		} else { \
-			update_prefix(Update, Target->Degree - 1, Target->Dimensions, Target->Base.Value, 0, NULL, (char *)&CValue); \
+			update_parallel(Update, Target, Target->Degree - 1, Target->Format, 0, NULL, (char *)&CValue); \
 		} \
 		ML_RETURN(Value); \
 	} else { \
@@ -2842,8 +3295,86 @@ static void partial_prods_ ## CTYPE(int Target, int Degree, ml_array_dimension_t
 	} \
 } \
 
+// Contiguous rows are reduced into several independent partial results so
+// that the vectorised clones can keep one per lane.
+
+#define DENSE_REDUCE_LANES 8
+
+#define DENSE_REDUCE_FUNCTIONS(CTYPE1, CTYPE2) \
+\
+static ML_ARRAY_KERNEL void dense_sums_ ## CTYPE2(const CTYPE2 *Values, int Size, CTYPE1 *Result) { \
+	CTYPE1 Sums[DENSE_REDUCE_LANES] = {0}; \
+	int I = 0; \
+	for (; I + DENSE_REDUCE_LANES <= Size; I += DENSE_REDUCE_LANES) { \
+		for (int J = 0; J < DENSE_REDUCE_LANES; ++J) Sums[J] += Values[I + J]; \
+	} \
+	CTYPE1 Sum = 0; \
+	for (int J = 0; J < DENSE_REDUCE_LANES; ++J) Sum += Sums[J]; \
+	for (; I < Size; ++I) Sum += Values[I]; \
+	*Result = Sum; \
+} \
+\
+static ML_ARRAY_KERNEL void dense_prods_ ## CTYPE2(const CTYPE2 *Values, int Size, CTYPE1 *Result) { \
+	CTYPE1 Prods[DENSE_REDUCE_LANES]; \
+	for (int J = 0; J < DENSE_REDUCE_LANES; ++J) Prods[J] = 1; \
+	int I = 0; \
+	for (; I + DENSE_REDUCE_LANES <= Size; I += DENSE_REDUCE_LANES) { \
+		for (int J = 0; J < DENSE_REDUCE_LANES; ++J) Prods[J] *= Values[I + J]; \
+	} \
+	CTYPE1 Prod = 1; \
+	for (int J = 0; J < DENSE_REDUCE_LANES; ++J) Prod *= Prods[J]; \
+	for (; I < Size; ++I) Prod *= Values[I]; \
+	*Result = Prod; \
+}
+
+// Full reductions of large arrays are computed as one partial result per chunk.
+
+#define PARALLEL_SUM(X, Y) X += Y
+#define PARALLEL_PROD(X, Y) X *= Y
+#define PARALLEL_MIN(X, Y) if (Y < X) X = Y
+#define PARALLEL_MAX(X, Y) if (Y > X) X = Y
+
+#define PARALLEL_REDUCE_FUNCTION(NAME, CTYPE1, CTYPE2, COMBINE) \
+\
+typedef struct { \
+	ml_array_dimension_t *Dimension; \
+	char *Address; \
+	CTYPE1 *Results; \
+	int Degree, Rows, Chunk; \
+} parallel_ ## NAME ## _ ## CTYPE2 ## _t; \
+\
+static void parallel_ ## NAME ## _ ## CTYPE2 ## _fn(parallel_ ## NAME ## _ ## CTYPE2 ## _t *Parallel, int Index) { \
+	int Start = Index * Parallel->Chunk; \
+	int Size = MIN(Parallel->Chunk, Parallel->Rows - Start); \
+	ml_array_dimension_t Dimension[Parallel->Degree]; \
+	char *Address = ml_array_split(Parallel->Degree, Dimension, Parallel->Dimension, Parallel->Address, Start, Size); \
+	Parallel->Results[Index] = compute_ ## NAME ## _ ## CTYPE2(Parallel->Degree, Dimension, Address); \
+} \
+\
+static CTYPE1 parallel_ ## NAME ## _ ## CTYPE2(int Degree, ml_array_dimension_t *Dimension, void *Address) { \
+	size_t Count = ml_array_dims_count(Degree, Dimension); \
+	if (Degree < 1 || Count > INT_MAX) return compute_ ## NAME ## _ ## CTYPE2(Degree, Dimension, Address); \
+	ml_array_dimension_t Flat[1]; \
+	if (ml_array_dims_dense(Degree, Dimension, sizeof(CTYPE2))) { \
+		Flat[0] = (ml_array_dimension_t){Count, sizeof(CTYPE2), NULL}; \
+		Dimension = Flat; \
+		Degree = 1; \
+	} \
+	int Chunk = ml_array_parallel_rows(Dimension->Size, Count); \
+	if (!Chunk) return compute_ ## NAME ## _ ## CTYPE2(Degree, Dimension, Address); \
+	int NumChunks = (Dimension->Size + Chunk - 1) / Chunk; \
+	CTYPE1 Results[NumChunks]; \
+	parallel_ ## NAME ## _ ## CTYPE2 ## _t Parallel[1] = {{Dimension, Address, Results, Degree, Dimension->Size, Chunk}}; \
+	ml_array_parallel(NumChunks, (ml_array_parallel_fn)parallel_ ## NAME ## _ ## CTYPE2 ## _fn, Parallel); \
+	CTYPE1 Result = Results[0]; \
+	for (int I = 1; I < NumChunks; ++I) COMBINE(Result, Results[I]); \
+	return Result; \
+}
+
 #define COMPLETE_FUNCTIONS(CTYPE1, CTYPE2) \
 \
+DENSE_REDUCE_FUNCTIONS(CTYPE1, CTYPE2) \
+\
 static CTYPE1 compute_sums_ ## CTYPE2(int Degree, ml_array_dimension_t *Dimension, void *Address) { \
 	CTYPE1 Sum = 0; \
 	if (Degree > 1) { \
@@ -2866,6 +3397,8 @@ static CTYPE1 compute_sums_ ## CTYPE2(int Degree, ml_array_dimension_t *Dimensio
 			for (int I = 0; I < Dimension->Size; ++I) { \
 				Sum += *(CTYPE2 *)(Address + Indices[I] * Stride); \
 			} \
+		} else if (Stride == sizeof(CTYPE2)) { \
+			dense_sums_ ## CTYPE2((CTYPE2 *)Address, Dimension->Size, &Sum); \
 		} else { \
 			for (int I = 0; I < Dimension->Size; ++I) { \
 				Sum += *(CTYPE2 *)Address; \
@@ -2920,6 +3453,8 @@ static CTYPE1 compute_prods_ ## CTYPE2(int Degree, ml_array_dimension_t *Dimensi
 			for (int I = 0; I < Dimension->Size; ++I) { \
 				Prod *= *(CTYPE2 *)(Address + Indices[I] * Stride); \
 			} \
+		} else if (Stride == sizeof(CTYPE2)) { \
+			dense_prods_ ## CTYPE2((CTYPE2 *)Address, Dimension->Size, &Prod); \
 		} else { \
 			for (int I = 0; I < Dimension->Size; ++I) { \
 				Prod *= *(CTYPE2 *)Address; \
@@ -2950,7 +3485,10 @@ static void fill_prods_ ## CTYPE2(int TargetDegree, ml_array_dimension_t *Target
 			} \
 		} \
 	} \
-}
+} \
+\
+PARALLEL_REDUCE_FUNCTION(sums, CTYPE1, CTYPE2, PARALLEL_SUM) \
+PARALLEL_REDUCE_FUNCTION(prods, CTYPE1, CTYPE2, PARALLEL_PROD)
 
 #define MINMAX_FUNCTIONS(CTYPE) \
 \
@@ -3184,7 +3722,10 @@ static void index_maxs_ ## CTYPE(int TargetDegree, ml_array_dimension_t *TargetD
 			} \
 		} \
 	} \
-}
+} \
+\
+PARALLEL_REDUCE_FUNCTION(mins, CTYPE, CTYPE, PARALLEL_MIN) \
+PARALLEL_REDUCE_FUNCTION(maxs, CTYPE, CTYPE, PARALLEL_MAX)
 
 PARTIAL_FUNCTIONS(uint64_t);
 PARTIAL_FUNCTIONS(int64_t);
@@ -3345,7 +3886,9 @@ void ml_array_copy_data(ml_array_t *Source, char *Data) {
 	size_t Size = MLArraySizes[Source->Format];
 	int FlatDegree = Source->Degree;
 	for (int I = Source->Degree; --I >= 0;) {
-		if (Size == Source->Dimensions[I].Stride) FlatDegree = I;
+		// Only trailing dimensions which are contiguous and not indexed can be copied in one block.
+		if (Size != Source->Dimensions[I].Stride || Source->Dimensions[I].Indices) break;
+		FlatDegree = I;
 		Size *= Source->Dimensions[I].Size;
 	}
 	FlatDegree = Source->Degree - FlatDegree;
@@ -3524,30 +4067,30 @@ ML_METHOD("sum", MLArrayT) {
 	ml_array_t *Source = (ml_array_t *)Args[0];
 	switch (Source->Format) {
 	case ML_ARRAY_FORMAT_U8:
-		return ml_integer(compute_sums_uint8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_sums_uint8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I8:
-		return ml_integer(compute_sums_int8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_sums_int8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U16:
-		return ml_integer(compute_sums_uint16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_sums_uint16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I16:
-		return ml_integer(compute_sums_int16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_sums_int16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U32:
-		return ml_integer(compute_sums_uint32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_sums_uint32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I32:
-		return ml_integer(compute_sums_int32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_sums_int32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U64:
-		return ml_integer(compute_sums_uint64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_sums_uint64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I64:
-		return ml_integer(compute_sums_int64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_sums_int64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_F32:
-		return ml_real(compute_sums_float(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_real(parallel_sums_float(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_F64:
-		return ml_real(compute_sums_double(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_real(parallel_sums_double(Source->Degree, Source->Dimensions, Source->Base.Value));
 #ifdef ML_COMPLEX
 	case ML_ARRAY_FORMAT_C32:
-		return ml_complex(compute_sums_complex_float(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_complex(parallel_sums_complex_float(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_C64:
-		return ml_complex(compute_sums_complex_double(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_complex(parallel_sums_complex_double(Source->Degree, Source->Dimensions, Source->Base.Value));
 #endif
 	default:
 		return ml_error("ArrayError", "Invalid array format");
@@ -3641,30 +4184,30 @@ ML_METHOD("prod", MLArrayT) {
 	ml_array_t *Source = (ml_array_t *)Args[0];
 	switch (Source->Format) {
 	case ML_ARRAY_FORMAT_U8:
-		return ml_integer(compute_prods_uint8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_prods_uint8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I8:
-		return ml_integer(compute_prods_int8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_prods_int8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U16:
-		return ml_integer(compute_prods_uint16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_prods_uint16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I16:
-		return ml_integer(compute_prods_int16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_prods_int16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U32:
-		return ml_integer(compute_prods_uint32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_prods_uint32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I32:
-		return ml_integer(compute_prods_int32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_prods_int32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U64:
-		return ml_integer(compute_prods_uint64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_prods_uint64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I64:
-		return ml_integer(compute_prods_int64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_prods_int64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_F32:
-		return ml_real(compute_prods_float(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_real(parallel_prods_float(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_F64:
-		return ml_real(compute_prods_double(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_real(parallel_prods_double(Source->Degree, Source->Dimensions, Source->Base.Value));
 #ifdef ML_COMPLEX
 	case ML_ARRAY_FORMAT_C32:
-		return ml_complex(compute_prods_complex_float(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_complex(parallel_prods_complex_float(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_C64:
-		return ml_complex(compute_prods_complex_double(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_complex(parallel_prods_complex_double(Source->Degree, Source->Dimensions, Source->Base.Value));
 #endif
 	default:
 		return ml_error("ArrayError", "Invalid array format");
@@ -3758,25 +4301,25 @@ ML_METHOD("minval", MLArrayT) {
 	ml_array_t *Source = (ml_array_t *)Args[0];
 	switch (Source->Format) {
 	case ML_ARRAY_FORMAT_U8:
-		return ml_integer(compute_mins_uint8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_mins_uint8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I8:
-		return ml_integer(compute_mins_int8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_mins_int8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U16:
-		return ml_integer(compute_mins_uint16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_mins_uint16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I16:
-		return ml_integer(compute_mins_int16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_mins_int16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U32:
-		return ml_integer(compute_mins_uint32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_mins_uint32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I32:
-		return ml_integer(compute_mins_int32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_mins_int32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U64:
-		return ml_integer(compute_mins_uint64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_mins_uint64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I64:
-		return ml_integer(compute_mins_int64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_mins_int64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_F32:
-		return ml_real(compute_mins_float(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_real(parallel_mins_float(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_F64:
-		return ml_real(compute_mins_double(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_real(parallel_mins_double(Source->Degree, Source->Dimensions, Source->Base.Value));
 	default:
 		return ml_error("ArrayError", "Invalid array format");
 	}
@@ -3960,25 +4503,25 @@ ML_METHOD("maxval", MLArrayT) {
 	ml_array_t *Source = (ml_array_t *)Args[0];
 	switch (Source->Format) {
 	case ML_ARRAY_FORMAT_U8:
-		return ml_integer(compute_maxs_uint8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_maxs_uint8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I8:
-		return ml_integer(compute_maxs_int8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_maxs_int8_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U16:
-		return ml_integer(compute_maxs_uint16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_maxs_uint16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I16:
-		return ml_integer(compute_maxs_int16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_maxs_int16_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U32:
-		return ml_integer(compute_maxs_uint32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_maxs_uint32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I32:
-		return ml_integer(compute_maxs_int32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_maxs_int32_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_U64:
-		return ml_integer(compute_maxs_uint64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_maxs_uint64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_I64:
-		return ml_integer(compute_maxs_int64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_integer(parallel_maxs_int64_t(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_F32:
-		return ml_real(compute_maxs_float(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_real(parallel_maxs_float(Source->Degree, Source->Dimensions, Source->Base.Value));
 	case ML_ARRAY_FORMAT_F64:
-		return ml_real(compute_maxs_double(Source->Degree, Source->Dimensions, Source->Base.Value));
+		return ml_real(parallel_maxs_double(Source->Degree, Source->Dimensions, Source->Base.Value));
 	default:
 		return ml_error("ArrayError", "Invalid array format");
 	}
@@ -4479,7 +5022,7 @@ static ml_value_t *array_infix_fn(void *Data, int Count, ml_value_t **Args) {
 	ml_array_copy(C, A);
 	update_row_fn_t Update = Updates[C->Format * MAX_FORMATS + B->Format];
 	if (!Update) return ml_error("ArrayError", "Unsupported array format pair (%s, %s)", C->Base.Type->Name, B->Base.Type->Name);
-	update_prefix(Update, C->Degree - B->Degree, C->Dimensions, C->Base.Value, B->Degree, B->Dimensions, B->Base.Value);
+	update_parallel(Update, C, C->Degree - B->Degree, B->Format, B->Degree, B->Dimensions, B->Base.Value);
 	return (ml_value_t *)C;
 }
 
@@ -4911,7 +5454,7 @@ ML_METHOD(#NAME, MLRealT, MLArrayT) { \
 	ml_array_t *A = (ml_array_t *)Args[1]; \
 	if (A->Degree == -1) return (ml_value_t *)A; \
 	if (A->Format == ML_ARRAY_FORMAT_ANY) return ml_error("TypeError", "Invalid types for array operation"); \
-	int64_t B = ml_real_value(Args[0]); \
+	double B = ml_real_value(Args[0]); \
 	int Degree = A->Degree; \
 	ml_array_t *C = ml_array_alloc(ML_ARRAY_FORMAT_F64, Degree); \
 	int DataSize = ml_array_copy(C, A); \
@@ -5007,7 +5550,7 @@ ML_METHOD(#NAME, MLArrayT, MLIntegerT) { \
 	C->Base.Value = snew(DataSize); \
 	compare_row_fn_t Compare = Compare ## TITLE ## RowFns[A->Format * MAX_FORMATS + ML_ARRAY_FORMAT_I64]; \
 	if (!Compare) return ml_error("ArrayError", "Unsupported array format pair (%s, integer)", A->Base.Type->Name); \
-	compare_prefix(Compare, C->Dimensions, C->Base.Value, Degree - 1, A->Dimensions, A->Base.Value, 0, NULL, (char *)&B); \
+	compare_parallel(Compare, C, Degree - 1, A, ML_ARRAY_FORMAT_I64, 0, NULL, (char *)&B); \
 	return (ml_value_t *)C; \
 } \
 \
@@ -5031,7 +5574,7 @@ ML_METHOD(#NAME, MLIntegerT, MLArrayT) { \
 	C->Base.Value = snew(DataSize); \
 	compare_row_fn_t Compare = Compare ## TITLE2 ## RowFns[A->Format * MAX_FORMATS + ML_ARRAY_FORMAT_I64]; \
 	if (!Compare) return ml_error("ArrayError", "Unsupported array format pair (integer, %s)", A->Base.Type->Name); \
-	compare_prefix(Compare, C->Dimensions, C->Base.Value, Degree - 1, A->Dimensions, A->Base.Value, 0, NULL, (char *)&B); \
+	compare_parallel(Compare, C, Degree - 1, A, ML_ARRAY_FORMAT_I64, 0, NULL, (char *)&B); \
 	return (ml_value_t *)C; \
 } \
 \
@@ -5055,7 +5598,7 @@ ML_METHOD(#NAME, MLArrayT, MLRealT) { \
 	C->Base.Value = snew(DataSize); \
 	compare_row_fn_t Compare = Compare ## TITLE ## RowFns[A->Format * MAX_FORMATS + ML_ARRAY_FORMAT_F64]; \
 	if (!Compare) return ml_error("ArrayError", "Unsupported array format pair (%s, real)", A->Base.Type->Name); \
-	compare_prefix(Compare, C->Dimensions, C->Base.Value, Degree - 1, A->Dimensions, A->Base.Value, 0, NULL, (char *)&B); \
+	compare_parallel(Compare, C, Degree - 1, A, ML_ARRAY_FORMAT_F64, 0, NULL, (char *)&B); \
 	return (ml_value_t *)C; \
 } \
 \
@@ -5079,7 +5622,7 @@ ML_METHOD(#NAME, MLRealT, MLArrayT) { \
 	C->Base.Value = snew(DataSize); \
 	compare_row_fn_t Compare = Compare ## TITLE2 ## RowFns[A->Format * MAX_FORMATS + ML_ARRAY_FORMAT_F64]; \
 	if (!Compare) return ml_error("ArrayError", "Unsupported array format pair (real, %s)", A->Base.Type->Name); \
-	compare_prefix(Compare, C->Dimensions, C->Base.Value, Degree - 1, A->Dimensions, A->Base.Value, 0, NULL, (char *)&B); \
+	compare_parallel(Compare, C, Degree - 1, A, ML_ARRAY_FORMAT_F64, 0, NULL, (char *)&B); \
 	return (ml_value_t *)C; \
 } \
 \
@@ -5103,7 +5646,7 @@ ML_METHOD(#NAME, MLArrayT, MLAnyT) { \
 	C->Base.Value = snew(DataSize); \
 	compare_row_fn_t Compare = Compare ## TITLE ## RowFns[A->Format * MAX_FORMATS + ML_ARRAY_FORMAT_ANY]; \
 	if (!Compare) return ml_error("ArrayError", "Unsupported array format pair (%s, any)", A->Base.Type->Name); \
-	compare_prefix(Compare, C->Dimensions, C->Base.Value, Degree - 1, A->Dimensions, A->Base.Value, 0, NULL, (char *)&B); \
+	compare_parallel(Compare, C, Degree - 1, A, ML_ARRAY_FORMAT_ANY, 0, NULL, (char *)&B); \
 	return (ml_value_t *)C; \
 } \
 \
@@ -5127,7 +5670,7 @@ ML_METHOD(#NAME, MLAnyT, MLArrayT) { \
 	C->Base.Value = snew(DataSize); \
 	compare_row_fn_t Compare = Compare ## TITLE2 ## RowFns[A->Format * MAX_FORMATS + ML_ARRAY_FORMAT_ANY]; \
 	if (!Compare) return ml_error("ArrayError", "Unsupported array format pair (any, %s)", A->Base.Type->Name); \
-	compare_prefix(Compare, C->Dimensions, C->Base.Value, Degree - 1, A->Dimensions, A->Base.Value, 0, NULL, (char *)&B); \
+	compare_parallel(Compare, C, Degree - 1, A, ML_ARRAY_FORMAT_ANY, 0, NULL, (char *)&B); \
 	return (ml_value_t *)C; \
 }
 
@@ -5157,7 +5700,7 @@ ML_METHOD(#NAME, MLArrayT, MLComplexT) { \
 	C->Base.Value = snew(DataSize); \
 	compare_row_fn_t Compare = Compare ## TITLE ## RowFns[A->Format * MAX_FORMATS + ML_ARRAY_FORMAT_C64]; \
 	if (!Compare) return ml_error("ArrayError", "Unsupported array format pair (%s, complex)", A->Base.Type->Name); \
-	compare_prefix(Compare, C->Dimensions, C->Base.Value, Degree - 1, A->Dimensions, A->Base.Value, 0, NULL, (char *)&B); \
+	compare_parallel(Compare, C, Degree - 1, A, ML_ARRAY_FORMAT_C64, 0, NULL, (char *)&B); \
 	return (ml_value_t *)C; \
 } \
 \
@@ -5182,7 +5725,7 @@ ML_METHOD(#NAME, MLComplexT, MLArrayT) { \
 	C->Base.Value = snew(DataSize); \
 	compare_row_fn_t Compare = Compare ## TITLE2 ## RowFns[A->Format * MAX_FORMATS + ML_ARRAY_FORMAT_C64]; \
 	if (!Compare) return ml_error("ArrayError", "Unsupported array format pair (complex, %s)", A->Base.Type->Name); \
-	compare_prefix(Compare, C->Dimensions, C->Base.Value, Degree - 1, A->Dimensions, A->Base.Value, 0, NULL, (char *)&B); \
+	compare_parallel(Compare, C, Degree - 1, A, ML_ARRAY_FORMAT_C64, 0, NULL, (char *)&B); \
 	return (ml_value_t *)C; \
 }
 
@@ -7002,7 +7545,22 @@ static void **MLArrayGetters[] = {
 	[ML_ARRAY_FORMAT_ANY] = (void *)MLArraySettersAny
 };*/
 
+#define ML_ARRAY_DOT_DENSE(CTYPE1, CTYPE2) \
+static ML_ARRAY_KERNEL void ml_array_dot_dense_ ## CTYPE2 ## _ ## CTYPE1(const CTYPE2 *A, const CTYPE2 *B, int Size, CTYPE1 *Result) { \
+	CTYPE1 Sums[DENSE_REDUCE_LANES] = {0}; \
+	int I = 0; \
+	for (; I + DENSE_REDUCE_LANES <= Size; I += DENSE_REDUCE_LANES) { \
+		for (int J = 0; J < DENSE_REDUCE_LANES; ++J) Sums[J] += (CTYPE1)A[I + J] * B[I + J]; \
+	} \
+	CTYPE1 Sum = 0; \
+	for (int J = 0; J < DENSE_REDUCE_LANES; ++J) Sum += Sums[J]; \
+	for (; I < Size; ++I) Sum += (CTYPE1)A[I] * B[I]; \
+	*Result = Sum; \
+}
+
 #define ML_ARRAY_DOT(CTYPE) \
+ML_ARRAY_DOT_DENSE(CTYPE, CTYPE) \
+\
 static void ml_array_dot_ ## CTYPE( \
 	void *DataA, ml_array_dimension_t *DimA, ml_array_getter_ ## CTYPE GetterA, \
 	void *DataB, ml_array_dimension_t *DimB, ml_array_getter_ ## CTYPE GetterB, \
@@ -7029,6 +7587,12 @@ static void ml_array_dot_ ## CTYPE( \
 				DataB += StrideB; \
 			} \
 		} \
+	} else if ( \
+		StrideA == sizeof(CTYPE) && GetterA == ml_array_getter_ ## CTYPE ## _ ## CTYPE && \
+		StrideB == sizeof(CTYPE) && GetterB == ml_array_getter_ ## CTYPE ## _ ## CTYPE && \
+		!DimB->Indices \
+	) { \
+		ml_array_dot_dense_ ## CTYPE ## _ ## CTYPE((CTYPE *)DataA, (CTYPE *)DataB, Size, &Sum); \
 	} else { \
 		if (DimB->Indices) { \
 			const int *IndicesB = DimB->Indices; \
@@ -7125,6 +7689,7 @@ ML_ARRAY_DOT(uint64_t);
 ML_ARRAY_DOT(int64_t);
 ML_ARRAY_DOT(float);
 ML_ARRAY_DOT(double);
+ML_ARRAY_DOT_DENSE(double, float);
 
 #ifdef ML_COMPLEX
 
@@ -7358,6 +7923,62 @@ static ml_array_dot_fn MLArrayDotFns[] = {
 	[ML_ARRAY_FORMAT_ANY] = (ml_array_dot_fn)ml_array_dot_any
 };
 
+// Matrix products with at least this many multiply-adds are computed by ml_array_gemm_*().
+#define ML_ARRAY_GEMM_THRESHOLD (32 * 32 * 32)
+
+static int ml_array_dot_gemm(ml_array_t *C, ml_array_t *A, ml_array_t *B) {
+	switch (C->Format) {
+	case ML_ARRAY_FORMAT_F32:
+	case ML_ARRAY_FORMAT_F64:
+#ifdef ML_COMPLEX
+	case ML_ARRAY_FORMAT_C32:
+	case ML_ARRAY_FORMAT_C64:
+#endif
+		break;
+	default:
+		return 0;
+	}
+	if (A->Degree != 2 || B->Degree != 2) return 0;
+	int M = A->Dimensions[0].Size, K = A->Dimensions[1].Size, N = B->Dimensions[1].Size;
+	if ((double)M * N * K < ML_ARRAY_GEMM_THRESHOLD) return 0;
+	if (A->Format != C->Format || A->Dimensions[1].Indices) {
+		ml_array_t *T = ml_array_alloc(C->Format, 2);
+		ml_array_copy(T, A);
+		A = T;
+	}
+	if (B->Format != C->Format || B->Dimensions[1].Indices) {
+		ml_array_t *T = ml_array_alloc(C->Format, 2);
+		ml_array_copy(T, B);
+		B = T;
+	}
+	char **RowsA = anew(char *, M), **RowsB = anew(char *, K), **RowsC = anew(char *, M);
+	for (int I = 0; I < M; ++I) {
+		RowsA[I] = ml_array_step(A->Base.Value, A->Dimensions, I);
+		RowsC[I] = ml_array_step(C->Base.Value, C->Dimensions, I);
+	}
+	for (int I = 0; I < K; ++I) RowsB[I] = ml_array_step(B->Base.Value, B->Dimensions, I);
+	int StrideA = A->Dimensions[1].Stride, StrideB = B->Dimensions[1].Stride;
+	switch (C->Format) {
+	case ML_ARRAY_FORMAT_F32:
+		ml_array_gemm_float(M, N, K, RowsA, StrideA, RowsB, StrideB, RowsC, ML_ARRAY_GEMM_SET);
+		break;
+	case ML_ARRAY_FORMAT_F64:
+		ml_array_gemm_double(M, N, K, RowsA, StrideA, RowsB, StrideB, RowsC, ML_ARRAY_GEMM_SET);
+		break;
+#ifdef ML_COMPLEX
+	case ML_ARRAY_FORMAT_C32:
+		ml_array_gemm_complex_float(M, N, K, RowsA, StrideA, RowsB, StrideB, RowsC, ML_ARRAY_GEMM_SET);
+		break;
+	case ML_ARRAY_FORMAT_C64:
+		ml_array_gemm_complex_double(M, N, K, RowsA, StrideA, RowsB, StrideB, RowsC, ML_ARRAY_GEMM_SET);
+		break;
+#endif
+	default:
+		break;
+	}
+	return 1;
+}
+
 ML_METHOD(".", MLArrayT, MLArrayT) {
 //<A
 //<B
@@ -7378,7 +7999,16 @@ ML_METHOD(".", MLArrayT, MLArrayT) {
 	ml_array_format_t Format = MAX(A->Format, B->Format);
 	if (!Degree) {
 		if (SizeA != SizeB) return ml_error("ShapeError", "Incompatible arrays");
-		if (Format <= ML_ARRAY_FORMAT_F64) {
+		ml_array_dimension_t *LastB = DimB + (DegreeB - 1);
+		if (
+			A->Format == ML_ARRAY_FORMAT_F32 && B->Format == ML_ARRAY_FORMAT_F32 &&
+			!DimA->Indices && DimA->Stride == sizeof(float) &&
+			!LastB->Indices && LastB->Stride == sizeof(float)
+		) {
+			double Dot;
+			ml_array_dot_dense_float_double((float *)A->Base.Value, (float *)B->Base.Value, SizeA, &Dot);
+			return ml_real(Dot);
+		} else if (Format <= ML_ARRAY_FORMAT_F64) {
 			void *GetterA = MLArrayGetters[ML_ARRAY_FORMAT_F64][A->Format];
 			void *GetterB = MLArrayGetters[ML_ARRAY_FORMAT_F64][B->Format];
 			ml_array_dot_fn DotFn = MLArrayDotFns[ML_ARRAY_FORMAT_F64];
@@ -7471,7 +8101,7 @@ ML_METHOD(".", MLArrayT, MLArrayT) {
 			B->Base.Value, DimB + (DegreeB - 1), GetterB, DegreeB,
 			C->Base.Value, C->Dimensions, InfixSetFn, C->Degree
 		);
-	} else {
+	} else if (!ml_array_dot_gemm(C, A, B)) {
 		void *GetterA = MLArrayGetters[C->Format][A->Format];
 		void *GetterB = MLArrayGetters[C->Format][B->Format];
 		ml_array_dot_fn DotFn = MLArrayDotFns[C->Format];
@@ -8155,71 +8785,102 @@ ML_METHODX("order", MLVectorT, MLFunctionT) {
 	return ml_values_order(Caller, Size, Values, Args[1], ml_order_permutation);
 }
 
-static int ml_lu_decomp_real(double **A, int *P, int N) {
-	for (int I = 0; I <= N; ++I) P[I] = I;
-	for (int I = 0; I < N; ++I) {
-		double MaxA = 0;
-		int IMax = I;
-		for (int K = I; K < N; ++K) {
-			double AbsA = fabs(A[K][I]);
-			if (AbsA > MaxA) {
-				MaxA = AbsA;
-				IMax = K;
-			}
-		}
-		if (MaxA < DBL_EPSILON) return 0;
-		if (IMax != I) {
-			int J = P[I];
-			P[I] = P[IMax];
-			P[IMax] = J;
-			double *B = A[I];
-			A[I] = A[IMax];
-			A[IMax] = B;
-			P[N]++;
-		}
-		for (int J = I + 1; J < N; ++J) {
-			A[J][I] /= A[I][I];
-			for (int K = I + 1; K < N; ++K) {
-				A[J][K] -= A[J][I] * A[I][K];
-			}
-		}
-	}
-	return 1;
+// Matrices of at least 2 * ML_LU_BLOCK rows are factored / solved in panels of ML_LU_BLOCK
+// rows or columns, with the trailing updates done by ml_array_gemm_*().
+#define ML_LU_BLOCK 64
+
+#define ML_LU_IMPL(NAME, CTYPE, ABS, GEMM) \
+\
+static int ml_lu_decomp_ ## NAME(CTYPE **A, int *P, int N) { \
+	for (int I = 0; I <= N; ++I) P[I] = I; \
+	int Block = N >= 2 * ML_LU_BLOCK ? ML_LU_BLOCK : N; \
+	for (int I0 = 0; I0 < N; I0 += Block) { \
+		int I1 = MIN(I0 + Block, N); \
+		for (int I = I0; I < I1; ++I) { \
+			double MaxA = 0; \
+			int IMax = I; \
+			for (int K = I; K < N; ++K) { \
+				double AbsA = ABS(A[K][I]); \
+				if (AbsA > MaxA) { \
+					MaxA = AbsA; \
+					IMax = K; \
+				} \
+			} \
+			if (MaxA < DBL_EPSILON) return 0; \
+			if (IMax != I) { \
+				int J = P[I]; \
+				P[I] = P[IMax]; \
+				P[IMax] = J; \
+				CTYPE *B = A[I]; \
+				A[I] = A[IMax]; \
+				A[IMax] = B; \
+				P[N]++; \
+			} \
+			for (int J = I + 1; J < N; ++J) { \
+				A[J][I] /= A[I][I]; \
+				for (int K = I + 1; K < I1; ++K) { \
+					A[J][K] -= A[J][I] * A[I][K]; \
+				} \
+			} \
+		} \
+		if (I1 == N) break; \
+		for (int I = I0 + 1; I < I1; ++I) { \
+			for (int J = I0; J < I; ++J) { \
+				CTYPE L = A[I][J], *U = A[J]; \
+				for (int K = I1; K < N; ++K) A[I][K] -= L * U[K]; \
+			} \
+		} \
+		int Rest = N - I1; \
+		char **RowsL = anew(char *, Rest), **RowsU = anew(char *, Block), **RowsA = anew(char *, Rest); \
+		for (int J = 0; J < Rest; ++J) { \
+			RowsL[J] = (char *)(A[I1 + J] + I0); \
+			RowsA[J] = (char *)(A[I1 + J] + I1); \
+		} \
+		for (int J = 0; J < Block; ++J) RowsU[J] = (char *)(A[I0 + J] + I1); \
+		GEMM(Rest, Rest, Block, RowsL, sizeof(CTYPE), RowsU, sizeof(CTYPE), RowsA, ML_ARRAY_GEMM_SUB); \
+	} \
+	return 1; \
+} \
+\
+static void ml_lu_solve_ ## NAME(CTYPE **A, int N, CTYPE **X, int Width) { \
+	int Block = N >= 2 * ML_LU_BLOCK ? ML_LU_BLOCK : N; \
+	char **RowsA = anew(char *, Block), **RowsX = anew(char *, N); \
+	for (int I = 0; I < N; ++I) RowsX[I] = (char *)X[I]; \
+	for (int I0 = 0; I0 < N; I0 += Block) { \
+		int I1 = MIN(I0 + Block, N); \
+		if (I0) { \
+			for (int I = I0; I < I1; ++I) RowsA[I - I0] = (char *)A[I]; \
+			GEMM(I1 - I0, Width, I0, RowsA, sizeof(CTYPE), RowsX, sizeof(CTYPE), RowsX + I0, ML_ARRAY_GEMM_SUB); \
+		} \
+		for (int I = I0; I < I1; ++I) { \
+			for (int K = I0; K < I; ++K) { \
+				CTYPE L = A[I][K], *Row = X[K]; \
+				for (int J = 0; J < Width; ++J) X[I][J] -= L * Row[J]; \
+			} \
+		} \
+	} \
+	for (int I1 = N; I1 > 0; I1 -= Block) { \
+		int I0 = MAX(I1 - Block, 0); \
+		if (I1 < N) { \
+			for (int I = I0; I < I1; ++I) RowsA[I - I0] = (char *)(A[I] + I1); \
+			GEMM(I1 - I0, Width, N - I1, RowsA, sizeof(CTYPE), RowsX + I1, sizeof(CTYPE), RowsX + I0, ML_ARRAY_GEMM_SUB); \
+		} \
+		for (int I = I1 - 1; I >= I0; --I) { \
+			for (int K = I + 1; K < I1; ++K) { \
+				CTYPE U = A[I][K], *Row = X[K]; \
+				for (int J = 0; J < Width; ++J) X[I][J] -= U * Row[J]; \
+			} \
+			CTYPE D = A[I][I]; \
+			for (int J = 0; J < Width; ++J) X[I][J] /= D; \
+		} \
+	} \
 }
 
+ML_LU_IMPL(real, double, fabs, ml_array_gemm_double)
+
 #ifdef ML_COMPLEX
 
-static int ml_lu_decomp_complex(complex double **A, int *P, int N) {
-	for (int I = 0; I <= N; ++I) P[I] = I;
-	for (int I = 0; I < N; ++I) {
-		double MaxA = 0;
-		int IMax = I;
-		for (int K = I; K < N; ++K) {
-			double AbsA = cabs(A[K][I]);
-			if (AbsA > MaxA) {
-				MaxA = AbsA;
-				IMax = K;
-			}
-		}
-		if (MaxA < DBL_EPSILON) return 0;
-		if (IMax != I) {
-			int J = P[I];
-			P[I] = P[IMax];
-			P[IMax] = J;
-			complex double *B = A[I];
-			A[I] = A[IMax];
-			A[IMax] = B;
-			P[N]++;
-		}
-		for (int J = I + 1; J < N; ++J) {
-			A[J][I] /= A[I][I];
-			for (int K = I + 1; K < N; ++K) {
-				A[J][K] -= A[J][I] * A[I][K];
-			}
-		}
-	}
-	return 1;
-}
+ML_LU_IMPL(complex, complex double, cabs, ml_array_gemm_complex_double)
 
 #endif
 
@@ -8324,20 +8985,10 @@ ML_METHOD("\\", MLMatrixT) {
 		double *IA[N];
 		double *InvData = IA[0] = anew(double, N * N);
 		for (int I = 1; I < N; ++I) IA[I] = IA[I - 1] + N;
-		for (int J = 0; J < N; ++J) {
-			for (int I = 0; I < N; ++I) {
-				IA[I][J] = P[I] == J;
-				for (int K = 0; K < I; ++K) {
-					IA[I][J] -= A[I][K] * IA[K][J];
-				}
-			}
-			for (int I = N - 1; I >= 0; --I) {
-				for (int K = I + 1; K < N; ++K) {
-					IA[I][J] -= A[I][K] * IA[K][J];
-				}
-				IA[I][J] /= A[I][I];
-			}
+		for (int I = 0; I < N; ++I) {
+			for (int J = 0; J < N; ++J) IA[I][J] = P[I] == J;
 		}
+		ml_lu_solve_real(A, N, IA, N);
 		Inv->Base.Value = (char *)InvData;
 		return (ml_value_t *)Inv;
 #ifdef ML_COMPLEX
@@ -8357,20 +9008,10 @@ ML_METHOD("\\", MLMatrixT) {
 		complex double *IA[N];
 		complex double *InvData = IA[0] = anew(complex double, N * N);
 		for (int I = 1; I < N; ++I) IA[I] = IA[I - 1] + N;
-		for (int J = 0; J < N; ++J) {
-			for (int I = 0; I < N; ++I) {
-				IA[I][J] = P[I] == J;
-				for (int K = 0; K < I; ++K) {
-					IA[I][J] -= A[I][K] * IA[K][J];
-				}
-			}
-			for (int I = N - 1; I >= 0; --I) {
-				for (int K = I + 1; K < N; ++K) {
-					IA[I][J] -= A[I][K] * IA[K][J];
-				}
-				IA[I][J] /= A[I][I];
-			}
+		for (int I = 0; I < N; ++I) {
+			for (int J = 0; J < N; ++J) IA[I][J] = P[I] == J;
 		}
+		ml_lu_solve_complex(A, N, IA, N);
 		Inv->Base.Value = (char *)InvData;
 		return (ml_value_t *)Inv;
 #endif
@@ -8663,6 +9304,27 @@ ML_METHOD("tr", MLMatrixT) {
 	}
 }
 
+typedef struct {
+	double *Values, *Sums;
+	double Shift;
+	int Size, Chunk;
+} softmax_parallel_t;
+
+static void softmax_sum_fn(softmax_parallel_t *Softmax, int Index) {
+	double *Values = Softmax->Values + Index * Softmax->Chunk;
+	int Size = MIN(Softmax->Chunk, Softmax->Size - Index * Softmax->Chunk);
+	double Shift = Softmax->Shift, Sum = 0.0;
+	for (int I = 0; I < Size; ++I) Sum += exp(Values[I] - Shift);
+	Softmax->Sums[Index] = Sum;
+}
+
+static void softmax_scale_fn(softmax_parallel_t *Softmax, int Index) {
+	double *Values = Softmax->Values + Index * Softmax->Chunk;
+	int Size = MIN(Softmax->Chunk, Softmax->Size - Index * Softmax->Chunk);
+	double Shift = Softmax->Shift;
+	for (int I = 0; I < Size; ++I) Values[I] = exp(Values[I] - Shift);
+}
+
 ML_METHOD("softmax", MLVectorRealT) {
 //<Vector
 //>vector
@@ -8673,21 +9335,782 @@ ML_METHOD("softmax", MLVectorRealT) {
 	int N = A->Dimensions[0].Size;
 	ml_array_t *B = ml_array(ML_ARRAY_FORMAT_F64, 1, N);
 	ml_array_copy(B, A);
+	if (!N) return (ml_value_t *)B;
 	double *Values = (double *)B->Base.Value;
-	double M = -INFINITY;
-	for (int I = 0; I < N; ++I) if (M < Values[I]) M = Values[I];
+	double M = parallel_maxs_double(1, B->Dimensions, Values);
+	int Chunk = ml_array_parallel_rows(N, N) ?: N;
+	int NumChunks = (N + Chunk - 1) / Chunk;
+	double Sums[NumChunks];
+	softmax_parallel_t Softmax[1] = {{Values, Sums, M, N, Chunk}};
+	ml_array_parallel(NumChunks, (ml_array_parallel_fn)softmax_sum_fn, Softmax);
 	double Sum = 0.0;
-	for (int I = 0; I < N; ++I) Sum += exp(Values[I] - M);
-	double C = M + log(Sum);
-	for (int I = 0; I < N; ++I) Values[I] = exp(Values[I] - C);
+	for (int I = 0; I < NumChunks; ++I) Sum += Sums[I];
+	Softmax->Shift = M + log(Sum);
+	ml_array_parallel(NumChunks, (ml_array_parallel_fn)softmax_scale_fn, Softmax);
 	return (ml_value_t *)B;
 }
 
+// Lazy arrays record element-wise operations as a small expression graph.
+// The graph is evaluated in blocks of ML_ARRAY_LAZY_BLOCK values along the
+// last dimension so that every intermediate result stays in cache and only
+// the final result (if any) is written to memory.
+
+#define ML_ARRAY_LAZY_BLOCK 256
+
+typedef enum {
+	ML_ARRAY_LAZY_VALUE,
+	ML_ARRAY_LAZY_NEG,
+	ML_ARRAY_LAZY_ADD,
+	ML_ARRAY_LAZY_SUB,
+	ML_ARRAY_LAZY_MUL,
+	ML_ARRAY_LAZY_DIV,
+	ML_ARRAY_LAZY_MIN,
+	ML_ARRAY_LAZY_MAX
+} ml_array_lazy_op_t;
+
+typedef enum {
+	ML_ARRAY_LAZY_INTEGER,
+	ML_ARRAY_LAZY_REAL,
+	ML_ARRAY_LAZY_COMPLEX
+} ml_array_lazy_kind_t;
+
+#define ML_ARRAY_LAZY_KIND(FORMAT) ((FORMAT) <= ML_ARRAY_FORMAT_I64 ? ML_ARRAY_LAZY_INTEGER : (FORMAT) <= ML_ARRAY_FORMAT_F64 ? ML_ARRAY_LAZY_REAL : ML_ARRAY_LAZY_COMPLEX)
+#define ML_ARRAY_LAZY_SIZE(FORMAT) (ML_ARRAY_LAZY_KIND(FORMAT) == ML_ARRAY_LAZY_COMPLEX ? 2 * sizeof(double) : sizeof(int64_t))
+
+typedef struct ml_array_lazy_t ml_array_lazy_t;
+
+struct ml_array_lazy_t {
+	ml_type_t *Type;
+	ml_array_lazy_t *Left, *Right;
+	ml_value_t *Value;
+	ml_array_dimension_t *Dimensions;
+	ml_array_lazy_op_t Op;
+	ml_array_format_t Format;
+	int Degree;
+};
+
+static ml_array_lazy_t *ml_array_lazy_node(ml_value_t *Value);
+
+ML_FUNCTION(MLArrayLazy) {
+//@array::lazy
+//<Array
+//>array::lazy
+// Returns a lazy version of :mini:`Array`. Element-wise arithmetic (:mini:`+`, :mini:`-`, :mini:`*`, :mini:`/`, :mini:`min` and :mini:`max`) involving lazy arrays returns another lazy array without computing any values.
+// The values are computed in a single pass, without intermediate arrays, when the lazy array is converted with :mini:`:array`, indexed, printed or reduced with :mini:`:sum`, :mini:`:prod`, :mini:`:minval` or :mini:`:maxval`.
+// Each intermediate value is computed in the format that the corresponding eager operation would use.
+//$= let A := array::lazy(array([[1, 2], [3, 4]]))
+//$= let B := (A * 2) - (A / 4)
+//$= B:array
+//$= B:sum
+	ML_CHECK_ARG_COUNT(1);
+	ML_CHECK_ARG_TYPE(0, MLArrayT);
+	return (ml_value_t *)ml_array_lazy_node(Args[0]) ?: ml_error("TypeError", "Invalid array format for lazy array");
+}
+
+ML_TYPE(MLArrayLazyT, (), "array::lazy",
+// A lazily evaluated array expression.
+	.Constructor = (ml_value_t *)MLArrayLazy
+);
+
+static ml_array_lazy_t *ml_array_lazy_node(ml_value_t *Value) {
+	if (ml_is(Value, MLArrayLazyT)) return (ml_array_lazy_t *)Value;
+	ml_array_lazy_t *Lazy = new(ml_array_lazy_t);
+	Lazy->Type = MLArrayLazyT;
+	Lazy->Op = ML_ARRAY_LAZY_VALUE;
+	Lazy->Value = Value;
+	if (ml_is(Value, MLArrayT)) {
+		ml_array_t *Array = (ml_array_t *)Value;
+		if (Array->Degree < 0 || Array->Format == ML_ARRAY_FORMAT_ANY) return NULL;
+		Lazy->Format = Array->Format;
+		Lazy->Degree = Array->Degree;
+		Lazy->Dimensions = Array->Dimensions;
+	} else if (ml_is(Value, MLIntegerT)) {
+		Lazy->Format = ML_ARRAY_FORMAT_I64;
+	} else if (ml_is(Value, MLRealT)) {
+		Lazy->Format = ML_ARRAY_FORMAT_F64;
+#ifdef ML_COMPLEX
+	} else if (ml_is(Value, MLComplexT)) {
+		Lazy->Format = ML_ARRAY_FORMAT_C64;
+#endif
+	} else {
+		return NULL;
+	}
+	return Lazy;
+}
+
+static ml_array_format_t ml_array_lazy_format(ml_array_lazy_op_t Op, ml_array_lazy_t *A, ml_array_lazy_t *B) {
+	// Follows the eager operators, where a number operand selects its own result format.
+	int ScalarA = A->Op == ML_ARRAY_LAZY_VALUE && !ml_is(A->Value, MLArrayT);
+	int ScalarB = B->Op == ML_ARRAY_LAZY_VALUE && !ml_is(B->Value, MLArrayT);
+	ml_array_format_t Format = MAX(A->Format, B->Format);
+	if (ScalarA == ScalarB) {
+		if (Op == ML_ARRAY_LAZY_DIV) Format = MAX(Format, ML_ARRAY_FORMAT_F64);
+		return Format;
+	}
+	ml_array_lazy_t *Scalar = ScalarA ? A : B;
+	if (Op == ML_ARRAY_LAZY_MIN || Op == ML_ARRAY_LAZY_MAX) return Scalar->Format;
+	if (Format >= ML_ARRAY_FORMAT_C32) return ML_ARRAY_FORMAT_C64;
+	if (Format <= ML_ARRAY_FORMAT_I64) return Op == ML_ARRAY_LAZY_DIV ? ML_ARRAY_FORMAT_F64 : ML_ARRAY_FORMAT_I64;
+	return ML_ARRAY_FORMAT_F64;
+}
+
+static ml_value_t *ml_array_lazy_infix(void *Data, int Count, ml_value_t **Args) {
+	ml_array_lazy_op_t Op = (ml_array_lazy_op_t)(intptr_t)Data;
+	ml_array_lazy_t *A = ml_array_lazy_node(Args[0]);
+	ml_array_lazy_t *B = ml_array_lazy_node(Args[1]);
+	if (!A || !B) return ml_error("TypeError", "Invalid types for array operation");
+	ml_array_lazy_t *Shape = A, *Other = B;
+	if (A->Degree < B->Degree) {
+		Shape = B;
+		Other = A;
+	}
+	for (int D = Shape->Degree - Other->Degree, I = Other->Degree; --I >= 0;) {
+		if (Shape->Dimensions[D + I].Size != Other->Dimensions[I].Size) {
+			return ml_error("ShapeError", "Incompatible arrays");
+		}
+	}
+	ml_array_format_t Format = ml_array_lazy_format(Op, A, B);
+#ifdef ML_COMPLEX
+	if (Format >= ML_ARRAY_FORMAT_C32 && (Op == ML_ARRAY_LAZY_MIN || Op == ML_ARRAY_LAZY_MAX)) {
+		return ml_error("TypeError", "Invalid types for array operation");
+	}
+#endif
+	ml_array_lazy_t *C = new(ml_array_lazy_t);
+	C->Type = MLArrayLazyT;
+	C->Op = Op;
+	C->Left = A;
+	C->Right = B;
+	C->Format = Format;
+	C->Degree = Shape->Degree;
+	C->Dimensions = Shape->Dimensions;
+	return (ml_value_t *)C;
+}
+
+/*
+ML_METHOD(OP, MLArrayLazyT, MLArrayLazyT) {
+//<A
+//<B
+//>array::lazy
+// Returns a lazy array for :mini:`A OP B` (element-wise) where :mini:`OP` is one of :mini:`+`, :mini:`-`, :mini:`*`, :mini:`/`, :mini:`min` or :mini:`max`.
+// Either argument may also be an :mini:`array` or a :mini:`number`, shapes are broadcast in the same way as for :mini:`array`.
+}
+*/
+
+ML_METHOD("-", MLArrayLazyT) {
+//<A
+//>array::lazy
+// Returns a lazy array for :mini:`-A` (element-wise).
+	ml_array_lazy_t *A = (ml_array_lazy_t *)Args[0];
+	ml_array_lazy_t *C = new(ml_array_lazy_t);
+	C->Type = MLArrayLazyT;
+	C->Op = ML_ARRAY_LAZY_NEG;
+	C->Left = A;
+	switch (A->Format) {
+	case ML_ARRAY_FORMAT_U8: C->Format = ML_ARRAY_FORMAT_I8; break;
+	case ML_ARRAY_FORMAT_U16: C->Format = ML_ARRAY_FORMAT_I16; break;
+	case ML_ARRAY_FORMAT_U32: C->Format = ML_ARRAY_FORMAT_I32; break;
+	case ML_ARRAY_FORMAT_U64: C->Format = ML_ARRAY_FORMAT_I64; break;
+	default: C->Format = A->Format; break;
+	}
+	C->Degree = A->Degree;
+	C->Dimensions = A->Dimensions;
+	return (ml_value_t *)C;
+}
+
+typedef struct {
+	ml_array_lazy_t *Node;
+	ml_array_dimension_t *Dimensions;
+	char *Row;
+	void *Values, *LeftValues, *RightValues;
+	int Degree, Left, Right;
+	ml_array_dimension_t Flat[1];
+} ml_array_lazy_step_t;
+
+typedef struct ml_array_lazy_plan_t ml_array_lazy_plan_t;
+
+struct ml_array_lazy_plan_t {
+	void (*run)(ml_array_lazy_plan_t *Plan, int Offset, int Count);
+	ml_array_lazy_step_t *Steps;
+	ml_array_dimension_t *Dimensions;
+	char *Target;
+	ml_array_format_t Format;
+	int NumSteps, MaxSteps, Degree;
+	ml_array_dimension_t Flat[1];
+	int64_t Integer;
+	double Real;
+#ifdef ML_COMPLEX
+	complex_double Complex;
+#endif
+};
+
+static int ml_array_lazy_plan_add(ml_array_lazy_plan_t *Plan, ml_array_lazy_t *Node) {
+	for (int I = 0; I < Plan->NumSteps; ++I) {
+		ml_array_lazy_t *Existing = Plan->Steps[I].Node;
+		if (Existing == Node) return I;
+		if (Existing->Op == ML_ARRAY_LAZY_VALUE && Node->Op == ML_ARRAY_LAZY_VALUE && Existing->Value == Node->Value) return I;
+	}
+	int Left = Node->Left ? ml_array_lazy_plan_add(Plan, Node->Left) : -1;
+	int Right = Node->Right ? ml_array_lazy_plan_add(Plan, Node->Right) : -1;
+	if (Plan->NumSteps == Plan->MaxSteps) {
+		Plan->MaxSteps *= 2;
+		ml_array_lazy_step_t *Steps = anew(ml_array_lazy_step_t, Plan->MaxSteps);
+		memcpy(Steps, Plan->Steps, Plan->NumSteps * sizeof(ml_array_lazy_step_t));
+		Plan->Steps = Steps;
+	}
+	ml_array_lazy_step_t *Step = Plan->Steps + Plan->NumSteps;
+	Step->Node = Node;
+	Step->Left = Left;
+	Step->Right = Right;
+	if (Node->Op == ML_ARRAY_LAZY_VALUE && Node->Degree) {
+		Step->Degree = Node->Degree;
+		Step->Dimensions = Node->Dimensions;
+	}
+	return Plan->NumSteps++;
+}
+
+
+static void ml_array_lazy_plan_init(ml_array_lazy_plan_t *Plan, ml_array_lazy_t *Root) {
+	Plan->MaxSteps = 8;
+	Plan->Steps = anew(ml_array_lazy_step_t, Plan->MaxSteps);
+	ml_array_lazy_plan_add(Plan, Root);
+	Plan->Format = Root->Format;
+	Plan->Degree = Root->Degree;
+	Plan->Dimensions = Root->Dimensions;
+	if (!Plan->Degree) return;
+	// If every array has the full shape and is stored contiguously then the whole expression is evaluated as a single row.
+	int Total = 1;
+	for (int I = 0; I < Plan->Degree; ++I) Total *= Plan->Dimensions[I].Size;
+	for (int I = 0; I < Plan->NumSteps; ++I) {
+		ml_array_lazy_step_t *Step = Plan->Steps + I;
+		if (!Step->Degree) continue;
+		if (Step->Degree != Plan->Degree) return;
+		ml_array_t *Array = (ml_array_t *)Step->Node->Value;
+		if (!ml_array_dims_dense(Array->Degree, Array->Dimensions, MLArraySizes[Array->Format])) return;
+	}
+	for (int I = 0; I < Plan->NumSteps; ++I) {
+		ml_array_lazy_step_t *Step = Plan->Steps + I;
+		if (!Step->Degree) continue;
+		Step->Flat->Size = Total;
+		Step->Flat->Stride = MLArraySizes[Step->Node->Format];
+		Step->Degree = 1;
+		Step->Dimensions = Step->Flat;
+	}
+	Plan->Flat->Size = Total;
+	Plan->Degree = 1;
+	Plan->Dimensions = Plan->Flat;
+}
+
+static void ml_array_lazy_plan_run(ml_array_lazy_plan_t *Plan) {
+	int Degree = Plan->Degree;
+	if (!Degree) return Plan->run(Plan, 0, 1);
+	int Indices[Degree];
+	for (int I = 0; I < Degree; ++I) Indices[I] = 0;
+	int Size = Plan->Dimensions[Degree - 1].Size;
+	for (;;) {
+		for (int I = 0; I < Plan->NumSteps; ++I) {
+			ml_array_lazy_step_t *Step = Plan->Steps + I;
+			if (!Step->Degree) continue;
+			char *Address = ((ml_array_t *)Step->Node->Value)->Base.Value;
+			for (int J = 0, Shift = Degree - Step->Degree; J < Step->Degree - 1; ++J) {
+				Address = ml_array_step(Address, Step->Dimensions + J, Indices[Shift + J]);
+			}
+			Step->Row = Address;
+		}
+		for (int Offset = 0; Offset < Size; Offset += ML_ARRAY_LAZY_BLOCK) {
+			Plan->run(Plan, Offset, MIN(ML_ARRAY_LAZY_BLOCK, Size - Offset));
+		}
+		for (int J = Degree - 1;;) {
+			if (--J < 0) return;
+			if (++Indices[J] < Plan->Dimensions[J].Size) break;
+			Indices[J] = 0;
+		}
+	}
+}
+
+#define ML_ARRAY_LAZY_LOAD(FORMAT, TYPE) \
+	case FORMAT: { \
+		if (Dimension->Indices) { \
+			const int *Indices = Dimension->Indices + Offset; \
+			for (int I = 0; I < Count; ++I) Values[I] = *(TYPE *)(Row + Indices[I] * Stride); \
+		} else if (Stride == sizeof(TYPE)) { \
+			const TYPE *Source = (const TYPE *)Row + Offset; \
+			for (int I = 0; I < Count; ++I) Values[I] = Source[I]; \
+		} else { \
+			Row += Offset * Stride; \
+			for (int I = 0; I < Count; ++I) Values[I] = *(TYPE *)(Row + I * Stride); \
+		} \
+		break; \
+	}
+
+#define ML_ARRAY_LAZY_STORE(FORMAT, TYPE) \
+	case FORMAT: { \
+		TYPE *Target = (TYPE *)Plan->Target; \
+		for (int I = 0; I < Count; ++I) Target[I] = Values[I]; \
+		Plan->Target = (char *)(Target + Count); \
+		break; \
+	}
+
+#define ML_ARRAY_LAZY_REAL_FORMATS(MACRO) \
+	MACRO(ML_ARRAY_FORMAT_U8, uint8_t) \
+	MACRO(ML_ARRAY_FORMAT_I8, int8_t) \
+	MACRO(ML_ARRAY_FORMAT_U16, uint16_t) \
+	MACRO(ML_ARRAY_FORMAT_I16, int16_t) \
+	MACRO(ML_ARRAY_FORMAT_U32, uint32_t) \
+	MACRO(ML_ARRAY_FORMAT_I32, int32_t) \
+	MACRO(ML_ARRAY_FORMAT_U64, uint64_t) \
+	MACRO(ML_ARRAY_FORMAT_I64, int64_t) \
+	MACRO(ML_ARRAY_FORMAT_F32, float) \
+	MACRO(ML_ARRAY_FORMAT_F64, double)
+
+#define ML_ARRAY_LAZY_COMPLEX_FORMATS(MACRO) \
+	ML_ARRAY_LAZY_REAL_FORMATS(MACRO) \
+	MACRO(ML_ARRAY_FORMAT_C32, complex_float) \
+	MACRO(ML_ARRAY_FORMAT_C64, complex_double)
+
+// Each step is computed in int64_t, double or complex_double depending on the format of its node.
+// Operands are converted and narrowed to the format of the node first and each result is narrowed to that format afterwards,
+// so that integer overflow, float rounding and comparisons match the eager operations.
+
+#define ML_ARRAY_LAZY_NARROW(FORMAT, TYPE) \
+	case FORMAT: for (int I = 0; I < Count; ++I) Values[I] = (TYPE)Values[I]; break;
+
+#define ML_ARRAY_LAZY_INTEGER_NARROW(MACRO) \
+	MACRO(ML_ARRAY_FORMAT_U8, uint8_t) \
+	MACRO(ML_ARRAY_FORMAT_I8, int8_t) \
+	MACRO(ML_ARRAY_FORMAT_U16, uint16_t) \
+	MACRO(ML_ARRAY_FORMAT_I16, int16_t) \
+	MACRO(ML_ARRAY_FORMAT_U32, uint32_t) \
+	MACRO(ML_ARRAY_FORMAT_I32, int32_t)
+
+#define ML_ARRAY_LAZY_REAL_NARROW(MACRO) \
+	MACRO(ML_ARRAY_FORMAT_F32, float)
+
+#define ML_ARRAY_LAZY_COMPLEX_NARROW(MACRO) \
+	MACRO(ML_ARRAY_FORMAT_C32, complex_float)
+
+#define ML_ARRAY_LAZY_CONVERT(SOURCE) { \
+	const SOURCE *Source = (const SOURCE *)Operand->Values; \
+	for (int I = 0; I < Count; ++I) Values[I] = Source[I]; \
+	break; \
+}
+
+#ifdef ML_COMPLEX
+#define ML_ARRAY_LAZY_CONVERT_COMPLEX case ML_ARRAY_LAZY_COMPLEX: ML_ARRAY_LAZY_CONVERT(complex_double)
+#else
+#define ML_ARRAY_LAZY_CONVERT_COMPLEX
+#endif
+
+#define ML_ARRAY_LAZY_BINARY(CTYPE, OP, EXPR) \
+		case OP: { \
+			const CTYPE *A = ml_array_lazy_operand_ ## CTYPE(Plan->Steps + Step->Left, Format, Step->LeftValues, Count); \
+			const CTYPE *B = ml_array_lazy_operand_ ## CTYPE(Plan->Steps + Step->Right, Format, Step->RightValues, Count); \
+			for (int I = 0; I < Count; ++I) Values[I] = EXPR; \
+			break; \
+		}
+
+#define ML_ARRAY_LAZY_MINMAX(CTYPE) \
+		ML_ARRAY_LAZY_BINARY(CTYPE, ML_ARRAY_LAZY_MIN, A[I] < B[I] ? A[I] : B[I]) \
+		ML_ARRAY_LAZY_BINARY(CTYPE, ML_ARRAY_LAZY_MAX, A[I] > B[I] ? A[I] : B[I])
+
+#define ML_ARRAY_LAZY_INTEGER_MINMAX(CTYPE) \
+		case ML_ARRAY_LAZY_MIN: \
+		case ML_ARRAY_LAZY_MAX: { \
+			const CTYPE *A = ml_array_lazy_operand_ ## CTYPE(Plan->Steps + Step->Left, Format, Step->LeftValues, Count); \
+			const CTYPE *B = ml_array_lazy_operand_ ## CTYPE(Plan->Steps + Step->Right, Format, Step->RightValues, Count); \
+			if (Format == ML_ARRAY_FORMAT_U64) { \
+				const uint64_t *UA = (const uint64_t *)A, *UB = (const uint64_t *)B; \
+				if (Step->Node->Op == ML_ARRAY_LAZY_MIN) { \
+					for (int I = 0; I < Count; ++I) Values[I] = UA[I] < UB[I] ? UA[I] : UB[I]; \
+				} else { \
+					for (int I = 0; I < Count; ++I) Values[I] = UA[I] > UB[I] ? UA[I] : UB[I]; \
+				} \
+			} else if (Step->Node->Op == ML_ARRAY_LAZY_MIN) { \
+				for (int I = 0; I < Count; ++I) Values[I] = A[I] < B[I] ? A[I] : B[I]; \
+			} else { \
+				for (int I = 0; I < Count; ++I) Values[I] = A[I] > B[I] ? A[I] : B[I]; \
+			} \
+			break; \
+		}
+
+#define ML_ARRAY_LAZY_NO_MINMAX(CTYPE)
+
+#define ML_ARRAY_LAZY_IMPL(CTYPE, FIELD, TO_CTYPE, FORMATS, NARROW, MINMAX) \
+\
+static void ml_array_lazy_narrow_ ## CTYPE(CTYPE *Values, ml_array_format_t Format, int Count) { \
+	switch (Format) { \
+	NARROW(ML_ARRAY_LAZY_NARROW) \
+	default: break; \
+	} \
+} \
+\
+static const CTYPE *ml_array_lazy_operand_ ## CTYPE(ml_array_lazy_step_t *Operand, ml_array_format_t Format, CTYPE *Values, int Count) { \
+	ml_array_format_t OperandFormat = Operand->Node->Format; \
+	if (!Values) return Operand->Values; \
+	switch (ML_ARRAY_LAZY_KIND(OperandFormat)) { \
+	case ML_ARRAY_LAZY_INTEGER: \
+		if (OperandFormat == ML_ARRAY_FORMAT_U64) ML_ARRAY_LAZY_CONVERT(uint64_t) \
+		ML_ARRAY_LAZY_CONVERT(int64_t) \
+	case ML_ARRAY_LAZY_REAL: ML_ARRAY_LAZY_CONVERT(double) \
+	ML_ARRAY_LAZY_CONVERT_COMPLEX \
+	} \
+	ml_array_lazy_narrow_ ## CTYPE(Values, Format, Count); \
+	return Values; \
+} \
+\
+static ML_ARRAY_KERNEL void ml_array_lazy_load_ ## CTYPE(CTYPE *Values, ml_array_format_t Format, char *Row, ml_array_dimension_t *Dimension, int Offset, int Count) { \
+	int Stride = Dimension->Stride; \
+	switch (Format) { \
+	FORMATS(ML_ARRAY_LAZY_LOAD) \
+	default: break; \
+	} \
+} \
+\
+static ML_ARRAY_KERNEL void ml_array_lazy_step_ ## CTYPE(ml_array_lazy_plan_t *Plan, ml_array_lazy_step_t *Step, int Offset, int Count) { \
+	CTYPE *Values = (CTYPE *)Step->Values; \
+	ml_array_format_t Format = Step->Node->Format; \
+	switch (Step->Node->Op) { \
+	case ML_ARRAY_LAZY_VALUE: \
+		if (Step->Degree) ml_array_lazy_load_ ## CTYPE(Values, Format, Step->Row, Step->Dimensions + Step->Degree - 1, Offset, Count); \
+		return; \
+	case ML_ARRAY_LAZY_NEG: { \
+		const CTYPE *A = ml_array_lazy_operand_ ## CTYPE(Plan->Steps + Step->Left, Format, Step->LeftValues, Count); \
+		for (int I = 0; I < Count; ++I) Values[I] = -A[I]; \
+		break; \
+	} \
+	ML_ARRAY_LAZY_BINARY(CTYPE, ML_ARRAY_LAZY_ADD, A[I] + B[I]) \
+	ML_ARRAY_LAZY_BINARY(CTYPE, ML_ARRAY_LAZY_SUB, A[I] - B[I]) \
+	ML_ARRAY_LAZY_BINARY(CTYPE, ML_ARRAY_LAZY_MUL, A[I] * B[I]) \
+	ML_ARRAY_LAZY_BINARY(CTYPE, ML_ARRAY_LAZY_DIV, A[I] / B[I]) \
+	MINMAX(CTYPE) \
+	default: break; \
+	} \
+	ml_array_lazy_narrow_ ## CTYPE(Values, Format, Count); \
+} \
+\
+static void ml_array_lazy_setup_ ## CTYPE(ml_array_lazy_step_t *Step) { \
+	CTYPE *Values = (CTYPE *)Step->Values; \
+	ml_array_lazy_t *Node = Step->Node; \
+	if (ml_is(Node->Value, MLArrayT)) { \
+		ml_array_dimension_t Dimension[1] = {{ML_ARRAY_LAZY_BLOCK, 0, NULL}}; \
+		ml_array_lazy_load_ ## CTYPE(Values, Node->Format, ((ml_array_t *)Node->Value)->Base.Value, Dimension, 0, ML_ARRAY_LAZY_BLOCK); \
+	} else { \
+		CTYPE Value = TO_CTYPE(Node->Value); \
+		for (int I = 0; I < ML_ARRAY_LAZY_BLOCK; ++I) Values[I] = Value; \
+	} \
+} \
+\
+static ML_ARRAY_KERNEL void ml_array_lazy_store_ ## CTYPE(ml_array_lazy_plan_t *Plan, int Offset, int Count) { \
+	ml_array_lazy_eval(Plan, Offset, Count); \
+	const CTYPE *Values = Plan->Steps[Plan->NumSteps - 1].Values; \
+	switch (Plan->Format) { \
+	FORMATS(ML_ARRAY_LAZY_STORE) \
+	default: break; \
+	} \
+} \
+\
+static void ml_array_lazy_sum_ ## CTYPE(ml_array_lazy_plan_t *Plan, int Offset, int Count) { \
+	ml_array_lazy_eval(Plan, Offset, Count); \
+	CTYPE Sum; \
+	dense_sums_ ## CTYPE(Plan->Steps[Plan->NumSteps - 1].Values, Count, &Sum); \
+	Plan->FIELD += Sum; \
+} \
+\
+static void ml_array_lazy_prod_ ## CTYPE(ml_array_lazy_plan_t *Plan, int Offset, int Count) { \
+	ml_array_lazy_eval(Plan, Offset, Count); \
+	CTYPE Prod; \
+	dense_prods_ ## CTYPE(Plan->Steps[Plan->NumSteps - 1].Values, Count, &Prod); \
+	Plan->FIELD *= Prod; \
+}
+
+#define ML_ARRAY_LAZY_EXTREMA(CTYPE, FIELD) \
+\
+static ML_ARRAY_KERNEL void ml_array_lazy_min_ ## CTYPE(ml_array_lazy_plan_t *Plan, int Offset, int Count) { \
+	ml_array_lazy_eval(Plan, Offset, Count); \
+	const CTYPE *Values = Plan->Steps[Plan->NumSteps - 1].Values; \
+	CTYPE Min = Plan->FIELD; \
+	for (int I = 0; I < Count; ++I) if (Values[I] < Min) Min = Values[I]; \
+	Plan->FIELD = Min; \
+} \
+\
+static ML_ARRAY_KERNEL void ml_array_lazy_max_ ## CTYPE(ml_array_lazy_plan_t *Plan, int Offset, int Count) { \
+	ml_array_lazy_eval(Plan, Offset, Count); \
+	const CTYPE *Values = Plan->Steps[Plan->NumSteps - 1].Values; \
+	CTYPE Max = Plan->FIELD; \
+	for (int I = 0; I < Count; ++I) if (Values[I] > Max) Max = Values[I]; \
+	Plan->FIELD = Max; \
+}
+
+static void ml_array_lazy_eval(ml_array_lazy_plan_t *Plan, int Offset, int Count);
+
+ML_ARRAY_LAZY_IMPL(int64_t, Integer, ml_integer_value, ML_ARRAY_LAZY_REAL_FORMATS, ML_ARRAY_LAZY_INTEGER_NARROW, ML_ARRAY_LAZY_INTEGER_MINMAX)
+ML_ARRAY_LAZY_EXTREMA(int64_t, Integer)
+ML_ARRAY_LAZY_EXTREMA(uint64_t, Integer)
+ML_ARRAY_LAZY_IMPL(double, Real, ml_real_value, ML_ARRAY_LAZY_REAL_FORMATS, ML_ARRAY_LAZY_REAL_NARROW, ML_ARRAY_LAZY_MINMAX)
+ML_ARRAY_LAZY_EXTREMA(double, Real)
+
+#ifdef ML_COMPLEX
+
+ML_ARRAY_LAZY_IMPL(complex_double, Complex, ml_complex_value, ML_ARRAY_LAZY_COMPLEX_FORMATS, ML_ARRAY_LAZY_COMPLEX_NARROW, ML_ARRAY_LAZY_NO_MINMAX)
+
+#endif
+
+static void ml_array_lazy_eval(ml_array_lazy_plan_t *Plan, int Offset, int Count) {
+	for (int S = 0; S < Plan->NumSteps; ++S) {
+		ml_array_lazy_step_t *Step = Plan->Steps + S;
+		switch (ML_ARRAY_LAZY_KIND(Step->Node->Format)) {
+		case ML_ARRAY_LAZY_INTEGER: ml_array_lazy_step_int64_t(Plan, Step, Offset, Count); break;
+		case ML_ARRAY_LAZY_REAL: ml_array_lazy_step_double(Plan, Step, Offset, Count); break;
+#ifdef ML_COMPLEX
+		case ML_ARRAY_LAZY_COMPLEX: ml_array_lazy_step_complex_double(Plan, Step, Offset, Count); break;
+#endif
+		}
+	}
+}
+
+static int ml_array_lazy_needs_convert(ml_array_format_t Format, ml_array_format_t OperandFormat) {
+	if (Format == OperandFormat) return 0;
+	if (ML_ARRAY_LAZY_KIND(Format) != ML_ARRAY_LAZY_KIND(OperandFormat)) return 1;
+	// Values of the same kind only need narrowing when the node format is narrower than the working type.
+	switch (Format) {
+	case ML_ARRAY_FORMAT_U64: case ML_ARRAY_FORMAT_I64: case ML_ARRAY_FORMAT_F64: case ML_ARRAY_FORMAT_C64: return 0;
+	default: return 1;
+	}
+}
+
+static void ml_array_lazy_setup(ml_array_lazy_plan_t *Plan) {
+	for (int S = 0; S < Plan->NumSteps; ++S) {
+		ml_array_lazy_step_t *Step = Plan->Steps + S;
+		ml_array_lazy_t *Node = Step->Node;
+		size_t Size = ML_ARRAY_LAZY_BLOCK * ML_ARRAY_LAZY_SIZE(Node->Format);
+		Step->Values = snew(Size);
+		if (Node->Op != ML_ARRAY_LAZY_VALUE) {
+			if (ml_array_lazy_needs_convert(Node->Format, Plan->Steps[Step->Left].Node->Format)) Step->LeftValues = snew(Size);
+			if (Step->Right >= 0 && ml_array_lazy_needs_convert(Node->Format, Plan->Steps[Step->Right].Node->Format)) Step->RightValues = snew(Size);
+			continue;
+		}
+		if (Step->Degree) continue;
+		switch (ML_ARRAY_LAZY_KIND(Node->Format)) {
+		case ML_ARRAY_LAZY_INTEGER: ml_array_lazy_setup_int64_t(Step); break;
+		case ML_ARRAY_LAZY_REAL: ml_array_lazy_setup_double(Step); break;
+#ifdef ML_COMPLEX
+		case ML_ARRAY_LAZY_COMPLEX: ml_array_lazy_setup_complex_double(Step); break;
+#endif
+		}
+	}
+}
+
+typedef enum {
+	ML_ARRAY_LAZY_STORE,
+	ML_ARRAY_LAZY_SUM,
+	ML_ARRAY_LAZY_PROD,
+	ML_ARRAY_LAZY_MINVAL,
+	ML_ARRAY_LAZY_MAXVAL
+} ml_array_lazy_action_t;
+
+static ml_value_t *ml_array_lazy_run(ml_array_lazy_plan_t *Plan, ml_array_lazy_t *Lazy, ml_array_lazy_action_t Action) {
+	ml_array_lazy_plan_init(Plan, Lazy);
+	ml_array_lazy_setup(Plan);
+	switch (ML_ARRAY_LAZY_KIND(Lazy->Format)) {
+	case ML_ARRAY_LAZY_INTEGER:
+		switch (Action) {
+		case ML_ARRAY_LAZY_STORE: Plan->run = ml_array_lazy_store_int64_t; break;
+		case ML_ARRAY_LAZY_SUM: Plan->run = ml_array_lazy_sum_int64_t; Plan->Integer = 0; break;
+		case ML_ARRAY_LAZY_PROD: Plan->run = ml_array_lazy_prod_int64_t; Plan->Integer = 1; break;
+		case ML_ARRAY_LAZY_MINVAL:
+			if (Lazy->Format == ML_ARRAY_FORMAT_U64) {
+				Plan->run = ml_array_lazy_min_uint64_t; Plan->Integer = (int64_t)UINT64_MAX;
+			} else {
+				Plan->run = ml_array_lazy_min_int64_t; Plan->Integer = INT64_MAX;
+			}
+			break;
+		case ML_ARRAY_LAZY_MAXVAL:
+			if (Lazy->Format == ML_ARRAY_FORMAT_U64) {
+				Plan->run = ml_array_lazy_max_uint64_t; Plan->Integer = 0;
+			} else {
+				Plan->run = ml_array_lazy_max_int64_t; Plan->Integer = INT64_MIN;
+			}
+			break;
+		}
+		ml_array_lazy_plan_run(Plan);
+		return ml_integer(Plan->Integer);
+	case ML_ARRAY_LAZY_REAL:
+		switch (Action) {
+		case ML_ARRAY_LAZY_STORE: Plan->run = ml_array_lazy_store_double; break;
+		case ML_ARRAY_LAZY_SUM: Plan->run = ml_array_lazy_sum_double; Plan->Real = 0; break;
+		case ML_ARRAY_LAZY_PROD: Plan->run = ml_array_lazy_prod_double; Plan->Real = 1; break;
+		case ML_ARRAY_LAZY_MINVAL: Plan->run = ml_array_lazy_min_double; Plan->Real = INFINITY; break;
+		case ML_ARRAY_LAZY_MAXVAL: Plan->run = ml_array_lazy_max_double; Plan->Real = -INFINITY; break;
+		}
+		ml_array_lazy_plan_run(Plan);
+		return ml_real(Plan->Real);
+#ifdef ML_COMPLEX
+	case ML_ARRAY_LAZY_COMPLEX:
+		switch (Action) {
+		case ML_ARRAY_LAZY_STORE: Plan->run = ml_array_lazy_store_complex_double; break;
+		case ML_ARRAY_LAZY_SUM: Plan->run = ml_array_lazy_sum_complex_double; Plan->Complex = 0; break;
+		case ML_ARRAY_LAZY_PROD: Plan->run = ml_array_lazy_prod_complex_double; Plan->Complex = 1; break;
+		default: return ml_error("TypeError", "Invalid types for array operation");
+		}
+		ml_array_lazy_plan_run(Plan);
+		return ml_complex(Plan->Complex);
+#endif
+	}
+	return ml_error("ArrayError", "Invalid array format");
+}
+
+static ml_array_t *ml_array_lazy_array(ml_array_lazy_t *Lazy, int Cache) {
+	if (Lazy->Op == ML_ARRAY_LAZY_VALUE && ml_is(Lazy->Value, MLArrayT)) return (ml_array_t *)Lazy->Value;
+	int Degree = Lazy->Degree;
+	ml_array_t *Array = ml_array_alloc(Lazy->Format, Degree);
+	int DataSize = MLArraySizes[Lazy->Format];
+	for (int I = Degree; --I >= 0;) {
+		Array->Dimensions[I].Stride = DataSize;
+		int Size = Array->Dimensions[I].Size = Lazy->Dimensions[I].Size;
+		DataSize *= Size;
+	}
+	Array->Base.Value = array_alloc(Lazy->Format, DataSize);
+	Array->Base.Length = DataSize;
+	ml_array_lazy_plan_t Plan[1] = {{0,}};
+	Plan->Target = Array->Base.Value;
+	ml_array_lazy_run(Plan, Lazy, ML_ARRAY_LAZY_STORE);
+	if (!Cache) return Array;
+	// The result replaces the expression so that later uses do not evaluate it again.
+	Lazy->Op = ML_ARRAY_LAZY_VALUE;
+	Lazy->Value = (ml_value_t *)Array;
+	Lazy->Left = Lazy->Right = NULL;
+	Lazy->Dimensions = Array->Dimensions;
+	return Array;
+}
+
+ML_METHOD("array", MLArrayLazyT) {
+//<Lazy
+//>array
+// Evaluates :mini:`Lazy` and returns the result as a new array.
+//$= let A := array::lazy(array([[1, 2], [3, 4]]))
+//$= ((A + 1) * A):array
+	ml_array_lazy_t *Lazy = (ml_array_lazy_t *)Args[0];
+	if (Lazy->Op == ML_ARRAY_LAZY_VALUE) {
+		ml_array_t *Source = (ml_array_t *)Lazy->Value;
+		ml_array_t *Target = ml_array_alloc(Source->Format, Source->Degree);
+		ml_array_copy(Target, Source);
+		return (ml_value_t *)Target;
+	}
+	return (ml_value_t *)ml_array_lazy_array(Lazy, 0);
+}
+
+ML_METHODV("[]", MLArrayLazyT) {
+//<Lazy
+//<Index/1
+//>array
+// Evaluates :mini:`Lazy` and returns :mini:`Lazy:array[Index/1, ...]`.
+	ml_array_t *Array = ml_array_lazy_array((ml_array_lazy_t *)Args[0], 1);
+	return ml_array_index(Array, Count - 1, Args + 1);
+}
+
+ML_METHOD("append", MLStringBufferT, MLArrayLazyT) {
+//<Buffer
+//<Lazy
+// Evaluates :mini:`Lazy` and appends the result to :mini:`Buffer`.
+	ml_stringbuffer_t *Buffer = (ml_stringbuffer_t *)Args[0];
+	ml_array_t *Array = ml_array_lazy_array((ml_array_lazy_t *)Args[1], 1);
+	return ml_stringbuffer_simple_append(Buffer, (ml_value_t *)Array);
+}
+
+ML_METHOD("degree", MLArrayLazyT) {
+//<Lazy
+//>integer
+// Returns the degree of :mini:`Lazy`.
+	ml_array_lazy_t *Lazy = (ml_array_lazy_t *)Args[0];
+	return ml_integer(Lazy->Degree);
+}
+
+ML_METHOD("shape", MLArrayLazyT) {
+//<Lazy
+//>list
+// Returns the shape of :mini:`Lazy`.
+	ml_array_lazy_t *Lazy = (ml_array_lazy_t *)Args[0];
+	ml_value_t *Shape = ml_list();
+	for (int I = 0; I < Lazy->Degree; ++I) {
+		ml_list_put(Shape, ml_integer(Lazy->Dimensions[I].Size));
+	}
+	return Shape;
+}
+
+ML_METHOD("sum", MLArrayLazyT) {
+//<Lazy
+//>number
+// Returns the sum of the values in :mini:`Lazy` without storing them.
+	ml_array_lazy_plan_t Plan[1] = {{0,}};
+	return ml_array_lazy_run(Plan, (ml_array_lazy_t *)Args[0], ML_ARRAY_LAZY_SUM);
+}
+
+ML_METHOD("prod", MLArrayLazyT) {
+//<Lazy
+//>number
+// Returns the product of the values in :mini:`Lazy` without storing them.
+	ml_array_lazy_plan_t Plan[1] = {{0,}};
+	return ml_array_lazy_run(Plan, (ml_array_lazy_t *)Args[0], ML_ARRAY_LAZY_PROD);
+}
+
+ML_METHOD("minval", MLArrayLazyT) {
+//<Lazy
+//>number
+// Returns the minimum of the values in :mini:`Lazy` without storing them.
+	ml_array_lazy_plan_t Plan[1] = {{0,}};
+	return ml_array_lazy_run(Plan, (ml_array_lazy_t *)Args[0], ML_ARRAY_LAZY_MINVAL);
+}
+
+ML_METHOD("maxval", MLArrayLazyT) {
+//<Lazy
+//>number
+// Returns the maximum of the values in :mini:`Lazy` without storing them.
+	ml_array_lazy_plan_t Plan[1] = {{0,}};
+	return ml_array_lazy_run(Plan, (ml_array_lazy_t *)Args[0], ML_ARRAY_LAZY_MAXVAL);
+}
+
+static void ml_array_lazy_define(const char *Name, ml_array_lazy_op_t Op) {
+	ml_method_by_name(Name, (void *)(intptr_t)Op, ml_array_lazy_infix, MLArrayLazyT, MLArrayLazyT, NULL);
+	ml_method_by_name(Name, (void *)(intptr_t)Op, ml_array_lazy_infix, MLArrayLazyT, MLArrayT, NULL);
+	ml_method_by_name(Name, (void *)(intptr_t)Op, ml_array_lazy_infix, MLArrayT, MLArrayLazyT, NULL);
+	ml_method_by_name(Name, (void *)(intptr_t)Op, ml_array_lazy_infix, MLArrayLazyT, MLNumberT, NULL);
+	ml_method_by_name(Name, (void *)(intptr_t)Op, ml_array_lazy_infix, MLNumberT, MLArrayLazyT, NULL);
+}
+
+#ifdef ML_THREADS
+
+#include "ml_thread.h"
+
+static ml_value_t *ML_TYPED_FN(ml_thread_move, MLArrayMutableT, ml_array_t *Source) {
+	if (Source->Format == ML_ARRAY_FORMAT_ANY) return ml_error("ThreadError", "%s is not safe to pass to another thread", Source->Base.Type->Name);
+	if (Source->View) return ml_error("ThreadError", "%s does not own its contents and cannot be moved to another thread", Source->Base.Type->Name);
+	int Degree = Source->Degree;
+	ml_array_t *Target = ml_array_alloc(Source->Format, Degree);
+	Target->Base.Value = Source->Base.Value;
+	Target->Base.Length = Source->Base.Length;
+	memcpy(Target->Dimensions, Source->Dimensions, Degree * sizeof(ml_array_dimension_t));
+	for (int I = 0; I < Degree; ++I) Source->Dimensions[I].Size = 0;
+	size_t Size = MLArraySizes[Source->Format];
+	Source->Base.Value = memset(snew(Size), 0, Size);
+	Source->Base.Length = 0;
+	return (ml_value_t *)Target;
+}
+
+#endif
+
 #ifdef ML_CBOR
 
 #include "ml_cbor.h"
 #include "minicbor/minicbor.h"
 
+// Typed arrays are written in host byte order, the opposite byte order is swapped when read.
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define ML_CBOR_TAG_NATIVE(TAG) TAG ## _BE
+#define ML_CBOR_TAG_SWAPPED(TAG) TAG ## _LE
+#else
+#define ML_CBOR_TAG_NATIVE(TAG) TAG ## _LE
+#define ML_CBOR_TAG_SWAPPED(TAG) TAG ## _BE
+#endif
+
 static void ml_cbor_write_array_typed(int Degree, size_t FlatSize, ml_array_dimension_t *Dimension, char *Address, ml_cbor_writer_t *Writer) {
 	if (Degree < 0) {
 		ml_cbor_write_raw(Writer, (unsigned char *)Address, FlatSize);
@@ -8728,16 +10151,16 @@ static void ml_cbor_write_array_any(int Degree, ml_array_dimension_t *Dimension,
 
 static void ML_TYPED_FN(ml_cbor_write, MLArrayT, ml_cbor_writer_t *Writer, ml_array_t *Array) {
 	static uint64_t Tags[] = {
-		[ML_ARRAY_FORMAT_U8] = 64,
-		[ML_ARRAY_FORMAT_I8] = 72,
-		[ML_ARRAY_FORMAT_U16] = 69,
-		[ML_ARRAY_FORMAT_I16] = 77,
-		[ML_ARRAY_FORMAT_U32] = 70,
-		[ML_ARRAY_FORMAT_I32] = 78,
-		[ML_ARRAY_FORMAT_U64] = 71,
-		[ML_ARRAY_FORMAT_I64] = 79,
-		[ML_ARRAY_FORMAT_F32] = 85,
-		[ML_ARRAY_FORMAT_F64] = 86
+		[ML_ARRAY_FORMAT_U8] = ML_CBOR_TAG_ARRAY_UINT8,
+		[ML_ARRAY_FORMAT_I8] = ML_CBOR_TAG_ARRAY_INT8,
+		[ML_ARRAY_FORMAT_U16] = ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_UINT16),
+		[ML_ARRAY_FORMAT_I16] = ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_INT16),
+		[ML_ARRAY_FORMAT_U32] = ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_UINT32),
+		[ML_ARRAY_FORMAT_I32] = ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_INT32),
+		[ML_ARRAY_FORMAT_U64] = ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_UINT64),
+		[ML_ARRAY_FORMAT_I64] = ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_INT64),
+		[ML_ARRAY_FORMAT_F32] = ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_FLOAT32),
+		[ML_ARRAY_FORMAT_F64] = ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_FLOAT64)
 	};
 	if (Array->Degree == -1) {
 		ml_cbor_write_simple(Writer, CBOR_SIMPLE_NULL);
@@ -8814,6 +10237,7 @@ static ml_value_t *ml_cbor_read_multi_array_fn(ml_cbor_reader_t *Reader, ml_valu
 	if (Stride != Source->Base.Length) return ml_error("CborError", "Invalid multi-dimensional array");
 	Target->Base.Length = Stride;
 	Target->Base.Value = Source->Base.Value;
+	Target->View = Source->View;
 	return (ml_value_t *)Target;
 }
 
@@ -8826,12 +10250,42 @@ static ml_value_t *ml_cbor_read_typed_array_fn(ml_value_t *Value, ml_array_forma
 	Array->Dimensions[0].Stride = ItemSize;
 	Array->Base.Length = Buffer->Length;
 	Array->Base.Value = Buffer->Value;
+	Array->View = 1;
+	return (ml_value_t *)Array;
+}
+
+static ml_value_t *ml_cbor_read_swapped_array_fn(ml_value_t *Value, ml_array_format_t Format) {
+	// The bytes are freshly decoded so they can be swapped in place.
+	ml_array_t *Array = (ml_array_t *)ml_cbor_read_typed_array_fn(Value, Format);
+	if (Array->Base.Type == MLErrorT) return (ml_value_t *)Array;
+	size_t Count = Array->Dimensions[0].Size;
+	switch (MLArraySizes[Format]) {
+	case 2: {
+		uint16_t *Values = (uint16_t *)Array->Base.Value;
+		for (size_t I = 0; I < Count; ++I) Values[I] = __builtin_bswap16(Values[I]);
+		break;
+	}
+	case 4: {
+		uint32_t *Values = (uint32_t *)Array->Base.Value;
+		for (size_t I = 0; I < Count; ++I) Values[I] = __builtin_bswap32(Values[I]);
+		break;
+	}
+	case 8: {
+		uint64_t *Values = (uint64_t *)Array->Base.Value;
+		for (size_t I = 0; I < Count; ++I) Values[I] = __builtin_bswap64(Values[I]);
+		break;
+	}
+	}
 	return (ml_value_t *)Array;
 }
 
 #define ML_CBOR_READ_TYPED_ARRAY(TYPE, FORMAT) \
 static ml_value_t *ml_cbor_read_ ## TYPE ## _array_fn(ml_cbor_reader_t *Reader, ml_value_t *Value, void *Data) { \
 	return ml_cbor_read_typed_array_fn(Value, ML_ARRAY_FORMAT_ ## FORMAT); \
+} \
+\
+static ml_value_t *ml_cbor_read_ ## TYPE ## _swapped_array_fn(ml_cbor_reader_t *Reader, ml_value_t *Value, void *Data) { \
+	return ml_cbor_read_swapped_array_fn(Value, ML_ARRAY_FORMAT_ ## FORMAT); \
 }
 
 ML_CBOR_READ_TYPED_ARRAY(uint8, U8)
@@ -8845,6 +10299,56 @@ ML_CBOR_READ_TYPED_ARRAY(int64, I64)
 ML_CBOR_READ_TYPED_ARRAY(float32, F32)
 ML_CBOR_READ_TYPED_ARRAY(float64, F64)
 
+static ml_value_t *ml_cbor_read_numbers_fn(int Real, size_t Count, void *Values) {
+	// Wraps the reader's buffer of int64_t or double values without copying.
+	ml_array_format_t Format = Real ? ML_ARRAY_FORMAT_F64 : ML_ARRAY_FORMAT_I64;
+	ml_array_t *Array = ml_array_alloc(Format, 1);
+	Array->Dimensions[0].Size = Count;
+	Array->Dimensions[0].Stride = MLArraySizes[Format];
+	Array->Base.Length = Count * MLArraySizes[Format];
+	Array->Base.Value = Values;
+	return (ml_value_t *)Array;
+}
+
+static ml_value_t *ml_cbor_read_vectors_fn(ml_value_t *List) {
+	// Stacks a list of equal length numeric vectors into a matrix.
+	ml_list_node_t *Node = ((ml_list_t *)List)->Head;
+	if (!Node || !ml_is(Node->Value, MLArrayT)) return NULL;
+	size_t Size = ((ml_array_t *)Node->Value)->Dimensions[0].Size;
+	ml_array_format_t Format = ML_ARRAY_FORMAT_I64;
+	ML_LIST_FOREACH(List, Iter) {
+		ml_array_t *Source = (ml_array_t *)Iter->Value;
+		if (!ml_is((ml_value_t *)Source, MLArrayT) || Source->Degree != 1) return NULL;
+		if (Source->Dimensions[0].Size != Size || Source->Dimensions[0].Indices) return NULL;
+		if (Source->Format == ML_ARRAY_FORMAT_F64) {
+			Format = ML_ARRAY_FORMAT_F64;
+		} else if (Source->Format != ML_ARRAY_FORMAT_I64) {
+			return NULL;
+		}
+		if (Source->Dimensions[0].Stride != MLArraySizes[Source->Format]) return NULL;
+	}
+	size_t Length = ml_list_length(List);
+	ml_array_t *Array = ml_array_alloc(Format, 2);
+	Array->Dimensions[1].Size = Size;
+	Array->Dimensions[1].Stride = MLArraySizes[Format];
+	Array->Dimensions[0].Size = Length;
+	Array->Dimensions[0].Stride = Size * MLArraySizes[Format];
+	Array->Base.Length = Length * Size * MLArraySizes[Format];
+	char *Target = Array->Base.Value = snew(Array->Base.Length);
+	ML_LIST_FOREACH(List, Iter) {
+		ml_array_t *Source = (ml_array_t *)Iter->Value;
+		if (Source->Format == Format) {
+			memcpy(Target, Source->Base.Value, Size * MLArraySizes[Format]);
+		} else {
+			const int64_t *Values = (const int64_t *)Source->Base.Value;
+			double *Reals = (double *)Target;
+			for (size_t I = 0; I < Size; ++I) Reals[I] = Values[I];
+		}
+		Target += Size * MLArraySizes[Format];
+	}
+	return (ml_value_t *)Array;
+}
+
 static ml_value_t *ml_cbor_read_any_array_fn(ml_cbor_reader_t *Reader, ml_value_t *Value, void *Data) {
 	if (!ml_is(Value, MLListT)) return ml_error("TagError", "Array requires list");
 	size_t Size = ml_list_length(Value);
@@ -8900,6 +10404,12 @@ void ml_array_init(stringmap_t *Globals) {
 	ml_method_by_name("**", MLArrayInfixMulFns, (ml_callback_t)ml_array_pairwise_infix, MLArrayT, MLArrayT, NULL);
 	ml_method_by_name("--", MLArrayInfixSubFns, (ml_callback_t)ml_array_pairwise_infix, MLArrayT, MLArrayT, NULL);
 	ml_method_by_name("//", MLArrayInfixDivFns, (ml_callback_t)ml_array_pairwise_infix, MLArrayT, MLArrayT, NULL);
+	ml_array_lazy_define("+", ML_ARRAY_LAZY_ADD);
+	ml_array_lazy_define("-", ML_ARRAY_LAZY_SUB);
+	ml_array_lazy_define("*", ML_ARRAY_LAZY_MUL);
+	ml_array_lazy_define("/", ML_ARRAY_LAZY_DIV);
+	ml_array_lazy_define("min", ML_ARRAY_LAZY_MIN);
+	ml_array_lazy_define("max", ML_ARRAY_LAZY_MAX);
 
 	ml_method_by_value(AbsMethod, labs, (ml_callback_t)array_math_integer_fn, MLArrayMutableIntegerT, NULL);
 	ml_method_by_value(SquareMethod, isquare, (ml_callback_t)array_math_integer_fn, MLArrayMutableIntegerT, NULL);
@@ -8961,10 +10471,15 @@ void ml_array_init(stringmap_t *Globals) {
 	ml_method_definev(ml_method("$"), MLArrayT->Constructor, 0, MLSliceT, NULL);
 	stringmap_insert(MLArrayT->Exports, "new", MLArrayNew);
 	stringmap_insert(MLArrayT->Exports, "wrap", MLArrayWrap);
+#ifdef ML_MMAP
+	stringmap_insert(MLArrayT->Exports, "mmap", MLArrayMMap);
+#endif
 	stringmap_insert(MLArrayT->Exports, "cat", MLArrayCat);
 	stringmap_insert(MLArrayT->Exports, "hcat", MLArrayHCat);
 	stringmap_insert(MLArrayT->Exports, "vcat", MLArrayVCat);
 	stringmap_insert(MLArrayT->Exports, "nil", MLArrayNil);
+	stringmap_insert(MLArrayT->Exports, "threads", MLArrayThreads);
+	stringmap_insert(MLArrayT->Exports, "lazy", MLArrayLazyT);
 	stringmap_insert(MLArrayT->Exports, "any", MLArrayAnyT);
 	stringmap_insert(MLArrayT->Exports, "uint8", MLArrayUInt8T);
 	stringmap_insert(MLArrayT->Exports, "int8", MLArrayInt8T);
@@ -9031,15 +10546,26 @@ void ml_array_init(stringmap_t *Globals) {
 	ml_cbor_default_tag(ML_CBOR_TAG_MULTI_ARRAY, ml_cbor_read_multi_array_fn);
 	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_ANY, ml_cbor_read_any_array_fn);
 	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_UINT8, ml_cbor_read_uint8_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_UINT8_CLAMPED, ml_cbor_read_uint8_array_fn);
 	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_INT8, ml_cbor_read_int8_array_fn);
-	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_UINT16_LE, ml_cbor_read_uint16_array_fn);
-	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_INT16_LE, ml_cbor_read_int16_array_fn);
-	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_UINT32_LE, ml_cbor_read_uint32_array_fn);
-	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_INT32_LE, ml_cbor_read_int32_array_fn);
-	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_UINT64_LE, ml_cbor_read_uint64_array_fn);
-	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_INT64_LE, ml_cbor_read_int64_array_fn);
-	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_FLOAT32_LE, ml_cbor_read_float32_array_fn);
-	ml_cbor_default_tag(ML_CBOR_TAG_ARRAY_FLOAT64_LE, ml_cbor_read_float64_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_UINT16), ml_cbor_read_uint16_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_INT16), ml_cbor_read_int16_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_UINT32), ml_cbor_read_uint32_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_INT32), ml_cbor_read_int32_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_UINT64), ml_cbor_read_uint64_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_INT64), ml_cbor_read_int64_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_FLOAT32), ml_cbor_read_float32_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_NATIVE(ML_CBOR_TAG_ARRAY_FLOAT64), ml_cbor_read_float64_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_SWAPPED(ML_CBOR_TAG_ARRAY_UINT16), ml_cbor_read_uint16_swapped_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_SWAPPED(ML_CBOR_TAG_ARRAY_INT16), ml_cbor_read_int16_swapped_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_SWAPPED(ML_CBOR_TAG_ARRAY_UINT32), ml_cbor_read_uint32_swapped_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_SWAPPED(ML_CBOR_TAG_ARRAY_INT32), ml_cbor_read_int32_swapped_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_SWAPPED(ML_CBOR_TAG_ARRAY_UINT64), ml_cbor_read_uint64_swapped_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_SWAPPED(ML_CBOR_TAG_ARRAY_INT64), ml_cbor_read_int64_swapped_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_SWAPPED(ML_CBOR_TAG_ARRAY_FLOAT32), ml_cbor_read_float32_swapped_array_fn);
+	ml_cbor_default_tag(ML_CBOR_TAG_SWAPPED(ML_CBOR_TAG_ARRAY_FLOAT64), ml_cbor_read_float64_swapped_array_fn);
+	ml_cbor_default_numbers(ml_cbor_read_numbers_fn);
+	ml_cbor_default_list(ml_cbor_read_vectors_fn);
 #ifdef ML_COMPLEX
 	ml_cbor_default_object("array::complex32", ml_cbor_read_complex32);
 	ml_cbor_default_object("array::complex64", ml_cbor_read_complex64);
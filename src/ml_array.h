@@ -1,6 +1,7 @@
 #ifndef ML_ARRAY_H
 #define ML_ARRAY_H
 
+#include <stddef.h>
 #include "minilang.h"
 
 #ifdef __cplusplus
@@ -27,12 +28,20 @@ typedef enum {
 
 #define MAX_FORMATS 16
 
+#if defined(__x86_64__) && defined(__linux__) && defined(__GNUC__) && !defined(__clang__)
+// Dense kernels are cloned for AVX2 (with and without FMA) / SSE2 and selected at load time.
+#define ML_ARRAY_KERNEL __attribute__ ((target_clones("arch=x86-64-v3", "avx2", "sse2", "default")))
+#else
+#define ML_ARRAY_KERNEL
+#endif
+
 extern size_t MLArraySizes[];
 
 typedef struct {
 	ml_address_t Base;
 	int Degree;
 	ml_array_format_t Format;
+	int View; // Non-zero if the data belongs to another value, e.g. a slice of another array.
 	ml_array_dimension_t Dimensions[];
 } ml_array_t;
 
@@ -61,9 +70,36 @@ static inline char *ml_array_data(ml_array_t *Array) {
 }
 static inline char *ml_array_step(char *Data, ml_array_dimension_t *Dimension, int Index) {
 	const int *Indices = Dimension->Indices;
-	return Data + (Indices ? Indices[Index] : Index) * Dimension->Stride;
+	return Data + (ptrdiff_t)(Indices ? Indices[Index] : Index) * Dimension->Stride;
 }
 
+typedef enum {
+	ML_ARRAY_GEMM_SUB = -1,
+	ML_ARRAY_GEMM_SET = 0,
+	ML_ARRAY_GEMM_ADD = 1
+} ml_array_gemm_mode_t;
+
+// Sets, adds or subtracts the M x N product of an M x K and a K x N matrix.
+// Each operand is given as an array of row pointers and a column stride in bytes, rows of C must be contiguous.
+void ml_array_gemm_float(int M, int N, int K, char **RowsA, int StrideA, char **RowsB, int StrideB, char **RowsC, ml_array_gemm_mode_t Mode);
+void ml_array_gemm_double(int M, int N, int K, char **RowsA, int StrideA, char **RowsB, int StrideB, char **RowsC, ml_array_gemm_mode_t Mode);
+#ifdef ML_COMPLEX
+void ml_array_gemm_complex_float(int M, int N, int K, char **RowsA, int StrideA, char **RowsB, int StrideB, char **RowsC, ml_array_gemm_mode_t Mode);
+void ml_array_gemm_complex_double(int M, int N, int K, char **RowsA, int StrideA, char **RowsB, int StrideB, char **RowsC, ml_array_gemm_mode_t Mode);
+#endif
+
+// Calls Fn(Data, Index) once for each Index in [0, Count), sharing the calls between the array thread pool and the caller.
+// Nested and concurrent calls run serially in the calling thread.
+typedef void (*ml_array_parallel_fn)(void *Data, int Index);
+void ml_array_parallel(int Count, ml_array_parallel_fn Fn, void *Data);
+
+// Number of threads used by ml_array_parallel, initially taken from MINILANG_ARRAY_THREADS or the number of processors.
+int ml_array_threads(void);
+void ml_array_threads_set(int Threads);
+
+// Minimum number of elements per parallel chunk, chunk boundaries depend only on this and the array size.
+extern int MLArrayParallelGrain;
+
 size_t ml_array_data_size(ml_array_t *Source);
 void ml_array_copy_data(ml_array_t *Source, char *Data);
 char *ml_array_flatten(ml_array_t *Source);
@@ -77,9 +113,9 @@ int ml_array_copy(ml_array_t *Target, ml_array_t *Source);
 	for (int I = 0; I < (sizeof(Indices) / sizeof(int)); ++I) { \
 		int Index = Indices[I];  \
 		if (Dimension->Indices) { \
-			Address += Dimension->Stride * Dimension->Indices[Index]; \
+			Address += (ptrdiff_t)Dimension->Stride * Dimension->Indices[Index]; \
 		} else { \
-			Address += Dimension->Stride * Index; \
+			Address += (ptrdiff_t)Dimension->Stride * Index; \
 		} \
 		++Dimension; \
 	} \
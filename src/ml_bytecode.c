@@ -151,6 +151,9 @@ struct DEBUG_STRUCT(frame) {
 	unsigned int Reentry:1;
 	unsigned int Suspend:1;
 	unsigned int Reuse:1;
+#ifdef ML_BYTECODE_PROFILE
+	unsigned int Previous:8;
+#endif
 #ifdef DEBUG_VERSION
 	unsigned int StepOver:1;
 	unsigned int StepOut:1;
@@ -253,6 +256,25 @@ static void ML_TYPED_FN(ml_iterate, DEBUG_TYPE(Continuation), ml_state_t *Caller
 #define CHECK_COUNTER_GOTO CHECK_COUNTER
 #endif
 
+#ifdef ML_BYTECODE_PROFILE
+
+static uint64_t MLBytecodeBigrams[ML_OPCODE_COUNT][ML_OPCODE_COUNT];
+
+#define PROFILE_PAIR(NEXT) ++MLBytecodeBigrams[Inst->Opcode][(NEXT)->Opcode];
+#define PROFILE_STORE() Frame->Previous = Inst->Opcode + 1
+#define PROFILE_RESUME() if (Frame->Previous) { \
+	++MLBytecodeBigrams[Frame->Previous - 1][Inst->Opcode]; \
+	Frame->Previous = 0; \
+}
+
+#else
+
+#define PROFILE_PAIR(NEXT)
+#define PROFILE_STORE()
+#define PROFILE_RESUME()
+
+#endif
+
 #define ERROR() { \
 	Inst = Frame->OnError; \
 	CHECK_COUNTER \
@@ -260,17 +282,24 @@ static void ML_TYPED_FN(ml_iterate, DEBUG_TYPE(Continuation), ml_state_t *Caller
 }
 
 #define ADVANCE(NEXT) { \
+	PROFILE_PAIR(NEXT) \
 	Inst = NEXT; \
 	CHECK_COUNTER \
 	goto *Labels[Inst->Opcode]; \
 }
 
 #define ADVANCE_GOTO(NEXT) { \
+	PROFILE_PAIR(NEXT) \
 	Inst = NEXT; \
 	CHECK_COUNTER_GOTO \
 	goto *Labels[Inst->Opcode]; \
 }
 
+#define ADVANCE_FUSED(NEXT, LABEL) { \
+	Inst = NEXT; \
+	goto LABEL; \
+}
+
 #define ERROR_CHECK(VALUE) if (ml_is_error(VALUE)) { \
 	ml_error_trace_add(VALUE, (ml_source_t){Frame->Source, Inst->Line}); \
 	Result = VALUE; \
@@ -283,6 +312,7 @@ static void ML_TYPED_FN(ml_iterate, DEBUG_TYPE(Continuation), ml_state_t *Caller
 
 #undef ERROR
 #undef ADVANCE
+#undef ADVANCE_FUSED
 #undef FRAME_DECLS
 
 #define ERROR() { \
@@ -297,6 +327,8 @@ static void ML_TYPED_FN(ml_iterate, DEBUG_TYPE(Continuation), ml_state_t *Caller
 	goto DO_DEBUG_ADVANCE; \
 }
 
+#define ADVANCE_FUSED(NEXT, LABEL) ADVANCE(NEXT)
+
 #define FRAME_DECLS(DECLS) Frame->Decls = DECLS;
 
 #endif
@@ -368,16 +400,98 @@ extern ml_value_t *SymbolMethod;
 
 #ifdef ML_SCHEDULER
 #ifdef ML_TIMESCHED
-#define ML_STORE_COUNTER() {}
+#define ML_STORE_COUNTER() PROFILE_STORE()
 #else
-#define ML_STORE_COUNTER() Frame->Counter[0] = Counter
+#define ML_STORE_COUNTER() CounterSlot[0] = Counter; PROFILE_STORE()
 #endif
 #else
-#define ML_STORE_COUNTER() {}
+#define ML_STORE_COUNTER() PROFILE_STORE()
 #endif
 
 static ml_inst_t ReturnInst[1] = {{.Opcode = MLI_RETURN, .Line = 0}};
 
+typedef enum {
+	ML_INLINE_ADD, ML_INLINE_SUB, ML_INLINE_MUL,
+	ML_INLINE_EQ, ML_INLINE_NEQ, ML_INLINE_LT, ML_INLINE_GT, ML_INLINE_LTE, ML_INLINE_GTE,
+	ML_INLINE_COUNT
+} ml_inline_op_t;
+
+static const char *MLInlineNames[ML_INLINE_COUNT] = {"+", "-", "*", "=", "!=", "<", ">", "<=", ">="};
+static ml_method_t *MLInlineMethods[ML_INLINE_COUNT];
+// Builtin number methods as defined at startup, a call site only takes the
+// inline path if its method resolves to the same function (i.e. not redefined).
+static ml_value_t *MLInlineIntegers[ML_INLINE_COUNT];
+static ml_value_t *MLInlineDoubles[ML_INLINE_COUNT];
+
+static void ml_inline_init() {
+	ml_methods_t *Methods = ml_context_get_static(MLRootContext, ML_METHODS_INDEX);
+	ml_value_t *Integers[2] = {ml_integer(1), ml_integer(1)};
+	ml_value_t *Doubles[2] = {ml_real(1), ml_real(1)};
+	for (int I = 0; I < ML_INLINE_COUNT; ++I) {
+		ml_method_t *Method = MLInlineMethods[I] = (ml_method_t *)ml_method(MLInlineNames[I]);
+		MLInlineIntegers[I] = ml_method_search(Methods, Method, 2, Integers);
+		MLInlineDoubles[I] = ml_method_search(Methods, Method, 2, Doubles);
+	}
+}
+
+#define ML_INLINE_COMPARE(OP, A, B, RESULT) \
+	switch (OP) { \
+	case ML_INLINE_EQ: return A == B ? RESULT : MLNil; \
+	case ML_INLINE_NEQ: return A != B ? RESULT : MLNil; \
+	case ML_INLINE_LT: return A < B ? RESULT : MLNil; \
+	case ML_INLINE_GT: return A > B ? RESULT : MLNil; \
+	case ML_INLINE_LTE: return A <= B ? RESULT : MLNil; \
+	case ML_INLINE_GTE: return A >= B ? RESULT : MLNil; \
+	default: return NULL; \
+	}
+
+static inline ml_value_t *ml_inline_number(ml_method_t *Method, ml_value_t *Function, ml_value_t **Args) {
+	// Computes A op B for builtin arithmetic and comparison methods on small
+	// integers and doubles without calling Function, returns NULL to fall back.
+	ml_value_t *A = ml_deref(Args[0]), *B = ml_deref(Args[1]);
+#ifdef ML_NANBOXING
+	int Integers = ml_tag(A) == 1 && ml_tag(B) == 1;
+	int Doubles = ml_tag(A) >= 7 && ml_tag(B) >= 7;
+#else
+	int Integers = ml_typeof(A) == MLInteger64T && ml_typeof(B) == MLInteger64T;
+	int Doubles = ml_typeof(A) == MLDoubleT && ml_typeof(B) == MLDoubleT;
+#endif
+	if (!Integers && !Doubles) return NULL;
+	int Op = 0;
+	while (MLInlineMethods[Op] != Method) if (++Op == ML_INLINE_COUNT) return NULL;
+	if (Integers) {
+		if (Function != MLInlineIntegers[Op]) return NULL;
+#ifdef ML_NANBOXING
+		int64_t IntegerA = ml_integer32_value(A), IntegerB = ml_integer32_value(B);
+		switch (Op) {
+		case ML_INLINE_ADD: return ml_integer(IntegerA + IntegerB);
+		case ML_INLINE_SUB: return ml_integer(IntegerA - IntegerB);
+		case ML_INLINE_MUL: return ml_integer(IntegerA * IntegerB);
+		}
+#else
+#ifdef ML_BIGINT
+		return NULL;
+#endif
+		int64_t IntegerA = ml_integer64_value(A), IntegerB = ml_integer64_value(B), Integer;
+		switch (Op) {
+		case ML_INLINE_ADD: return __builtin_add_overflow(IntegerA, IntegerB, &Integer) ? NULL : ml_integer(Integer);
+		case ML_INLINE_SUB: return __builtin_sub_overflow(IntegerA, IntegerB, &Integer) ? NULL : ml_integer(Integer);
+		case ML_INLINE_MUL: return __builtin_mul_overflow(IntegerA, IntegerB, &Integer) ? NULL : ml_integer(Integer);
+		}
+#endif
+		ML_INLINE_COMPARE(Op, IntegerA, IntegerB, B);
+	} else {
+		if (Function != MLInlineDoubles[Op]) return NULL;
+		double RealA = ml_double_value(A), RealB = ml_double_value(B);
+		switch (Op) {
+		case ML_INLINE_ADD: return ml_real(RealA + RealB);
+		case ML_INLINE_SUB: return ml_real(RealA - RealB);
+		case ML_INLINE_MUL: return ml_real(RealA * RealB);
+		}
+		ML_INLINE_COMPARE(Op, RealA, RealB, B);
+	}
+}
+
 #define TAIL_CALL(COUNT) \
 	ml_state_t *Caller = Frame->Base.Caller; \
 	ml_value_t **Args2 = ml_alloc_args(COUNT); \
@@ -425,8 +539,8 @@ static ml_inst_t ReturnInst[1] = {{.Opcode = MLI_RETURN, .Line = 0}};
 		ml_value_t **Args = Top - COUNT; \
 		ml_method_t *Method = (ml_method_t *)Inst[1].Value; \
 		ml_methods_t *Methods = ml_context_get_static(Frame->Base.Context, ML_METHODS_INDEX); \
-		ml_method_cached_t *Cached = ml_method_check_cached(Methods, Method, Inst[3].Data, COUNT, Args); \
-		if (!Cached) { \
+		ml_value_t *Function = ml_method_inline_search(Methods, Method, (ml_method_inline_cache_t **)&Inst[3].Data, COUNT, Args); \
+		if (!Function) { \
 			ml_value_t **Args2 = ml_alloc_args(COUNT + 1); \
 			Args2[0] = (ml_value_t *)Method; \
 			memcpy(Args2 + 1, Args, (COUNT) * sizeof(ml_value_t *)); \
@@ -437,8 +551,14 @@ static ml_inst_t ReturnInst[1] = {{.Opcode = MLI_RETURN, .Line = 0}};
 			Frame->Top = Args; \
 			return ml_call(Frame, MLMethodDefault, COUNT + 1, Args2); \
 		} \
-		Inst[3].Data = Cached; \
-		ml_value_t *Function = Cached->Callback; \
+		if (COUNT == 2) { \
+			ml_value_t *Value = ml_inline_number(Method, Function, Args); \
+			if (Value) { \
+				Result = Value; \
+				while (Top > Args) *--Top = NULL; \
+				ADVANCE(Inst + 4); \
+			} \
+		} \
 		ml_inst_t *Next = Inst + 4; \
 		ML_STORE_COUNTER(); \
 		Frame->Inst = Next; \
@@ -450,8 +570,8 @@ static ml_inst_t ReturnInst[1] = {{.Opcode = MLI_RETURN, .Line = 0}};
 		ml_value_t **Args = Top - COUNT; \
 		ml_method_t *Method = (ml_method_t *)Inst[1].Value; \
 		ml_methods_t *Methods = ml_context_get_static(Frame->Base.Context, ML_METHODS_INDEX); \
-		ml_method_cached_t *Cached = ml_method_check_cached(Methods, Method, Inst[3].Data, COUNT, Args); \
-		if (!Cached) { \
+		ml_value_t *Function = ml_method_inline_search(Methods, Method, (ml_method_inline_cache_t **)&Inst[3].Data, COUNT, Args); \
+		if (!Function) { \
 			ml_value_t **Args2 = ml_alloc_args(COUNT + 1); \
 			Args2[0] = (ml_value_t *)Method; \
 			memcpy(Args2 + 1, Args, (COUNT) * sizeof(ml_value_t *)); \
@@ -462,8 +582,14 @@ static ml_inst_t ReturnInst[1] = {{.Opcode = MLI_RETURN, .Line = 0}};
 			Frame->Top = Args; \
 			return ml_call(Frame, MLMethodDefault, COUNT + 1, Args2); \
 		} \
-		Inst[3].Data = Cached; \
-		ml_value_t *Function = Cached->Callback; \
+		if (COUNT == 2) { \
+			ml_value_t *Value = ml_inline_number(Method, Function, Args); \
+			if (Value) { \
+				Result = Value; \
+				while (Top > Args) *--Top = NULL; \
+				goto DO_RETURN; \
+			} \
+		} \
 		ML_STORE_COUNTER(); \
 		TAIL_CALL(COUNT); \
 	}
@@ -515,10 +641,14 @@ static void DEBUG_FUNC(frame_run)(ml_state_t *State, ml_value_t *Result) {
 		[MLI_LIST_NEW] = &&DO_LIST_NEW,
 		[MLI_LOAD] = &&DO_LOAD,
 		[MLI_LOAD_PUSH] = &&DO_LOAD_PUSH,
+		[MLI_LOAD_PUSH_CALL_METHOD] = &&DO_LOAD_PUSH_CALL_METHOD,
 		[MLI_LOAD_VAR] = &&DO_LOAD_VAR,
 		[MLI_LOCAL] = &&DO_LOCAL,
 		[MLI_LOCALI] = &&DO_LOCALI,
 		[MLI_LOCAL_PUSH] = &&DO_LOCAL_PUSH,
+		[MLI_LOCAL_PUSH_CALL_METHOD] = &&DO_LOCAL_PUSH_CALL_METHOD,
+		[MLI_LOCAL_PUSH_LOAD_PUSH] = &&DO_LOCAL_PUSH_LOAD_PUSH,
+		[MLI_LOCAL_PUSH_LOCAL_PUSH] = &&DO_LOCAL_PUSH_LOCAL_PUSH,
 		[MLI_MAP_INSERT] = &&DO_MAP_INSERT,
 		[MLI_MAP_NEW] = &&DO_MAP_NEW,
 		[MLI_CALL_METHOD] = &&DO_CALL_METHOD,
@@ -534,6 +664,10 @@ static void DEBUG_FUNC(frame_run)(ml_state_t *State, ml_value_t *Result) {
 		[MLI_PARTIAL_SET] = &&DO_PARTIAL_SET,
 		[MLI_POP] = &&DO_POP,
 		[MLI_PUSH] = &&DO_PUSH,
+		[MLI_PUSH_CALL] = &&DO_PUSH_CALL,
+		[MLI_PUSH_CALL_METHOD] = &&DO_PUSH_CALL_METHOD,
+		[MLI_PUSH_LOCAL_PUSH] = &&DO_PUSH_LOCAL_PUSH,
+		[MLI_PUSH_TAIL_CALL_METHOD] = &&DO_PUSH_TAIL_CALL_METHOD,
 		[MLI_REF] = &&DO_REF,
 		[MLI_REFI] = &&DO_REFI,
 		[MLI_REFX] = &&DO_REFX,
@@ -552,6 +686,7 @@ static void DEBUG_FUNC(frame_run)(ml_state_t *State, ml_value_t *Result) {
 		[MLI_TRY] = &&DO_TRY,
 		[MLI_TUPLE_NEW] = &&DO_TUPLE_NEW,
 		[MLI_UPVALUE] = &&DO_UPVALUE,
+		[MLI_UPVALUE_PUSH] = &&DO_UPVALUE_PUSH,
 		[MLI_VALUE_1] = &&DO_VALUE_1,
 		[MLI_VALUE_2] = &&DO_VALUE_2,
 		[MLI_VAR] = &&DO_VAR,
@@ -559,6 +694,7 @@ static void DEBUG_FUNC(frame_run)(ml_state_t *State, ml_value_t *Result) {
 		[MLI_VARX] = &&DO_VARX,
 		[MLI_WITH] = &&DO_WITH,
 		[MLI_WITHX] = &&DO_WITHX,
+		[MLI_WITH_LOCAL_PUSH] = &&DO_WITH_LOCAL_PUSH,
 	};
 	CALL_LABELS(CALL);
 	CALL_LABELS(TAIL_CALL);
@@ -568,18 +704,24 @@ static void DEBUG_FUNC(frame_run)(ml_state_t *State, ml_value_t *Result) {
 	CALL_LABELS(TAIL_CALL_METHOD);
 #ifdef ML_SCHEDULER
 #ifndef ML_TIMESCHED
-	uint64_t Counter = Frame->Counter[0];
+#ifdef ML_HOSTTHREADS
+	uint64_t *CounterSlot = Frame->Counter ?: &MLWorkerCounter;
+#else
+	uint64_t *CounterSlot = Frame->Counter;
+#endif
+	uint64_t Counter = CounterSlot[0];
 #endif
 #endif
 	ml_inst_t *Inst = Frame->Inst;
 	ml_value_t **Top = Frame->Top;
 #ifdef DEBUG_VERSION
 	int Line = Frame->Line;
+#endif
 	if (Frame->Reentry) {
+		// Resuming after a breakpoint or a swap, Result may still hold the error being handled.
 		Frame->Reentry = 0;
 		goto *Labels[Inst->Opcode];
 	}
-#endif
 	if (ml_is_error(Result)) {
 		ml_error_trace_add(Result, (ml_source_t){Frame->Source, Frame->Line});
 		ERROR();
@@ -587,6 +729,7 @@ static void DEBUG_FUNC(frame_run)(ml_state_t *State, ml_value_t *Result) {
 #ifdef DEBUG_VERSION
 	goto DO_DEBUG_ADVANCE;
 #else
+	PROFILE_RESUME();
 	CHECK_COUNTER
 	goto *Labels[Inst->Opcode];
 #endif
@@ -645,11 +788,32 @@ static void DEBUG_FUNC(frame_run)(ml_state_t *State, ml_value_t *Result) {
 		*Top++ = Result;
 		ADVANCE(Inst + 1);
 	}
+	DO_PUSH_CALL: {
+		*Top++ = Result;
+		ADVANCE_FUSED(Inst + 1, DO_CALL);
+	}
+	DO_PUSH_CALL_METHOD: {
+		*Top++ = Result;
+		ADVANCE_FUSED(Inst + 1, DO_CALL_METHOD);
+	}
+	DO_PUSH_LOCAL_PUSH: {
+		*Top++ = Result;
+		ADVANCE_FUSED(Inst + 1, DO_LOCAL_PUSH);
+	}
+	DO_PUSH_TAIL_CALL_METHOD: {
+		*Top++ = Result;
+		ADVANCE_FUSED(Inst + 1, DO_TAIL_CALL_METHOD);
+	}
 	DO_WITH: {
 		*Top++ = Result;
 		FRAME_DECLS(Inst[1].Decls);
 		ADVANCE(Inst + 2);
 	}
+	DO_WITH_LOCAL_PUSH: {
+		*Top++ = Result;
+		FRAME_DECLS(Inst[1].Decls);
+		ADVANCE_FUSED(Inst + 2, DO_LOCAL_PUSH);
+	}
 	DO_WITHX: {
 		ml_value_t *Packed = Result;
 		int Count = Inst[1].Count;
@@ -739,6 +903,10 @@ static void DEBUG_FUNC(frame_run)(ml_state_t *State, ml_value_t *Result) {
 		Result = *Top++ = Inst[1].Value;
 		ADVANCE(Inst + 2);
 	}
+	DO_LOAD_PUSH_CALL_METHOD: {
+		Result = *Top++ = Inst[1].Value;
+		ADVANCE_FUSED(Inst + 2, DO_CALL_METHOD);
+	}
 	DO_LOAD_VAR: {
 		Result = ml_deref(Inst[1].Value);
 		ml_variable_t *Variable = (ml_variable_t *)Top[Inst[2].Count];
@@ -966,11 +1134,31 @@ static void DEBUG_FUNC(frame_run)(ml_state_t *State, ml_value_t *Result) {
 		++Top;
 		ADVANCE(Inst + 2);
 	}
+	DO_LOCAL_PUSH_CALL_METHOD: {
+		Result = *Top = Top[Inst[1].Count];
+		++Top;
+		ADVANCE_FUSED(Inst + 2, DO_CALL_METHOD);
+	}
+	DO_LOCAL_PUSH_LOAD_PUSH: {
+		Result = *Top = Top[Inst[1].Count];
+		++Top;
+		ADVANCE_FUSED(Inst + 2, DO_LOAD_PUSH);
+	}
+	DO_LOCAL_PUSH_LOCAL_PUSH: {
+		Result = *Top = Top[Inst[1].Count];
+		++Top;
+		ADVANCE_FUSED(Inst + 2, DO_LOCAL_PUSH);
+	}
 	DO_UPVALUE: {
 		int Index = Inst[1].Count + 1;
 		Result = Frame->UpValues[Index];
 		ADVANCE(Inst + 2);
 	}
+	DO_UPVALUE_PUSH: {
+		int Index = Inst[1].Count + 1;
+		Result = Frame->UpValues[Index];
+		ADVANCE_FUSED(Inst + 2, DO_PUSH);
+	}
 	DO_LOCALI: {
 		ml_value_t **Slot = &Top[Inst[1].Count];
 		Result = Slot[0];
@@ -1197,6 +1385,7 @@ static void DEBUG_FUNC(frame_run)(ml_state_t *State, ml_value_t *Result) {
 		Frame->Line = Inst->Line;
 		Frame->Inst = Inst;
 		Frame->Top = Top;
+		Frame->Reentry = 1;
 		ml_state_schedule((ml_state_t *)Frame, Result);
 	}
 #endif
@@ -1222,6 +1411,9 @@ static void DEBUG_FUNC(closure_call)(ml_state_t *Caller, ml_closure_t *Closure,
 	Frame->Base.run = (void *)DEBUG_FUNC(frame_run);
 	Frame->Base.Context = Caller->Context;
 	Frame->Source = Info->Source;
+#ifdef ML_BYTECODE_PROFILE
+	Frame->Previous = 0;
+#endif
 	int NumParams = Info->NumParams;
 	int Flags = Info->Flags;
 	if (Flags & ML_CLOSURE_EXTRA_ARGS) --NumParams;
@@ -1401,9 +1593,65 @@ void ml_closure_info_labels(ml_closure_info_t *Info) {
 	}
 }
 
+static int ml_inst_size(ml_inst_t *Inst) {
+	switch (MLInstTypes[Inst->Opcode]) {
+	case MLIT_NONE: return 1;
+	case MLIT_INST: return 2;
+	case MLIT_INST_CONFIG: return 3;
+	case MLIT_INST_COUNT: return 3;
+	case MLIT_INST_COUNT_DECL: return 4;
+	case MLIT_COUNT_COUNT: return 3;
+	case MLIT_COUNT: return 2;
+	case MLIT_VALUE: return 2;
+	case MLIT_VALUE_COUNT: return 3;
+	case MLIT_VALUE_COUNT_DATA: return 4;
+	case MLIT_COUNT_CHARS: return 3;
+	case MLIT_DECL: return 2;
+	case MLIT_COUNT_DECL: return 3;
+	case MLIT_COUNT_COUNT_DECL: return 4;
+	case MLIT_CLOSURE: return 2 + Inst[1].ClosureInfo->NumUpValues;
+	case MLIT_SWITCH: return 3;
+	}
+	return 0;
+}
+
+static ml_opcode_t ml_inst_fusion(ml_opcode_t First, ml_opcode_t Second) {
+	for (ml_opcode_t Opcode = 0; Opcode < ML_OPCODE_COUNT; ++Opcode) {
+		if (MLInstFusions[Opcode][0] == First && MLInstFusions[Opcode][1] == Second) {
+			if (Opcode != First) return Opcode;
+		}
+	}
+	return First;
+}
+
+void ml_closure_info_fuse(ml_closure_info_t *Info) {
+	if (Info->Flags & ML_CLOSURE_FUSED) return;
+	Info->Flags |= ML_CLOSURE_FUSED;
+	ml_closure_info_labels(Info);
+	for (ml_inst_t *Inst = Info->Entry; Inst != Info->Halt;) {
+		if (Inst->Opcode == MLI_LINK) {
+			Inst = Inst[1].Inst;
+			continue;
+		}
+		ml_inst_t *Next = Inst + ml_inst_size(Inst);
+		// The second instruction is left in place, so it must not be a jump
+		// target or the fused handler would run the first one twice.
+		if (Next != Info->Halt && !Next->Label) {
+			ml_opcode_t Opcode = ml_inst_fusion(Inst->Opcode, Next->Opcode);
+			if (Opcode != Inst->Opcode) {
+				Inst->Opcode = Opcode;
+				Inst = Next + ml_inst_size(Next);
+				continue;
+			}
+		}
+		Inst = Next;
+	}
+}
+
 static int ml_inst_hash(ml_inst_t *Inst, ml_closure_info_t *Info, int I, int J) {
-	Info->Hash[I] ^= Inst->Opcode;
-	Info->Hash[J] ^= (Inst->Opcode << 4);
+	ml_opcode_t Opcode = MLInstFusions[Inst->Opcode][0];
+	Info->Hash[I] ^= Opcode;
+	Info->Hash[J] ^= (Opcode << 4);
 	switch (MLInstTypes[Inst->Opcode]) {
 	case MLIT_NONE: return 1;
 	case MLIT_INST:
@@ -2122,7 +2370,7 @@ static void ML_TYPED_FN(ml_cbor_write, MLClosureInfoT, ml_cbor_writer_t *Writer,
 			vlq64_encode(Buffer, Inst->Line - Line);
 			Line = Inst->Line;
 		}
-		vlq64_encode(Buffer, Inst->Opcode);
+		vlq64_encode(Buffer, MLInstFusions[Inst->Opcode][0]);
 		switch (MLInstTypes[Inst->Opcode]) {
 		case MLIT_NONE:
 			Inst += 1;
@@ -2893,8 +3141,54 @@ static ml_value_t *decode_frame(ml_cbor_reader_t *Reader, int Count, ml_value_t
 #include "ml_bytecode.c"
 #undef DEBUG_VERSION
 
+#ifdef ML_BYTECODE_PROFILE
+
+typedef struct {
+	uint64_t Count;
+	ml_opcode_t First, Second;
+} ml_bigram_t;
+
+static int ml_bigram_compare(const ml_bigram_t *A, const ml_bigram_t *B) {
+	if (A->Count > B->Count) return -1;
+	if (A->Count < B->Count) return 1;
+	return 0;
+}
+
+ML_FUNCTION(MLBytecodeProfile) {
+//@function::profile
+//<Reset?:boolean
+//>list[tuple[string,string,integer]]
+// Returns the opcode pairs executed by the interpreter so far as :mini:`(First, Second, Count)` tuples, most frequent first. If :mini:`Reset` is :mini:`true`, the counts are cleared afterwards.
+// Only available when built with :c:`ML_BYTECODE_PROFILE`.
+	ml_bigram_t *Bigrams = anew(ml_bigram_t, ML_OPCODE_COUNT * ML_OPCODE_COUNT);
+	int Length = 0;
+	for (int I = 0; I < ML_OPCODE_COUNT; ++I) {
+		for (int J = 0; J < ML_OPCODE_COUNT; ++J) {
+			uint64_t Count = MLBytecodeBigrams[I][J];
+			if (Count) Bigrams[Length++] = (ml_bigram_t){Count, I, J};
+		}
+	}
+	qsort(Bigrams, Length, sizeof(ml_bigram_t), (void *)ml_bigram_compare);
+	ml_value_t *Result = ml_list();
+	for (int I = 0; I < Length; ++I) {
+		ml_list_put(Result, ml_tuplev(3,
+			ml_string(MLInstNames[Bigrams[I].First], -1),
+			ml_string(MLInstNames[Bigrams[I].Second], -1),
+			ml_integer(Bigrams[I].Count)
+		));
+	}
+	if (Count > 0 && Args[0] == (ml_value_t *)MLTrue) memset(MLBytecodeBigrams, 0, sizeof(MLBytecodeBigrams));
+	return Result;
+}
+
+#endif
+
 void ml_bytecode_init() {
 	ml_cache_register("Frame", ml_frame_cache_usage, ml_frame_cache_clear, NULL);
+	ml_inline_init();
+#ifdef ML_BYTECODE_PROFILE
+	stringmap_insert(MLFunctionT->Exports, "profile", MLBytecodeProfile);
+#endif
 #ifdef ML_GENERICS
 	ml_type_add_rule(MLClosureT, MLFunctionT, ML_TYPE_ARG(1), NULL);
 #endif
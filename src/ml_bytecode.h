@@ -40,6 +40,7 @@ union ml_inst_t {
 #define ML_CLOSURE_RESERVED 4
 #define ML_CLOSURE_LABELLED 8
 #define ML_CLOSURE_HASHED 16
+#define ML_CLOSURE_FUSED 32
 
 struct ml_closure_info_t {
 	ml_type_t *Type;
@@ -88,6 +89,7 @@ ml_value_t *ml_variable_set(ml_value_t *Variable, ml_value_t *Value);
 extern ml_type_t MLVariableT[];
 
 void ml_closure_info_labels(ml_closure_info_t *Info);
+void ml_closure_info_fuse(ml_closure_info_t *Info);
 //void ml_closure_info_list(ml_stringbuffer_t *Buffer, ml_closure_info_t *Info, int Indent);
 
 
@@ -107,6 +107,26 @@ ml_cbor_tag_fns_t *ml_cbor_tag_fns(int Default) {
 	}
 }
 
+static ml_cbor_numbers_fn DefaultNumbersFn = NULL;
+
+void ml_cbor_default_numbers(ml_cbor_numbers_fn Fn) {
+	DefaultNumbersFn = Fn;
+}
+
+#define ML_CBOR_MAX_LIST_FNS 4
+
+static ml_cbor_list_fn DefaultListFns[ML_CBOR_MAX_LIST_FNS];
+static int NumDefaultListFns = 0;
+
+void ml_cbor_default_list(ml_cbor_list_fn Fn) {
+	if (NumDefaultListFns < ML_CBOR_MAX_LIST_FNS) DefaultListFns[NumDefaultListFns++] = Fn;
+}
+
+typedef union {
+	int64_t Integer;
+	double Real;
+} ml_cbor_number_t;
+
 typedef struct ml_cbor_reader_collection_t ml_cbor_reader_collection_t;
 
 struct ml_cbor_reader_collection_t {
@@ -114,7 +134,10 @@ struct ml_cbor_reader_collection_t {
 	struct ml_cbor_reader_tag_t *Tags;
 	ml_value_t *Key;
 	ml_value_t *Collection;
+	ml_cbor_number_t *Numbers;
+	size_t Count, Space;
 	int Remaining;
+	int Typed, Real;
 };
 
 typedef struct ml_cbor_reader_tag_t ml_cbor_reader_tag_t;
@@ -137,6 +160,7 @@ struct ml_cbor_reader_t {
 	minicbor_stream_t Stream[1];
 	ml_stringbuffer_t Buffer[1];
 	int NumReused, MaxReused;
+	int Flags;
 	int NumSettings;
 	void *Settings[];
 };
@@ -190,6 +214,10 @@ void ml_cbor_reader_set_classtable(ml_cbor_reader_t *Reader, ml_class_table_t *C
 	Reader->ClassTable = ClassTable;
 }
 
+void ml_cbor_reader_set_flags(ml_cbor_reader_t *Reader, int Flags) {
+	Reader->Flags = Flags;
+}
+
 int ml_cbor_reader_done(ml_cbor_reader_t *Reader) {
 	return Reader->Value != NULL;
 }
@@ -263,18 +291,47 @@ static ml_cbor_reader_collection_t *collection_push(ml_cbor_reader_t *Reader) {
 	if (Collection) Reader->FreeCollection = Collection->Prev; else Collection = new(ml_cbor_reader_collection_t);
 	Collection->Prev = Reader->Collection;
 	Collection->Tags = Reader->Tags;
+	// Typed decoding only applies to untagged collections outside any tagged collection, tag handlers always see generic values.
+	Collection->Typed = (Reader->Flags & ML_CBOR_READER_FLAG_TYPED_ARRAYS) && !Reader->Tags && (!Reader->Collection || Reader->Collection->Typed);
+	Collection->Numbers = NULL;
+	Collection->Count = Collection->Space = 0;
+	Collection->Real = 0;
 	Reader->Tags = NULL;
 	Reader->Collection = Collection;
 	return Collection;
 }
 
+static ml_value_t *collection_numbers(ml_cbor_reader_collection_t *Collection, int Final) {
+	ml_cbor_number_t *Numbers = Collection->Numbers;
+	size_t Count = Collection->Count;
+	Collection->Numbers = NULL;
+	Collection->Count = Collection->Space = 0;
+	if (Final && DefaultNumbersFn) return DefaultNumbersFn(Collection->Real, Count, Numbers);
+	ml_value_t *List = ml_list();
+	if (Collection->Real) {
+		for (size_t I = 0; I < Count; ++I) ml_list_put(List, ml_real(Numbers[I].Real));
+	} else {
+		for (size_t I = 0; I < Count; ++I) ml_list_put(List, ml_integer(Numbers[I].Integer));
+	}
+	return List;
+}
+
 static void value_handler(ml_cbor_reader_t *Reader, ml_value_t *Value);
 
 static void collection_pop(ml_cbor_reader_t *Reader) {
 	ml_cbor_reader_collection_t *Collection = Reader->Collection;
 	Reader->Collection = Collection->Prev;
 	Reader->Tags = Collection->Tags;
-	ml_value_t *Value = Collection->Collection;
+	ml_value_t *Value = Collection->Collection ?: collection_numbers(Collection, 1);
+	if (Collection->Typed && ml_is(Value, MLListT)) {
+		for (int I = 0; I < NumDefaultListFns; ++I) {
+			ml_value_t *Typed = DefaultListFns[I](Value);
+			if (Typed) {
+				Value = Typed;
+				break;
+			}
+		}
+	}
 	Collection->Prev = Reader->FreeCollection;
 	Collection->Collection = NULL;
 	Collection->Key = NULL;
@@ -284,6 +341,52 @@ static void collection_pop(ml_cbor_reader_t *Reader) {
 
 static ml_value_t IsList[1];
 
+static inline ml_cbor_number_t *number_next(ml_cbor_reader_t *Reader) {
+	// Returns the next slot in the current typed array, or NULL if the number must go through value_handler.
+	ml_cbor_reader_collection_t *Collection = Reader->Collection;
+	if (!Collection || Collection->Collection || Reader->Tags) return NULL;
+	if (Collection->Count == Collection->Space) {
+		size_t Extra = Collection->Count > 4096 ? Collection->Count : 4096;
+		if (Extra > (size_t)Collection->Remaining) Extra = Collection->Remaining;
+		Collection->Space += Extra;
+		Collection->Numbers = GC_realloc(Collection->Numbers, Collection->Space * sizeof(ml_cbor_number_t));
+	}
+	return Collection->Numbers + Collection->Count++;
+}
+
+static inline void number_done(ml_cbor_reader_t *Reader) {
+	if (--Reader->Collection->Remaining == 0) collection_pop(Reader);
+}
+
+static void integer_handler(ml_cbor_reader_t *Reader, int64_t Integer) {
+	ml_cbor_number_t *Number = number_next(Reader);
+	if (!Number) {
+		value_handler(Reader, ml_integer(Integer));
+		return;
+	}
+	if (Reader->Collection->Real) {
+		Number->Real = Integer;
+	} else {
+		Number->Integer = Integer;
+	}
+	number_done(Reader);
+}
+
+static void real_handler(ml_cbor_reader_t *Reader, double Real) {
+	ml_cbor_number_t *Number = number_next(Reader);
+	if (!Number) {
+		value_handler(Reader, ml_real(Real));
+		return;
+	}
+	ml_cbor_reader_collection_t *Collection = Reader->Collection;
+	if (!Collection->Real) {
+		Collection->Real = 1;
+		for (ml_cbor_number_t *Previous = Collection->Numbers; Previous < Number; ++Previous) Previous->Real = Previous->Integer;
+	}
+	Number->Real = Real;
+	number_done(Reader);
+}
+
 static void value_handler(ml_cbor_reader_t *Reader, ml_value_t *Value) {
 	if (ml_is_error(Value)) {
 		Reader->Value = Value;
@@ -313,6 +416,7 @@ static void value_handler(ml_cbor_reader_t *Reader, ml_value_t *Value) {
 		Reader->Stream->State = MCS_FINISHED;
 		return;
 	} else if (Collection->Key == IsList) {
+		if (!Collection->Collection) Collection->Collection = collection_numbers(Collection, 0);
 		ml_list_put(Collection->Collection, Value);
 		if (Collection->Remaining && --Collection->Remaining == 0) {
 			collection_pop(Reader);
@@ -337,10 +441,10 @@ int ml_cbor_reader_read(ml_cbor_reader_t *Reader, const unsigned char *Bytes, in
 		switch (minicbor_next(Stream)) {
 		case MCE_WAIT: break;
 		case MCE_POSITIVE:
-			value_handler(Reader, ml_integer(Stream->Integer));
+			integer_handler(Reader, Stream->Integer);
 			break;
 		case MCE_NEGATIVE:
-			value_handler(Reader, ml_integer(~(int64_t)Stream->Integer));
+			integer_handler(Reader, ~(int64_t)Stream->Integer);
 			break;
 		case MCE_BYTES:
 			if (!Stream->Required) value_handler(Reader, ml_address(NULL, 0));
@@ -354,14 +458,21 @@ int ml_cbor_reader_read(ml_cbor_reader_t *Reader, const unsigned char *Bytes, in
 			break;
 		case MCE_STRING_PIECE:
 			ml_stringbuffer_write(Reader->Buffer, (const char *)Stream->Bytes, Stream->Size);
-			if (!Stream->Required) value_handler(Reader, ml_stringbuffer_to_string(Reader->Buffer));
+			if (Stream->Required) break;
+			if (Reader->Collection && !Reader->Collection->Key && !Reader->Tags) {
+				// Map keys are interned so repeated keys share a single string.
+				value_handler(Reader, ml_stringbuffer_intern(Reader->Buffer));
+			} else {
+				value_handler(Reader, ml_stringbuffer_to_string(Reader->Buffer));
+			}
 			break;
 		case MCE_ARRAY:
 			if (Stream->Required) {
 				ml_cbor_reader_collection_t *Collection = collection_push(Reader);
 				Collection->Remaining = Stream->Required;
 				Collection->Key = IsList;
-				Collection->Collection = ml_list();
+				// Definite length typed arrays collect numbers into a flat buffer until a non-number is seen.
+				Collection->Collection = (Collection->Typed && Collection->Remaining > 0) ? NULL : ml_list();
 			} else {
 				value_handler(Reader, ml_list());
 			}
@@ -405,7 +516,7 @@ int ml_cbor_reader_read(ml_cbor_reader_t *Reader, const unsigned char *Bytes, in
 			}
 			break;
 		case MCE_FLOAT:
-			value_handler(Reader, ml_real(Stream->Real));
+			real_handler(Reader, Stream->Real);
 			break;
 		case MCE_BREAK:
 			collection_pop(Reader);
@@ -1439,9 +1550,34 @@ ML_METHOD(CborEncode, MLAnyT, MLStringBufferT, MLExternalSetT) {
 }
 
 ML_ENUM2(CborFlagT, "cbor::flag",
-	"ReuseMapKeys", ML_CBOR_WRITER_FLAG_REUSE_MAP_KEYS
+	"ReuseMapKeys", ML_CBOR_WRITER_FLAG_REUSE_MAP_KEYS,
+	"TypedArrays", ML_CBOR_READER_FLAG_TYPED_ARRAYS
 );
 
+ML_METHODX(CborDecode, MLAddressT, CborFlagT) {
+//@cbor::decode
+//<Bytes
+//<Flags
+//>any|error
+// Decode :mini:`Bytes` into a Minilang value, or return an error if :mini:`Bytes` contains invalid CBOR or cannot be decoded into a Minilang value.
+// If :mini:`Flags` contains :mini:`cbor::flag::TypedArrays` then untagged arrays of numbers are decoded directly into arrays, arrays of equal length numeric arrays into matrices and arrays of maps with identical keys into tables.
+	ml_cbor_reader_t Reader[1] = {{0,}};
+	Reader->TagFns = DefaultTagFns;
+	Reader->GlobalGet = (ml_external_fn_t)ml_externals_get_value;
+	Reader->Globals = MLExternals;
+	Reader->Reused = NULL;
+	Reader->ClassTable = ml_context_get_static(Caller->Context, ML_CLASSES_INDEX);
+	Reader->Flags = ml_enum_value_value(Args[1]);
+	minicbor_stream_init(Reader->Stream);
+	ml_cbor_reader_read(Reader, (const unsigned char *)ml_address_value(Args[0]), ml_address_length(Args[0]));
+	int Extra = ml_cbor_reader_extra(Reader);
+	if (Extra) {
+		if (Reader->Value && ml_is_error(Reader->Value)) ML_RETURN(Reader->Value);
+		ML_ERROR("CBORError", "Extra bytes after decoding: %d", Extra);
+	}
+	ML_RETURN(ml_cbor_reader_get(Reader));
+}
+
 ML_METHODV(CborEncode, MLAnyT) {
 	ml_value_t *Value = Args[0];
 	ml_stringbuffer_t Buffer[1] = {ML_STRINGBUFFER_INIT};
@@ -55,6 +55,15 @@ int ml_cbor_reader_done(ml_cbor_reader_t *Reader);
 ml_value_t *ml_cbor_reader_get(ml_cbor_reader_t *Reader);
 int ml_cbor_reader_extra(ml_cbor_reader_t *Reader);
 void ml_cbor_reader_set_classtable(ml_cbor_reader_t *Reader, ml_class_table_t *ClassTable);
+void ml_cbor_reader_set_flags(ml_cbor_reader_t *Reader, int Flags);
+
+#define ML_CBOR_READER_FLAG_TYPED_ARRAYS 0x0002
+
+typedef ml_value_t *(*ml_cbor_numbers_fn)(int Real, size_t Count, void *Values);
+typedef ml_value_t *(*ml_cbor_list_fn)(ml_value_t *List);
+
+void ml_cbor_default_numbers(ml_cbor_numbers_fn Fn);
+void ml_cbor_default_list(ml_cbor_list_fn Fn);
 
 typedef struct {
 	union {
@@ -132,13 +141,22 @@ ml_cbor_result_t ml_from_cbor_extra(ml_cbor_t Cbor, ml_cbor_tag_fns_t *TagFns, m
 #define ML_CBOR_TAG_MULTI_ARRAY 40
 #define ML_CBOR_TAG_ARRAY_ANY 41
 #define ML_CBOR_TAG_ARRAY_UINT8 64
+#define ML_CBOR_TAG_ARRAY_UINT16_BE 65
+#define ML_CBOR_TAG_ARRAY_UINT32_BE 66
+#define ML_CBOR_TAG_ARRAY_UINT64_BE 67
+#define ML_CBOR_TAG_ARRAY_UINT8_CLAMPED 68
 #define ML_CBOR_TAG_ARRAY_UINT16_LE 69
 #define ML_CBOR_TAG_ARRAY_UINT32_LE 70
 #define ML_CBOR_TAG_ARRAY_UINT64_LE 71
 #define ML_CBOR_TAG_ARRAY_INT8 72
+#define ML_CBOR_TAG_ARRAY_INT16_BE 73
+#define ML_CBOR_TAG_ARRAY_INT32_BE 74
+#define ML_CBOR_TAG_ARRAY_INT64_BE 75
 #define ML_CBOR_TAG_ARRAY_INT16_LE 77
 #define ML_CBOR_TAG_ARRAY_INT32_LE 78
 #define ML_CBOR_TAG_ARRAY_INT64_LE 79
+#define ML_CBOR_TAG_ARRAY_FLOAT32_BE 81
+#define ML_CBOR_TAG_ARRAY_FLOAT64_BE 82
 #define ML_CBOR_TAG_ARRAY_FLOAT32_LE 85
 #define ML_CBOR_TAG_ARRAY_FLOAT64_LE 86
 #define ML_CBOR_TAG_STRINGREF_NAMESPACE 256
@@ -3214,6 +3214,7 @@ static void ml_fun_expr_compile2(mlc_function_t *Function, ml_value_t *Value, ml
 	Info->Return = ml_inst_alloc(SubFunction, Expr->EndLine, MLI_RETURN, 0);
 	MLC_LINK(SubFunction->Returns, Info->Return);
 	Info->Halt = SubFunction->Next;
+	ml_closure_info_fuse(Info);
 	ml_decl_t **UpValueSlot = &SubFunction->Decls;
 	while (UpValueSlot[0]) UpValueSlot = &UpValueSlot[0]->Next;
 	int Index = 0;
@@ -5088,7 +5089,7 @@ static void ml_accept_named_arguments(ml_parser_t *Parser, ml_token_t EndToken,
 		ml_token_t Token = ml_current2(Parser);
 		if (Token == MLT_IDENT) {
 			ml_next(Parser);
-			ml_names_add(Names, ml_string(Parser->Ident, -1));
+			ml_names_add(Names, ml_string_intern(Parser->Ident, -1));
 		} else if (Token == MLT_VALUE && ml_typeof(Parser->Value) == MLStringT) {
 			ml_next(Parser);
 			ml_names_add(Names, Parser->Value);
@@ -5136,7 +5137,7 @@ static void ml_accept_arguments(ml_parser_t *Parser, ml_token_t EndToken, mlc_ex
 			if (ml_parse2(Parser, MLT_COLON) || ml_parse2(Parser, MLT_IS)) {
 				ml_value_t *Names = ml_names();
 				if (Arg->compile == (void *)ml_ident_expr_compile) {
-					ml_names_add(Names, ml_string(((mlc_ident_expr_t *)Arg)->Ident, -1));
+					ml_names_add(Names, ml_string_intern(((mlc_ident_expr_t *)Arg)->Ident, -1));
 				} else if (Arg->compile == (void *)ml_value_expr_compile) {
 					ml_value_t *Name = ((mlc_value_expr_t *)Arg)->Value;
 					if (ml_typeof(Name) != MLStringT) {
@@ -5871,7 +5872,7 @@ with_name:
 			TupleExpr->Child = Expr;
 			ml_value_t *Names = ml_names();
 			if (Expr->compile == (void *)ml_ident_expr_compile) {
-				ml_names_add(Names, ml_string(((mlc_ident_expr_t *)Expr)->Ident, -1));
+				ml_names_add(Names, ml_string_intern(((mlc_ident_expr_t *)Expr)->Ident, -1));
 			} else if (Expr->compile == (void *)ml_value_expr_compile) {
 				ml_value_t *Name = ((mlc_value_expr_t *)Expr)->Value;
 				if (ml_typeof(Name) != MLStringT) {
@@ -6016,7 +6017,7 @@ static mlc_expr_t *ml_parse_term_postfix(ml_parser_t *Parser, int MethDecl, mlc_
 		case MLT_IMPORT: {
 			ml_next(Parser);
 			ML_EXPR(ResolveExpr, parent_value, resolve);
-			ResolveExpr->Value = ml_string(Parser->Ident, -1);
+			ResolveExpr->Value = ml_string_intern(Parser->Ident, -1);
 			ResolveExpr->Child = Expr;
 			Expr = ML_EXPR_END(ResolveExpr);
 			break;
@@ -6443,7 +6444,7 @@ static mlc_expr_t *ml_accept_block_export(ml_parser_t *Parser, mlc_expr_t *Expr,
 	Expr->Next = ML_EXPR_END(NamesExpr);
 	mlc_expr_t **ArgsSlot = &NamesExpr->Next;
 	while (Export) {
-		ml_names_add(Names, ml_string(Export->Ident, -1));
+		ml_names_add(Names, ml_string_intern(Export->Ident, -1));
 		ML_EXPR(IdentExpr, ident, ident);
 		IdentExpr->Ident = Export->Ident;
 		ArgsSlot[0] = ML_EXPR_END(IdentExpr);
@@ -6624,6 +6625,7 @@ static void ml_function_compile2(mlc_function_t *Function, ml_value_t *Value, ml
 	Info->Return = MLC_EMIT(Expr->EndLine, MLI_RETURN, 0);
 	MLC_LINK(Function->Returns, Info->Return);
 	Info->Halt = Function->Next;
+	ml_closure_info_fuse(Info);
 	Info->StartLine = Expr->StartLine;
 	Info->EndLine = Expr->EndLine;
 	Info->FrameSize = Function->Size;
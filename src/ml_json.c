@@ -1,8 +1,13 @@
 #include "ml_json.h"
 #include "ml_macros.h"
 #include "ml_stream.h"
+#include "ml_object.h"
 #include <inttypes.h>
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
 #undef ML_CATEGORY
 #define ML_CATEGORY "json"
 
@@ -134,17 +139,7 @@ static void json_decoder_pop(json_decoder_t *Decoder) {
 	}
 }
 
-static void json_finish_number(json_decoder_t *Decoder) {
-	char *String = ml_stringbuffer_get_string(Decoder->Buffer);
-	ml_value_t *Number;
-	for (char *P = String; *P; ++P) {
-		if (*P == '.' || *P == 'e' || *P == 'E') {
-			Number = ml_real(strtod(String, NULL));
-			goto real;
-		}
-	}
-	Number = ml_integer(strtoll(String, NULL, 10));
-real:
+static void json_decoder_number(json_decoder_t *Decoder, ml_value_t *Number) {
 	if (Decoder->Collection) {
 		if (Decoder->Key) {
 			ml_map_insert(Decoder->Collection, Decoder->Key, Number);
@@ -160,6 +155,43 @@ real:
 	}
 }
 
+static void json_finish_number(json_decoder_t *Decoder) {
+	char *String = ml_stringbuffer_get_string(Decoder->Buffer);
+	for (char *P = String; *P; ++P) {
+		if (*P == '.' || *P == 'e' || *P == 'E') {
+			return json_decoder_number(Decoder, ml_real(strtod(String, NULL)));
+		}
+	}
+	json_decoder_number(Decoder, ml_integer(strtoll(String, NULL, 10)));
+}
+
+#define JSON_NUMBER_SIZE 64
+
+static const char *json_number_end(const char *Next, const char *End, int *Real) {
+// Returns the end of a complete, valid number starting at Next or NULL if the number may continue past End or is invalid.
+	if (*Next == '-') ++Next;
+	if (Next == End) return NULL;
+	if (*Next == '0') {
+		++Next;
+	} else if (*Next >= '1' && *Next <= '9') {
+		do ++Next; while (Next < End && *Next >= '0' && *Next <= '9');
+	} else {
+		return NULL;
+	}
+	if (Next < End && *Next == '.') {
+		if (++Next == End || *Next < '0' || *Next > '9') return NULL;
+		do ++Next; while (Next < End && *Next >= '0' && *Next <= '9');
+		*Real = 1;
+	}
+	if (Next < End && (*Next == 'e' || *Next == 'E')) {
+		if (++Next < End && (*Next == '+' || *Next == '-')) ++Next;
+		if (Next == End || *Next < '0' || *Next > '9') return NULL;
+		do ++Next; while (Next < End && *Next >= '0' && *Next <= '9');
+		*Real = 1;
+	}
+	return Next < End ? Next : NULL;
+}
+
 static ml_value_t *json_finish_keyword(json_decoder_t *Decoder) {
 	char *String = ml_stringbuffer_get_string(Decoder->Buffer);
 	ml_value_t *Value;
@@ -188,6 +220,62 @@ static ml_value_t *json_finish_keyword(json_decoder_t *Decoder) {
 	return NULL;
 }
 
+#if defined(__x86_64__)
+__attribute__ ((target("sse2")))
+#endif
+static inline const char *json_string_end(const char *Next, const char *End) {
+// Returns the first quote, backslash or control character in [Next, End), or End if there are none.
+#if defined(__x86_64__)
+	const __m128i Quote = _mm_set1_epi8('\"'), Slash = _mm_set1_epi8('\\'), Control = _mm_set1_epi8(0x1F);
+	while (End - Next >= 16) {
+		__m128i Chunk = _mm_loadu_si128((const __m128i *)Next);
+		__m128i Special = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(Chunk, Quote), _mm_cmpeq_epi8(Chunk, Slash)),
+			_mm_cmpeq_epi8(_mm_min_epu8(Chunk, Control), Chunk)
+		);
+		int Mask = _mm_movemask_epi8(Special);
+		if (Mask) return Next + __builtin_ctz(Mask);
+		Next += 16;
+	}
+#endif
+	while (Next < End) {
+		unsigned char Char = *Next;
+		if (Char == '\"' || Char == '\\' || Char < 0x20) break;
+		++Next;
+	}
+	return Next;
+}
+
+#if defined(__x86_64__)
+__attribute__ ((target("sse2")))
+#endif
+static inline const char *json_structural_next(const char *Next, const char *End) {
+// Returns the first quote or bracket in [Next, End), or End if there are none.
+#if defined(__x86_64__)
+	// '[' and ']' differ from '{' and '}' only in bit 5.
+	const __m128i Quote = _mm_set1_epi8('\"'), Bit5 = _mm_set1_epi8(0x20);
+	const __m128i Open = _mm_set1_epi8('{'), Close = _mm_set1_epi8('}');
+	while (End - Next >= 16) {
+		__m128i Chunk = _mm_loadu_si128((const __m128i *)Next);
+		__m128i Folded = _mm_or_si128(Chunk, Bit5);
+		__m128i Special = _mm_or_si128(
+			_mm_cmpeq_epi8(Chunk, Quote),
+			_mm_or_si128(_mm_cmpeq_epi8(Folded, Open), _mm_cmpeq_epi8(Folded, Close))
+		);
+		int Mask = _mm_movemask_epi8(Special);
+		if (Mask) return Next + __builtin_ctz(Mask);
+		Next += 16;
+	}
+#endif
+	while (Next < End) {
+		switch (*Next) {
+		case '\"': case '[': case ']': case '{': case '}': return Next;
+		}
+		++Next;
+	}
+	return Next;
+}
+
 ml_value_t *json_decoder_parse(json_decoder_t *Decoder, const char *Input, size_t Size) {
 	while (Size-- > 0) {
 		char Char = *Input++;
@@ -205,18 +293,34 @@ ml_value_t *json_decoder_parse(json_decoder_t *Decoder, const char *Input, size_
 			case '\"':
 				Decoder->State = JS_STRING;
 				break;
-			case '-':
-				ml_stringbuffer_put(Decoder->Buffer, Char);
-				Decoder->State = JS_SIGN;
-				break;
-			case '0':
-				ml_stringbuffer_put(Decoder->Buffer, Char);
-				Decoder->State = JS_ZERO;
-				break;
-			case '1' ... '9':
+			case '-': case '0' ... '9': {
+				// Numbers which are complete within this input are parsed directly without the buffer.
+				const char *Start = Input - 1;
+				int Real = 0;
+				const char *Stop = json_number_end(Start, Input + Size, &Real);
+				if (Stop && Stop - Start < JSON_NUMBER_SIZE) {
+					char Number[JSON_NUMBER_SIZE];
+					memcpy(Number, Start, Stop - Start);
+					Number[Stop - Start] = 0;
+					if (Real) {
+						json_decoder_number(Decoder, ml_real(strtod(Number, NULL)));
+					} else {
+						json_decoder_number(Decoder, ml_integer(strtoll(Number, NULL, 10)));
+					}
+					Size -= Stop - Input;
+					Input = Stop;
+					break;
+				}
 				ml_stringbuffer_put(Decoder->Buffer, Char);
-				Decoder->State = JS_DIGITS;
+				if (Char == '-') {
+					Decoder->State = JS_SIGN;
+				} else if (Char == '0') {
+					Decoder->State = JS_ZERO;
+				} else {
+					Decoder->State = JS_DIGITS;
+				}
 				break;
+			}
 			case '{':
 				json_decoder_push(Decoder, ml_map());
 				Decoder->State = JS_OBJECT_START;
@@ -289,7 +393,13 @@ ml_value_t *json_decoder_parse(json_decoder_t *Decoder, const char *Input, size_
 		case JS_STRING:
 			switch (Char) {
 			case '\"': {
-				ml_value_t *String = ml_stringbuffer_to_string(Decoder->Buffer);
+				ml_value_t *String;
+				if (Decoder->Collection && !Decoder->Key && ml_is(Decoder->Collection, MLMapT)) {
+					// Object keys are interned so repeated keys share a single string.
+					String = ml_stringbuffer_intern(Decoder->Buffer);
+				} else {
+					String = ml_stringbuffer_to_string(Decoder->Buffer);
+				}
 				if (Decoder->Collection) {
 					if (Decoder->Key) {
 						ml_map_insert(Decoder->Collection, Decoder->Key, String);
@@ -313,10 +423,14 @@ ml_value_t *json_decoder_parse(json_decoder_t *Decoder, const char *Input, size_
 				break;
 			case 0 ... 31:
 				return ml_error("JSONError", "Invalid character: %c", Char);
-			default:
-				ml_stringbuffer_put(Decoder->Buffer, Char);
+			default: {
+				const char *Run = Input - 1, *Stop = json_string_end(Input, Input + Size);
+				ml_stringbuffer_write(Decoder->Buffer, Run, Stop - Run);
+				Size -= Stop - Input;
+				Input = Stop;
 				break;
 			}
+			}
 			break;
 		case JS_ESCAPE:
 			switch (Char) {
@@ -746,11 +860,770 @@ static void ML_TYPED_FN(ml_stream_flush, MLJsonDecoderT, ml_state_t *Caller, ml_
 	ML_RETURN(Decoder);
 }
 
+// Events //
+
+typedef enum {
+	JE_OBJECT = 1,
+	JE_END_OBJECT,
+	JE_ARRAY,
+	JE_END_ARRAY,
+	JE_KEY,
+	JE_VALUE,
+	JE_SKIPPED
+} json_event_t;
+
+ML_ENUM2(MLJsonEventT, "json::event",
+	"Object", JE_OBJECT, // The start of an object.
+	"EndObject", JE_END_OBJECT, // The end of an object.
+	"Array", JE_ARRAY, // The start of an array.
+	"EndArray", JE_END_ARRAY, // The end of an array.
+	"Key", JE_KEY, // An object key, the value is the key.
+	"Value", JE_VALUE // A scalar value.
+);
+
+typedef enum {
+	JR_VALUE,
+	JR_ARRAY_START,
+	JR_ARRAY_REST,
+	JR_OBJECT_START,
+	JR_OBJECT_REST,
+	JR_KEY,
+	JR_COLON,
+	JR_STRING,
+	JR_ESCAPE,
+	JR_UNICODE,
+	JR_NUMBER,
+	JR_KEYWORD,
+	JR_SKIP,
+	JR_SKIP_STRING,
+	JR_SKIP_ESCAPE,
+	JR_SKIP_SCALAR
+} json_reader_state_t;
+
+#define JSON_TOKEN_SIZE 64
+
+typedef struct {
+	const char *Next, *End, *Start;
+	char *Stack;
+	ml_value_t *Value, *Error;
+	ml_stringbuffer_t Buffer[1];
+	uint32_t CodePoint;
+	json_reader_state_t State;
+	int Depth, StackSize, SkipDepth, SkipNext;
+	int IsKey, Escaped, ZeroCopy, Final, Unicode, Length;
+	char Token[JSON_TOKEN_SIZE];
+} json_reader_t;
+
+static void json_reader_init(json_reader_t *Reader) {
+	Reader->Buffer[0] = ML_STRINGBUFFER_INIT;
+	Reader->StackSize = JSON_STACK_SIZE;
+	Reader->Stack = snew(JSON_STACK_SIZE);
+}
+
+static inline json_reader_state_t json_reader_after(json_reader_t *Reader) {
+	if (!Reader->Depth) return JR_VALUE;
+	return Reader->Stack[Reader->Depth - 1] == '[' ? JR_ARRAY_REST : JR_OBJECT_REST;
+}
+
+static void json_reader_push(json_reader_t *Reader, char Kind) {
+	if (Reader->Depth == Reader->StackSize) {
+		char *Stack = snew(2 * Reader->StackSize);
+		memcpy(Stack, Reader->Stack, Reader->StackSize);
+		Reader->Stack = Stack;
+		Reader->StackSize *= 2;
+	}
+	Reader->Stack[Reader->Depth++] = Kind;
+}
+
+static ml_value_t *json_reader_number(json_reader_t *Reader) {
+	char *String = Reader->Token, *End;
+	String[Reader->Length] = 0;
+	Reader->Length = 0;
+	ml_value_t *Number;
+	if (strpbrk(String, ".eE")) {
+		Number = ml_real(strtod(String, &End));
+	} else {
+		Number = ml_integer(strtoll(String, &End, 10));
+	}
+	if (*End || End == String) return ml_error("JSONError", "Invalid number: %s", String);
+	return Number;
+}
+
+static ml_value_t *json_reader_keyword(json_reader_t *Reader) {
+	char *String = Reader->Token;
+	String[Reader->Length] = 0;
+	Reader->Length = 0;
+	if (!strcmp(String, "true")) return (ml_value_t *)MLTrue;
+	if (!strcmp(String, "false")) return (ml_value_t *)MLFalse;
+	if (!strcmp(String, "null")) return MLNil;
+	return ml_error("JSONError", "Invalid keyword: %s", String);
+}
+
+static const unsigned char JsonScalarChars[256] = {
+	['0' ... '9'] = 1, ['a' ... 'z'] = 1, ['+'] = 1, ['-'] = 1, ['.'] = 1, ['E'] = 1
+};
+
+static int json_reader_next(json_reader_t *Reader) {
+// Returns the next event from the current input, 0 if more input is required or -1 on error.
+// If Reader->SkipNext is set then the next value is skipped without decoding it, returning JE_SKIPPED once it has been passed.
+	const char *Next = Reader->Next, *End = Reader->End;
+	for (;;) {
+		if (Next == End) {
+			Reader->Next = Next;
+			if (!Reader->Final) return 0;
+			switch (Reader->State) {
+			case JR_VALUE:
+				if (!Reader->Depth) return 0;
+				break;
+			case JR_NUMBER:
+				Reader->Value = json_reader_number(Reader);
+				goto value;
+			case JR_KEYWORD:
+				Reader->Value = json_reader_keyword(Reader);
+				goto value;
+			case JR_SKIP_SCALAR:
+				goto skipped;
+			default:
+				break;
+			}
+			Reader->Error = ml_error("JSONError", "Incomplete JSON");
+			return -1;
+		}
+		char Char = *Next;
+		switch (Reader->State) {
+		case JR_ARRAY_START:
+			if (Char == ']') {
+				++Next;
+				goto end_array;
+			}
+			// fall through
+		case JR_VALUE:
+			switch (Char) {
+			case ' ': case '\t': case '\r': case '\n':
+				++Next;
+				continue;
+			}
+			if (Reader->SkipNext) {
+				++Next;
+				switch (Char) {
+				case '{': case '[':
+					Reader->SkipDepth = 1;
+					Reader->State = JR_SKIP;
+					continue;
+				case '\"':
+					Reader->SkipDepth = 0;
+					Reader->State = JR_SKIP_STRING;
+					continue;
+				case '-': case '0' ... '9': case 'a' ... 'z':
+					Reader->State = JR_SKIP_SCALAR;
+					continue;
+				}
+				goto invalid;
+			}
+			switch (Char) {
+			case '\"':
+				Reader->IsKey = 0;
+				goto string;
+			case '{':
+				json_reader_push(Reader, '{');
+				Reader->State = JR_OBJECT_START;
+				Reader->Value = MLNil;
+				Reader->Next = Next + 1;
+				return JE_OBJECT;
+			case '[':
+				json_reader_push(Reader, '[');
+				Reader->State = JR_ARRAY_START;
+				Reader->Value = MLNil;
+				Reader->Next = Next + 1;
+				return JE_ARRAY;
+			case '-': case '0' ... '9':
+				Reader->State = JR_NUMBER;
+				continue;
+			case 'a' ... 'z':
+				Reader->State = JR_KEYWORD;
+				continue;
+			}
+			goto invalid;
+		case JR_ARRAY_REST:
+			++Next;
+			switch (Char) {
+			case ' ': case '\t': case '\r': case '\n': continue;
+			case ',': Reader->State = JR_VALUE; continue;
+			case ']': goto end_array;
+			}
+			--Next;
+			goto invalid;
+		case JR_OBJECT_START:
+			++Next;
+			switch (Char) {
+			case ' ': case '\t': case '\r': case '\n': continue;
+			case '\"': Reader->IsKey = 1; --Next; goto string;
+			case '}': goto end_object;
+			}
+			--Next;
+			goto invalid;
+		case JR_OBJECT_REST:
+			++Next;
+			switch (Char) {
+			case ' ': case '\t': case '\r': case '\n': continue;
+			case ',': Reader->State = JR_KEY; continue;
+			case '}': goto end_object;
+			}
+			--Next;
+			goto invalid;
+		case JR_KEY:
+			switch (Char) {
+			case ' ': case '\t': case '\r': case '\n': ++Next; continue;
+			case '\"': Reader->IsKey = 1; goto string;
+			}
+			goto invalid;
+		case JR_COLON:
+			++Next;
+			switch (Char) {
+			case ' ': case '\t': case '\r': case '\n': continue;
+			case ':': Reader->State = JR_VALUE; continue;
+			}
+			--Next;
+			goto invalid;
+		case JR_STRING: {
+			const char *Run = Next;
+			Next = json_string_end(Next, End);
+			if (!Reader->ZeroCopy || Reader->Escaped) ml_stringbuffer_write(Reader->Buffer, Run, Next - Run);
+			if (Next == End) continue;
+			Char = *Next++;
+			if (Char == '\"') {
+				ml_value_t *String;
+				if (Reader->ZeroCopy && !Reader->Escaped) {
+					size_t Length = (Next - 1) - Reader->Start;
+					String = Reader->IsKey ? ml_string_intern(Reader->Start, Length) : ml_address(Reader->Start, Length);
+				} else {
+					String = Reader->IsKey ? ml_stringbuffer_intern(Reader->Buffer) : ml_stringbuffer_to_string(Reader->Buffer);
+				}
+				Reader->Value = String;
+				if (Reader->IsKey) {
+					Reader->State = JR_COLON;
+					Reader->Next = Next;
+					return JE_KEY;
+				}
+				goto value;
+			} else if (Char == '\\') {
+				if (Reader->ZeroCopy && !Reader->Escaped) {
+					ml_stringbuffer_write(Reader->Buffer, Reader->Start, (Next - 1) - Reader->Start);
+					Reader->Escaped = 1;
+				}
+				Reader->State = JR_ESCAPE;
+				continue;
+			}
+			--Next;
+			goto invalid;
+		}
+		case JR_ESCAPE:
+			++Next;
+			Reader->State = JR_STRING;
+			switch (Char) {
+			case '\"': ml_stringbuffer_put(Reader->Buffer, '\"'); continue;
+			case '\\': ml_stringbuffer_put(Reader->Buffer, '\\'); continue;
+			case '/': ml_stringbuffer_put(Reader->Buffer, '/'); continue;
+			case 'b': ml_stringbuffer_put(Reader->Buffer, '\b'); continue;
+			case 'f': ml_stringbuffer_put(Reader->Buffer, '\f'); continue;
+			case 'n': ml_stringbuffer_put(Reader->Buffer, '\n'); continue;
+			case 'r': ml_stringbuffer_put(Reader->Buffer, '\r'); continue;
+			case 't': ml_stringbuffer_put(Reader->Buffer, '\t'); continue;
+			case 'u':
+				Reader->CodePoint = 0;
+				Reader->Unicode = 4;
+				Reader->State = JR_UNICODE;
+				continue;
+			}
+			--Next;
+			goto invalid;
+		case JR_UNICODE:
+			switch (Char) {
+			case '0' ... '9': Reader->CodePoint = (Reader->CodePoint << 4) + (Char - '0'); break;
+			case 'a' ... 'f': Reader->CodePoint = (Reader->CodePoint << 4) + (Char - 'a') + 10; break;
+			case 'A' ... 'F': Reader->CodePoint = (Reader->CodePoint << 4) + (Char - 'A') + 10; break;
+			default: goto invalid;
+			}
+			++Next;
+			if (--Reader->Unicode == 0) {
+				ml_stringbuffer_put32(Reader->Buffer, Reader->CodePoint);
+				Reader->State = JR_STRING;
+			}
+			continue;
+		case JR_NUMBER:
+			switch (Char) {
+			case '0' ... '9': case '+': case '-': case '.': case 'e': case 'E':
+				if (Reader->Length == JSON_TOKEN_SIZE - 1) goto invalid;
+				Reader->Token[Reader->Length++] = Char;
+				++Next;
+				continue;
+			}
+			Reader->Value = json_reader_number(Reader);
+			goto value;
+		case JR_KEYWORD:
+			if (Char >= 'a' && Char <= 'z') {
+				if (Reader->Length == JSON_TOKEN_SIZE - 1) goto invalid;
+				Reader->Token[Reader->Length++] = Char;
+				++Next;
+				continue;
+			}
+			Reader->Value = json_reader_keyword(Reader);
+			goto value;
+		case JR_SKIP:
+			while ((Next = json_structural_next(Next, End)) < End) {
+				char C = *Next++;
+				if (C == '\"') {
+					Reader->State = JR_SKIP_STRING;
+					break;
+				} else if (C == '[' || C == '{') {
+					++Reader->SkipDepth;
+				} else if (--Reader->SkipDepth == 0) {
+					goto skipped;
+				}
+			}
+			continue;
+		case JR_SKIP_STRING: {
+			const char *Quote = memchr(Next, '\"', End - Next);
+			const char *Limit = Quote ?: End;
+			const char *Slash = memchr(Next, '\\', Limit - Next);
+			if (Slash) {
+				Next = Slash + 1;
+				Reader->State = JR_SKIP_ESCAPE;
+			} else if (!Quote) {
+				Next = End;
+			} else {
+				Next = Quote + 1;
+				if (!Reader->SkipDepth) goto skipped;
+				Reader->State = JR_SKIP;
+			}
+			continue;
+		}
+		case JR_SKIP_ESCAPE:
+			++Next;
+			Reader->State = JR_SKIP_STRING;
+			continue;
+		case JR_SKIP_SCALAR:
+			while (Next < End && JsonScalarChars[(unsigned char)*Next]) ++Next;
+			if (Next == End) continue;
+			goto skipped;
+		}
+	string:
+		++Next;
+		Reader->Start = Next;
+		Reader->Escaped = 0;
+		Reader->State = JR_STRING;
+		continue;
+	end_array:
+		if (!Reader->Depth || Reader->Stack[Reader->Depth - 1] != '[') goto invalid;
+		--Reader->Depth;
+		Reader->SkipNext = 0;
+		Reader->State = json_reader_after(Reader);
+		Reader->Value = MLNil;
+		Reader->Next = Next;
+		return JE_END_ARRAY;
+	end_object:
+		if (!Reader->Depth || Reader->Stack[Reader->Depth - 1] != '{') goto invalid;
+		--Reader->Depth;
+		Reader->SkipNext = 0;
+		Reader->State = json_reader_after(Reader);
+		Reader->Value = MLNil;
+		Reader->Next = Next;
+		return JE_END_OBJECT;
+	}
+value:
+	Reader->Next = Next;
+	if (ml_is_error(Reader->Value)) {
+		Reader->Error = Reader->Value;
+		return -1;
+	}
+	Reader->State = json_reader_after(Reader);
+	return JE_VALUE;
+skipped:
+	Reader->Next = Next;
+	Reader->SkipNext = 0;
+	Reader->State = json_reader_after(Reader);
+	Reader->Value = NULL;
+	return JE_SKIPPED;
+invalid:
+	Reader->Next = Next;
+	if (Next < End) {
+		Reader->Error = ml_error("JSONError", "Invalid character '%c' in JSON", *Next);
+	} else {
+		Reader->Error = ml_error("JSONError", "Invalid JSON");
+	}
+	return -1;
+}
+
+typedef enum {
+	JP_ANY,
+	JP_KEY,
+	JP_INDEX
+} json_step_kind_t;
+
+typedef struct {
+	const char *Key;
+	int Length, Index;
+	json_step_kind_t Kind;
+} json_step_t;
+
+typedef struct {
+	int Count;
+	json_step_t Steps[];
+} json_path_t;
+
+static ml_value_t *json_path_parse(const char *Path, json_path_t **Result) {
+	const char *P = Path;
+	if (*P++ != '$') return ml_error("PathError", "JSON path must start with $");
+	int Count = 0;
+	for (const char *Q = P; *Q; ++Q) if (*Q == '.' || *Q == '[') ++Count;
+	json_path_t *Parsed = xnew(json_path_t, Count, json_step_t);
+	json_step_t *Step = Parsed->Steps;
+	while (*P) {
+		if (*P == '.') {
+			++P;
+			if (*P == '*') {
+				Step->Kind = JP_ANY;
+				++P;
+			} else {
+				const char *Key = P;
+				while (*P && *P != '.' && *P != '[') ++P;
+				if (P == Key) return ml_error("PathError", "Invalid JSON path: %s", Path);
+				Step->Kind = JP_KEY;
+				Step->Key = Key;
+				Step->Length = P - Key;
+			}
+		} else if (*P == '[') {
+			++P;
+			if (*P == '*') {
+				Step->Kind = JP_ANY;
+				++P;
+			} else if (*P == '\'' || *P == '\"') {
+				char Quote = *P++;
+				const char *Key = P;
+				while (*P && *P != Quote) ++P;
+				if (!*P) return ml_error("PathError", "Invalid JSON path: %s", Path);
+				Step->Kind = JP_KEY;
+				Step->Key = Key;
+				Step->Length = P - Key;
+				++P;
+			} else if (*P >= '0' && *P <= '9') {
+				int Index = 0;
+				while (*P >= '0' && *P <= '9') Index = Index * 10 + (*P++ - '0');
+				Step->Kind = JP_INDEX;
+				Step->Index = Index;
+			} else {
+				return ml_error("PathError", "Invalid JSON path: %s", Path);
+			}
+			if (*P++ != ']') return ml_error("PathError", "Invalid JSON path: %s", Path);
+		} else {
+			return ml_error("PathError", "Invalid JSON path: %s", Path);
+		}
+		++Step;
+	}
+	Parsed->Count = Step - Parsed->Steps;
+	*Result = Parsed;
+	return NULL;
+}
+
+#define JSON_CHUNK_SIZE 65536
+
+typedef struct {
+	ml_type_t *Type;
+	ml_value_t *Source;
+	json_path_t *Path;
+} ml_json_events_t;
+
+typedef struct {
+	ml_state_t Base;
+	ml_value_t *Stream;
+	typeof(ml_stream_read) *read;
+	json_path_t *Path;
+	char *Chunk;
+	ml_value_t **Build;
+	int *Indices;
+	ml_value_t *Key, *Value, *BuildKey;
+	int Index, BuildDepth, BuildSize, SelectNext, Building;
+	json_reader_t Reader[1];
+} ml_json_iterator_t;
+
+ML_TYPE(MLJsonIteratorT, (), "json::iterator");
+//!internal
+
+static void json_select_prepare(ml_json_iterator_t *Iter, ml_value_t *Key) {
+// Decides whether the next value in the current container is skipped, selected or descended into.
+	json_reader_t *Reader = Iter->Reader;
+	json_path_t *Path = Iter->Path;
+	int Depth = Reader->Depth;
+	if (!Depth) {
+		Iter->SelectNext = !Path->Count;
+		return;
+	}
+	json_step_t *Step = Path->Steps + Depth - 1;
+	int Match = 0;
+	switch (Step->Kind) {
+	case JP_ANY:
+		Match = 1;
+		break;
+	case JP_KEY:
+		Match = Key && ml_string_length(Key) == Step->Length && !memcmp(ml_string_value(Key), Step->Key, Step->Length);
+		break;
+	case JP_INDEX:
+		Match = !Key && Iter->Indices[Depth] == Step->Index;
+		break;
+	}
+	if (!Match) {
+		Reader->SkipNext = 1;
+	} else if (Depth == Path->Count) {
+		Iter->SelectNext = 1;
+	}
+}
+
+static void json_select_next(ml_json_iterator_t *Iter) {
+// Called after each value completes, object members wait for their key instead.
+	json_reader_t *Reader = Iter->Reader;
+	int Depth = Reader->Depth;
+	if (!Depth) {
+		json_select_prepare(Iter, NULL);
+	} else if (Reader->Stack[Depth - 1] == '[') {
+		++Iter->Indices[Depth];
+		json_select_prepare(Iter, NULL);
+	}
+}
+
+static void json_select_insert(ml_json_iterator_t *Iter, ml_value_t *Value) {
+	ml_value_t *Collection = Iter->Build[Iter->BuildDepth - 1];
+	if (ml_is(Collection, MLMapT)) {
+		ml_map_insert(Collection, Iter->BuildKey, Value);
+	} else {
+		ml_list_put(Collection, Value);
+	}
+}
+
+static int json_select_event(ml_json_iterator_t *Iter, int Event) {
+	json_reader_t *Reader = Iter->Reader;
+	if (Iter->SelectNext) {
+		Iter->SelectNext = 0;
+		if (Event == JE_OBJECT || Event == JE_ARRAY || Event == JE_VALUE) Iter->Building = 1;
+	}
+	if (Iter->Building) {
+		ml_value_t *Value;
+		switch (Event) {
+		case JE_OBJECT: case JE_ARRAY: {
+			ml_value_t *Collection = Event == JE_OBJECT ? ml_map() : ml_list();
+			if (Iter->BuildDepth) json_select_insert(Iter, Collection);
+			if (Iter->BuildDepth == Iter->BuildSize) {
+				ml_value_t **Build = anew(ml_value_t *, 2 * Iter->BuildSize);
+				memcpy(Build, Iter->Build, Iter->BuildSize * sizeof(ml_value_t *));
+				Iter->Build = Build;
+				Iter->BuildSize *= 2;
+			}
+			Iter->Build[Iter->BuildDepth++] = Collection;
+			return 0;
+		}
+		case JE_KEY:
+			Iter->BuildKey = Reader->Value;
+			return 0;
+		case JE_VALUE:
+			if (Iter->BuildDepth) {
+				json_select_insert(Iter, Reader->Value);
+				return 0;
+			}
+			Value = Reader->Value;
+			break;
+		default:
+			Value = Iter->Build[--Iter->BuildDepth];
+			if (Iter->BuildDepth) return 0;
+			break;
+		}
+		Iter->Building = 0;
+		Iter->Key = ml_integer(++Iter->Index);
+		Iter->Value = Value;
+		json_select_next(Iter);
+		return 1;
+	}
+	switch (Event) {
+	case JE_OBJECT:
+		break;
+	case JE_ARRAY:
+		Iter->Indices[Reader->Depth] = 0;
+		json_select_prepare(Iter, NULL);
+		break;
+	case JE_KEY:
+		json_select_prepare(Iter, Reader->Value);
+		break;
+	default:
+		json_select_next(Iter);
+		break;
+	}
+	return 0;
+}
+
+static void ml_json_iterator_read(ml_json_iterator_t *Iter, ml_value_t *Result);
+
+static void ml_json_iterator_run(ml_json_iterator_t *Iter) {
+	ml_state_t *Caller = Iter->Base.Caller;
+	json_reader_t *Reader = Iter->Reader;
+	for (;;) {
+		int Event = json_reader_next(Reader);
+		if (Event > 0) {
+			if (Iter->Path) {
+				if (json_select_event(Iter, Event)) ML_RETURN(Iter);
+			} else {
+				Iter->Key = ml_enum_value(MLJsonEventT, Event);
+				Iter->Value = Reader->Value;
+				ML_RETURN(Iter);
+			}
+		} else if (Event < 0) {
+			ML_RETURN(Reader->Error);
+		} else if (Iter->Stream) {
+			Iter->Base.run = (ml_state_fn)ml_json_iterator_read;
+			return Iter->read((ml_state_t *)Iter, Iter->Stream, Iter->Chunk, JSON_CHUNK_SIZE);
+		} else {
+			ML_RETURN(MLNil);
+		}
+	}
+}
+
+static void ml_json_iterator_read(ml_json_iterator_t *Iter, ml_value_t *Result) {
+	ml_state_t *Caller = Iter->Base.Caller;
+	if (ml_is_error(Result)) ML_RETURN(Result);
+	size_t Length = ml_integer_value(Result);
+	json_reader_t *Reader = Iter->Reader;
+	if (Length) {
+		Reader->Next = Iter->Chunk;
+		Reader->End = Iter->Chunk + Length;
+	} else {
+		Iter->Stream = NULL;
+		Reader->Final = 1;
+	}
+	return ml_json_iterator_run(Iter);
+}
+
+static void ml_json_events_iterate(ml_state_t *Caller, ml_json_events_t *Events) {
+	ml_json_iterator_t *Iter = new(ml_json_iterator_t);
+	Iter->Base.Type = MLJsonIteratorT;
+	Iter->Base.Caller = Caller;
+	Iter->Base.Context = Caller->Context;
+	json_reader_t *Reader = Iter->Reader;
+	json_reader_init(Reader);
+	if (Events->Path) {
+		Iter->Path = Events->Path;
+		Iter->Indices = anew(int, Events->Path->Count + 1);
+		Iter->BuildSize = JSON_STACK_SIZE;
+		Iter->Build = anew(ml_value_t *, JSON_STACK_SIZE);
+		json_select_prepare(Iter, NULL);
+	}
+	ml_value_t *Source = Events->Source;
+	if (ml_is(Source, MLAddressT)) {
+		Reader->Next = ml_address_value(Source);
+		Reader->End = Reader->Next + ml_address_length(Source);
+		Reader->Final = 1;
+		Reader->ZeroCopy = !ml_is(Source, MLStringT) && !ml_is(Source, MLBufferT);
+		return ml_json_iterator_run(Iter);
+	}
+	Iter->Stream = Source;
+	Iter->read = ml_typed_fn_get(ml_typeof(Source), ml_stream_read) ?: ml_stream_read_method;
+	Iter->Chunk = snew(JSON_CHUNK_SIZE);
+	Iter->Base.run = (ml_state_fn)ml_json_iterator_read;
+	return Iter->read((ml_state_t *)Iter, Iter->Stream, Iter->Chunk, JSON_CHUNK_SIZE);
+}
+
+static void ML_TYPED_FN(ml_iter_next, MLJsonIteratorT, ml_state_t *Caller, ml_json_iterator_t *Iter) {
+	Iter->Base.Caller = Caller;
+	Iter->Base.Context = Caller->Context;
+	return ml_json_iterator_run(Iter);
+}
+
+static void ML_TYPED_FN(ml_iter_key, MLJsonIteratorT, ml_state_t *Caller, ml_json_iterator_t *Iter) {
+	ML_RETURN(Iter->Key);
+}
+
+static void ML_TYPED_FN(ml_iter_value, MLJsonIteratorT, ml_state_t *Caller, ml_json_iterator_t *Iter) {
+	ML_RETURN(Iter->Value);
+}
+
+ML_TYPE(MLJsonEventsT, (MLSequenceT), "json::events");
+//@json::events
+// A sequence of parsing events from JSON input.
+
+static void ML_TYPED_FN(ml_iterate, MLJsonEventsT, ml_state_t *Caller, ml_json_events_t *Events) {
+	return ml_json_events_iterate(Caller, Events);
+}
+
+ML_METHOD(MLJsonEventsT, MLAddressT) {
+//@json::events
+//<Json
+//>json::events
+// Returns a sequence of :mini:`Event, Value` pairs from :mini:`Json` without building any containers. :mini:`Event` is a :mini:`json::event` and :mini:`Value` is the key for :mini:`::Key` events, the value for :mini:`::Value` events and :mini:`nil` otherwise. Multiple top level values are allowed, e.g. newline delimited JSON.
+// If :mini:`Json` is a read-only address which is not a string (such as a read-only :mini:`mmap`), string values without escapes are returned as addresses into :mini:`Json` instead of being copied.
+	ml_json_events_t *Events = new(ml_json_events_t);
+	Events->Type = MLJsonEventsT;
+	Events->Source = Args[0];
+	return (ml_value_t *)Events;
+}
+
+ML_METHOD(MLJsonEventsT, MLStreamT) {
+//@json::events
+//<Stream
+//>json::events
+// Returns a sequence of :mini:`Event, Value` pairs from the JSON read from :mini:`Stream`. The stream is read in chunks as the sequence is iterated.
+	ml_json_events_t *Events = new(ml_json_events_t);
+	Events->Type = MLJsonEventsT;
+	Events->Source = Args[0];
+	return (ml_value_t *)Events;
+}
+
+ML_TYPE(MLJsonSelectT, (MLSequenceT), "json::select");
+//@json::select
+// A sequence of values selected from JSON input.
+
+static void ML_TYPED_FN(ml_iterate, MLJsonSelectT, ml_state_t *Caller, ml_json_events_t *Events) {
+	return ml_json_events_iterate(Caller, Events);
+}
+
+ML_METHOD(MLJsonSelectT, MLAddressT, MLStringT) {
+//@json::select
+//<Json
+//<Path
+//>json::select
+// Returns a sequence of the values in :mini:`Json` matching :mini:`Path`, keyed by their position in the sequence. :mini:`Path` starts with :mini:`$` followed by any number of :mini:`.name`, :mini:`['name']`, :mini:`[index]`, :mini:`.*` or :mini:`[*]` steps and is matched against each top level value. Subtrees which cannot match are skipped without being decoded (or fully validated).
+//$= let Json := "{\"items\": [{\"id\": 1, \"tags\": [\"a\"]}, {\"id\": 2}]}"
+//$= list(json::select(Json, "$.items[*].id"))
+	json_path_t *Path = NULL;
+	ml_value_t *Error = json_path_parse(ml_string_value(Args[1]), &Path);
+	if (Error) return Error;
+	ml_json_events_t *Events = new(ml_json_events_t);
+	Events->Type = MLJsonSelectT;
+	Events->Source = Args[0];
+	Events->Path = Path;
+	return (ml_value_t *)Events;
+}
+
+ML_METHOD(MLJsonSelectT, MLStreamT, MLStringT) {
+//@json::select
+//<Stream
+//<Path
+//>json::select
+// Returns a sequence of the values in the JSON read from :mini:`Stream` matching :mini:`Path`.
+	json_path_t *Path = NULL;
+	ml_value_t *Error = json_path_parse(ml_string_value(Args[1]), &Path);
+	if (Error) return Error;
+	ml_json_events_t *Events = new(ml_json_events_t);
+	Events->Type = MLJsonSelectT;
+	Events->Source = Args[0];
+	Events->Path = Path;
+	return (ml_value_t *)Events;
+}
+
 static void ml_json_encode_string(ml_stringbuffer_t *Buffer, ml_value_t *Value) {
 	ml_stringbuffer_put(Buffer, '\"');
 	const unsigned char *String = (const unsigned char *)ml_string_value(Value);
 	const unsigned char *End = String + ml_string_length(Value);
-	while (String < End) {
+	for (;;) {
+		const unsigned char *Run = String;
+		String = (const unsigned char *)json_string_end((const char *)String, (const char *)End);
+		if (String > Run) ml_stringbuffer_write(Buffer, (const char *)Run, String - Run);
+		if (String == End) break;
 		unsigned char Char = *String++;
 		switch (Char) {
 		case '\r': ml_stringbuffer_write(Buffer, "\\r", 2); break;
@@ -761,11 +1634,7 @@ static void ml_json_encode_string(ml_stringbuffer_t *Buffer, ml_value_t *Value)
 		case '\b': ml_stringbuffer_write(Buffer, "\\b", 2); break;
 		case '\t': ml_stringbuffer_write(Buffer, "\\t", 2); break;
 		default:
-			if (Char < 32) {
-				ml_stringbuffer_printf(Buffer, "\\u00%02x", Char);
-			} else {
-				ml_stringbuffer_put(Buffer, Char);
-			}
+			ml_stringbuffer_printf(Buffer, "\\u00%02x", Char);
 			break;
 		}
 	}
@@ -782,7 +1651,12 @@ ml_value_t *ml_json_encode(ml_stringbuffer_t *Buffer, ml_value_t *Value) {
 			ml_stringbuffer_write(Buffer, "false", 5);
 		}
 	} else if (ml_is(Value, MLIntegerT)) {
-		ml_stringbuffer_printf(Buffer, "%" PRId64, ml_integer_value(Value));
+		int64_t Integer = ml_integer_value(Value);
+		uint64_t Digits = Integer < 0 ? -(uint64_t)Integer : Integer;
+		char Text[24], *End = Text + 24, *Start = End;
+		do *--Start = '0' + Digits % 10; while (Digits /= 10);
+		if (Integer < 0) *--Start = '-';
+		ml_stringbuffer_write(Buffer, Start, End - Start);
 	} else if (ml_is(Value, MLRealT)) {
 		ml_stringbuffer_printf(Buffer, "%.20g", ml_real_value(Value));
 	} else if (ml_is(Value, MLStringT)) {
@@ -924,6 +1798,9 @@ void ml_json_init(stringmap_t *Globals) {
 	stringmap_insert(MLJsonT->Exports, "encode", MLJsonEncode);
 	stringmap_insert(MLJsonT->Exports, "decode", MLJsonDecode);
 	stringmap_insert(MLJsonT->Exports, "decoder", MLJsonDecoderT);
+	stringmap_insert(MLJsonT->Exports, "events", MLJsonEventsT);
+	stringmap_insert(MLJsonT->Exports, "event", MLJsonEventT);
+	stringmap_insert(MLJsonT->Exports, "select", MLJsonSelectT);
 	if (Globals) {
 		stringmap_insert(Globals, "json", MLJsonT);
 	}
@@ -82,6 +82,69 @@ ML_TYPE(MLListNodeMutableT, (), "list::node",
 
 #endif
 
+// Longer lists keep an array of their nodes for random access, filled lazily from the first node not yet indexed.
+// The node at position I is List->Nodes[List->Offset + I - 1], so appending, pushing, popping and pulling keep the array valid.
+// Any other structural change resets List->Indexed (or drops List->Nodes if the nodes move to another list).
+// Constant lists can be shared between threads, so the array is only extended under the list's NodesLock and List->Nodes / List->Indexed
+// are published with release stores, readers below List->Indexed never take the lock.
+
+#define ML_LIST_NODES_MIN 16
+
+#ifdef ML_THREADS
+#define ML_LIST_LOAD(X) __atomic_load_n(&(X), __ATOMIC_ACQUIRE)
+#define ML_LIST_STORE(X, V) __atomic_store_n(&(X), V, __ATOMIC_RELEASE)
+#define ML_LIST_NODES_LOCK(LIST) while (__atomic_test_and_set(&(LIST)->NodesLock, __ATOMIC_ACQUIRE))
+#define ML_LIST_NODES_UNLOCK(LIST) __atomic_clear(&(LIST)->NodesLock, __ATOMIC_RELEASE)
+#else
+#define ML_LIST_LOAD(X) (X)
+#define ML_LIST_STORE(X, V) (X) = (V)
+#define ML_LIST_NODES_LOCK(LIST) {}
+#define ML_LIST_NODES_UNLOCK(LIST) {}
+#endif
+
+static ml_list_node_t *ml_list_nodes_index(ml_list_t *List, int Index) {
+	if (Index <= ML_LIST_LOAD(List->Indexed)) return ML_LIST_LOAD(List->Nodes)[List->Offset + Index - 1];
+	ML_LIST_NODES_LOCK(List);
+	int Indexed = List->Indexed, Length = List->Length, Offset = List->Offset;
+	ml_list_node_t **Nodes = List->Nodes;
+	if (List->Capacity - Offset < Length) {
+		// Only leave room for appends once the list has grown after being indexed.
+		// Constant lists are never pushed or popped, so their offset stays 0 while other threads read them.
+		int Offset2 = Offset < (Length >> 1) ? Offset : (Length >> 1);
+		int Capacity = Offset2 + (Nodes ? Length + (Length >> 1) : Length);
+		ml_list_node_t **Nodes2 = anew(ml_list_node_t *, Capacity);
+		if (Indexed) memcpy(Nodes2 + Offset2, Nodes + Offset, Indexed * sizeof(ml_list_node_t *));
+		List->Offset = Offset = Offset2;
+		ML_LIST_STORE(List->Nodes, Nodes2);
+		List->Capacity = Capacity;
+		Nodes = Nodes2;
+	}
+	Nodes += Offset;
+	ml_list_node_t *Node = Indexed ? Nodes[Indexed - 1]->Next : List->Head;
+	while (Indexed < Length) {
+		Nodes[Indexed++] = Node;
+		Node = Node->Next;
+	}
+	ML_LIST_STORE(List->Indexed, Indexed);
+	ML_LIST_NODES_UNLOCK(List);
+	return Nodes[Index - 1];
+}
+
+static void ml_list_nodes_push(ml_list_t *List, ml_list_node_t *Node) {
+	int Indexed = List->Indexed;
+	if (!Indexed) return;
+	if (!List->Offset) {
+		int Room = (Indexed >> 1) + 1;
+		ml_list_node_t **Nodes = anew(ml_list_node_t *, Room + List->Capacity);
+		memcpy(Nodes + Room, List->Nodes, Indexed * sizeof(ml_list_node_t *));
+		List->Nodes = Nodes;
+		List->Capacity += Room;
+		List->Offset = Room;
+	}
+	List->Nodes[--List->Offset] = Node;
+	List->Indexed = Indexed + 1;
+}
+
 static ml_list_node_t *ml_list_index(ml_list_t *List, int Index) {
 	int Length = List->Length;
 	if (Index <= 0) Index += Length + 1;
@@ -90,6 +153,21 @@ static ml_list_node_t *ml_list_index(ml_list_t *List, int Index) {
 	if (Index < 1) return NULL;
 	if (Index == 1) return List->Head;
 	int CachedIndex = List->CachedIndex;
+	if (!CachedIndex) {
+		// Constant lists have no cursor since they can be read from several threads at once.
+		if (Length >= ML_LIST_NODES_MIN) return ml_list_nodes_index(List, Index);
+		ml_list_node_t *Node;
+		if (2 * Index <= Length) {
+			Node = List->Head;
+			int Steps = Index - 1;
+			do Node = Node->Next; while (--Steps);
+		} else {
+			Node = List->Tail;
+			int Steps = Length - Index;
+			do Node = Node->Prev; while (--Steps);
+		}
+		return Node;
+	}
 	switch (Index - CachedIndex) {
 	case -1: {
 		List->CachedIndex = Index;
@@ -102,6 +180,7 @@ static ml_list_node_t *ml_list_index(ml_list_t *List, int Index) {
 	}
 	}
 	List->CachedIndex = Index;
+	if (Length >= ML_LIST_NODES_MIN) return (List->CachedNode = ml_list_nodes_index(List, Index));
 	ml_list_node_t *Node;
 	if (2 * Index < CachedIndex) {
 		Node = List->Head;
@@ -126,7 +205,7 @@ static ml_list_node_t *ml_list_index(ml_list_t *List, int Index) {
 static void ML_TYPED_FN(ml_iter_next, MLListNodeT, ml_state_t *Caller, ml_list_node_t *Node) {
 	ml_list_node_t *Next = Node->Next;
 	if (!Next) ML_RETURN(MLNil);
-	Next->Index = Node->Index + 1;
+	if (Next->Index != Node->Index + 1) Next->Index = Node->Index + 1;
 	ML_RETURN(Next);
 }
 
@@ -257,6 +336,7 @@ void ml_list_push(ml_value_t *List0, ml_value_t *Value) {
 #ifdef ML_GENERICS
 	ml_list_update_generic(List, ml_typeof(Value));
 #endif
+	ml_list_nodes_push(List, Node);
 	List->CachedNode = List->Head = Node;
 	List->CachedIndex = 1;
 	++List->Length;
@@ -295,6 +375,10 @@ ml_value_t *ml_list_pop(ml_value_t *List0) {
 		}
 		List->CachedNode = List->Head;
 		List->CachedIndex = 1;
+		if (List->Indexed) {
+			++List->Offset;
+			--List->Indexed;
+		}
 		--List->Length;
 		return Node->Value;
 	} else {
@@ -313,6 +397,7 @@ ml_value_t *ml_list_pull(ml_value_t *List0) {
 		}
 		List->CachedNode = List->Tail;
 		List->CachedIndex = --List->Length;
+		if (List->Indexed > List->Length) List->Indexed = List->Length;
 		return Node->Value;
 	} else {
 		return MLNil;
@@ -437,11 +522,13 @@ static void ml_list_filter_state_run(ml_list_filter_state_t *State, ml_value_t *
 	if (State->DropTail) State->DropTail->Next = NULL;
 	State->Drop->Length = State->List->Length - State->Length;
 	State->Drop->CachedIndex = State->Drop->Length;
+	State->Drop->Indexed = 0;
 	State->Drop->CachedNode = State->DropTail;
 	State->List->Tail = State->KeepTail;
 	if (State->KeepTail) State->KeepTail->Next = NULL;
 	State->List->Length = State->Length;
 	State->List->CachedIndex = State->Length;
+	State->List->Indexed = 0;
 	State->List->CachedNode = State->KeepTail;
 	ML_CONTINUE(State->Base.Caller, State->Drop);
 }
@@ -503,11 +590,13 @@ static void ml_list_remove_state_run(ml_list_filter_state_t *State, ml_value_t *
 	if (State->DropTail) State->DropTail->Next = NULL;
 	State->Drop->Length = State->List->Length - State->Length;
 	State->Drop->CachedIndex = State->Drop->Length;
+	State->Drop->Indexed = 0;
 	State->Drop->CachedNode = State->DropTail;
 	State->List->Tail = State->KeepTail;
 	if (State->KeepTail) State->KeepTail->Next = NULL;
 	State->List->Length = State->Length;
 	State->List->CachedIndex = State->Length;
+	State->List->Indexed = 0;
 	State->List->CachedNode = State->KeepTail;
 	ML_CONTINUE(State->Base.Caller, State->Drop);
 }
@@ -1144,7 +1233,7 @@ ML_TYPE(MLListIterT, (), "list-iterator");
 
 static void ML_TYPED_FN(ml_iterate, MLListT, ml_state_t *Caller, ml_list_t *List) {
 	if (List->Length) {
-		List->Head->Index = 1;
+		if (List->Head->Index != 1) List->Head->Index = 1;
 		ML_RETURN(List->Head);
 	} else {
 		ML_RETURN(MLNil);
@@ -1164,7 +1253,7 @@ static void ML_TYPED_FN(ml_iterate, MLListSkipT, ml_state_t *Caller, ml_list_ski
 	if (Skip->Count < 0) ML_RETURN(MLNil);
 	if (Skip->Count >= Skip->List->Length) ML_RETURN(MLNil);
 	ml_list_node_t *Node = ml_list_index(Skip->List, Skip->Count + 1);
-	Node->Index = Skip->Count + 1;
+	if (Node->Index != Skip->Count + 1) Node->Index = Skip->Count + 1;
 	ML_RETURN(Node);
 }
 
@@ -1217,6 +1306,7 @@ ML_METHOD("empty", MLListMutableT) {
 // Removes all elements from :mini:`List` and returns it.
 	ml_list_t *List = (ml_list_t *)Args[0];
 	List->Head = List->Tail = List->CachedNode = NULL;
+	List->Indexed = 0;
 	List->Length = 0;
 #ifdef ML_GENERICS
 	List->Type = MLListMutableT;
@@ -1243,6 +1333,8 @@ ML_METHOD("splice", MLListMutableT) {
 	ml_list_t *Removed = (ml_list_t *)ml_list();
 	*Removed = *List;
 	List->Head = List->Tail = NULL;
+	List->Nodes = NULL;
+	List->Indexed = List->Capacity = List->Offset = 0;
 	List->Length = 0;
 	return (ml_value_t *)Removed;
 }
@@ -1268,6 +1360,8 @@ ML_METHOD("splice", MLListMutableT, MLIntegerT, MLIntegerT) {
 		if (End == List->Length) {
 			*Removed = *List;
 			List->Head = List->Tail = NULL;
+			List->Nodes = NULL;
+			List->Indexed = List->Capacity = List->Offset = 0;
 			List->Length = 0;
 		} else {
 			ml_list_node_t *EndNode = ml_list_index(List, End);
@@ -1280,6 +1374,7 @@ ML_METHOD("splice", MLListMutableT, MLIntegerT, MLIntegerT) {
 			NextNode->Prev = NULL;
 			List->CachedNode = List->Head;
 			List->CachedIndex = 1;
+			List->Indexed = 0;
 			List->Length -= Remove;
 		}
 	} else {
@@ -1288,24 +1383,28 @@ ML_METHOD("splice", MLListMutableT, MLIntegerT, MLIntegerT) {
 		StartNode->Prev = NULL;
 		if (End == List->Length) {
 			Removed->CachedNode = Removed->Head = StartNode;
+			Removed->CachedIndex = 1;
 			Removed->Tail = List->Tail;
 			Removed->Length = Remove;
 			List->Tail = PrevNode;
 			PrevNode->Next = NULL;
 			List->CachedNode = List->Head;
 			List->CachedIndex = 1;
+			List->Indexed = 0;
 			List->Length -= Remove;
 		} else {
 			ml_list_node_t *EndNode = ml_list_index(List, End);
 			ml_list_node_t *NextNode = EndNode->Next;
 			EndNode->Next = NULL;
 			Removed->CachedNode = Removed->Head = StartNode;
+			Removed->CachedIndex = 1;
 			Removed->Tail = EndNode;
 			Removed->Length = Remove;
 			NextNode->Prev = PrevNode;
 			PrevNode->Next = NextNode;
 			List->CachedNode = List->Head;
 			List->CachedIndex = 1;
+			List->Indexed = 0;
 			List->Length -= Remove;
 		}
 	}
@@ -1359,6 +1458,7 @@ ML_METHOD("splice", MLListMutableT, MLIntegerT, MLIntegerT, MLListMutableT) {
 		}
 		List->CachedNode = List->Head;
 		List->CachedIndex = 1;
+		List->Indexed = 0;
 	} else {
 		if (Start == 1) {
 			if (End == List->Length) {
@@ -1381,6 +1481,7 @@ ML_METHOD("splice", MLListMutableT, MLIntegerT, MLIntegerT, MLListMutableT) {
 				}
 				List->CachedNode = List->Head;
 				List->CachedIndex = 1;
+				List->Indexed = 0;
 				List->Length -= Remove;
 			}
 		} else {
@@ -1389,6 +1490,7 @@ ML_METHOD("splice", MLListMutableT, MLIntegerT, MLIntegerT, MLListMutableT) {
 			StartNode->Prev = NULL;
 			if (End == List->Length) {
 				Removed->CachedNode = Removed->Head = StartNode;
+				Removed->CachedIndex = 1;
 				Removed->Tail = List->Tail;
 				Removed->Length = Remove;
 				if (Source->Length) {
@@ -1401,12 +1503,14 @@ ML_METHOD("splice", MLListMutableT, MLIntegerT, MLIntegerT, MLListMutableT) {
 				}
 				List->CachedNode = List->Head;
 				List->CachedIndex = 1;
+				List->Indexed = 0;
 				List->Length -= Remove;
 			} else {
 				ml_list_node_t *EndNode = ml_list_index(List, End);
 				ml_list_node_t *NextNode = EndNode->Next;
 				EndNode->Next = NULL;
 				Removed->CachedNode = Removed->Head = StartNode;
+				Removed->CachedIndex = 1;
 				Removed->Tail = EndNode;
 				Removed->Length = Remove;
 				if (Source->Length) {
@@ -1420,6 +1524,7 @@ ML_METHOD("splice", MLListMutableT, MLIntegerT, MLIntegerT, MLListMutableT) {
 				}
 				List->CachedNode = List->Head;
 				List->CachedIndex = 1;
+				List->Indexed = 0;
 				List->Length -= Remove;
 			}
 		}
@@ -1432,6 +1537,8 @@ ML_METHOD("splice", MLListMutableT, MLIntegerT, MLIntegerT, MLListMutableT) {
 	}
 #endif
 	Source->Head = Source->Tail = NULL;
+	Source->Nodes = NULL;
+	Source->Indexed = Source->Capacity = Source->Offset = 0;
 	Source->Length = 0;
 	return (ml_value_t *)Removed;
 }
@@ -1475,6 +1582,7 @@ ML_METHOD("splice", MLListMutableT, MLIntegerT, MLListMutableT) {
 	}
 	List->CachedNode = List->Head;
 	List->CachedIndex = 1;
+	List->Indexed = 0;
 	List->Length += Source->Length;
 #ifdef ML_GENERICS
 	if (Source->Type->Type == MLTypeGenericT) {
@@ -1483,6 +1591,8 @@ ML_METHOD("splice", MLListMutableT, MLIntegerT, MLListMutableT) {
 	}
 #endif
 	Source->Head = Source->Tail = NULL;
+	Source->Nodes = NULL;
+	Source->Indexed = Source->Capacity = Source->Offset = 0;
 	Source->Length = 0;
 	return ml_list();
 }
@@ -1504,6 +1614,7 @@ ML_METHOD("take", MLListMutableT, MLListMutableT) {
 	List->Tail = Source->Tail;
 	List->CachedNode = List->Head;
 	List->CachedIndex = 1;
+	List->Indexed = 0;
 	List->Length += Source->Length;
 #ifdef ML_GENERICS
 	if (Source->Type->Type == MLTypeGenericT) {
@@ -1512,6 +1623,8 @@ ML_METHOD("take", MLListMutableT, MLListMutableT) {
 	}
 #endif
 	Source->Head = Source->Tail = NULL;
+	Source->Nodes = NULL;
+	Source->Indexed = Source->Capacity = Source->Offset = 0;
 	Source->Length = 0;
 	return (ml_value_t *)List;
 }
@@ -1536,6 +1649,7 @@ ML_METHOD("reverse", MLListMutableT) {
 	Prev->Prev = NULL;
 	List->Head = Prev;
 	List->CachedIndex = 1;
+	List->Indexed = 0;
 	List->CachedNode = Prev;
 	return (ml_value_t *)List;
 }
@@ -1602,6 +1716,7 @@ static void ml_list_sort_state_run(ml_list_sort_state_t *State, ml_value_t *Resu
 						State->List->Head = State->Head;
 						State->List->Tail = State->Tail;
 						State->List->CachedIndex = 1;
+						State->List->Indexed = 0;
 						State->List->CachedNode = State->Head;
 						State->List->Length = State->Length;
 						ML_CONTINUE(State->Base.Caller, Result);
@@ -1632,6 +1747,7 @@ finished:
 	State->List->Head = State->Head;
 	State->List->Tail = State->Tail;
 	State->List->CachedIndex = 1;
+	State->List->Indexed = 0;
 	State->List->CachedNode = State->Head;
 	State->List->Length = State->Length;
 	ML_CONTINUE(State->Base.Caller, Result);
@@ -1655,6 +1771,7 @@ ML_METHODX("sort", MLListMutableT, MLFunctionT) {
 	State->InSize = 1;
 	// TODO: Improve ml_list_sort_state_run so that List is still valid during sort
 	List->CachedNode = NULL;
+	List->Indexed = 0;
 	List->Head = List->Tail = NULL;
 	List->Length = 0;
 	return ml_list_sort_state_run(State, NULL);
@@ -1726,6 +1843,7 @@ static void ml_list_method_sort_state_run(ml_list_method_sort_state_t *State, ml
 						State->List->Head = State->Head;
 						State->List->Tail = State->Tail;
 						State->List->CachedIndex = 1;
+						State->List->Indexed = 0;
 						State->List->CachedNode = State->Head;
 						State->List->Length = State->Length;
 						ML_CONTINUE(State->Base.Caller, Result);
@@ -1756,6 +1874,7 @@ finished:
 	State->List->Head = State->Head;
 	State->List->Tail = State->Tail;
 	State->List->CachedIndex = 1;
+	State->List->Indexed = 0;
 	State->List->CachedNode = State->Head;
 	State->List->Length = State->Length;
 #ifdef ML_MATH
@@ -1770,6 +1889,32 @@ finished:
 	ML_CONTINUE(State->Base.Caller, Result);
 }
 
+static int ml_list_sort_native(ml_list_t *List, ml_value_t *Compare, ml_context_t *Context) {
+	int Length = List->Length;
+	ml_value_t **Values = anew(ml_value_t *, Length);
+	ml_list_node_t **Nodes = anew(ml_list_node_t *, Length);
+	int I = 0;
+	for (ml_list_node_t *Node = List->Head; Node; Node = Node->Next, ++I) {
+		Values[I] = Node->Value;
+		Nodes[I] = Node;
+	}
+	if (!ml_values_sort(Context, Compare, Length, Values, (void **)Nodes)) return 0;
+	ml_list_node_t *Prev = NULL;
+	for (I = 0; I < Length; ++I) {
+		ml_list_node_t *Node = Nodes[I];
+		Node->Prev = Prev;
+		if (Prev) Prev->Next = Node;
+		Prev = Node;
+	}
+	Prev->Next = NULL;
+	List->Head = Nodes[0];
+	List->Tail = Prev;
+	List->CachedIndex = 1;
+	List->Indexed = 0;
+	List->CachedNode = List->Head;
+	return 1;
+}
+
 extern ml_value_t *LessMethod;
 
 ML_METHODX("sort", MLListMutableT) {
@@ -1777,6 +1922,7 @@ ML_METHODX("sort", MLListMutableT) {
 //>List
 // Sorts :mini:`List` in-place using :mini:`<=` and returns it.
 	if (!ml_list_length(Args[0])) ML_RETURN(Args[0]);
+	if (ml_list_sort_native((ml_list_t *)Args[0], LessEqualMethod, Caller->Context)) ML_RETURN(Args[0]);
 	ml_list_method_sort_state_t *State = new(ml_list_method_sort_state_t);
 	State->Base.Caller = Caller;
 	State->Base.Context = Caller->Context;
@@ -1790,6 +1936,7 @@ ML_METHODX("sort", MLListMutableT) {
 	State->InSize = 1;
 	// TODO: Improve ml_list_sort_state_run so that List is still valid during sort
 	List->CachedNode = NULL;
+	List->Indexed = 0;
 	List->Head = List->Tail = NULL;
 	List->Length = 0;
 	return ml_list_method_sort_state_run(State, NULL);
@@ -1801,6 +1948,7 @@ ML_METHODX("sort", MLListMutableT, MLMethodT) {
 //>List
 // Sorts :mini:`List` in-place using :mini:`Compare` and returns it.
 	if (!ml_list_length(Args[0])) ML_RETURN(Args[0]);
+	if (ml_list_sort_native((ml_list_t *)Args[0], Args[1], Caller->Context)) ML_RETURN(Args[0]);
 	ml_list_method_sort_state_t *State = new(ml_list_method_sort_state_t);
 	State->Base.Caller = Caller;
 	State->Base.Context = Caller->Context;
@@ -1814,6 +1962,7 @@ ML_METHODX("sort", MLListMutableT, MLMethodT) {
 	State->InSize = 1;
 	// TODO: Improve ml_list_sort_state_run so that List is still valid during sort
 	List->CachedNode = NULL;
+	List->Indexed = 0;
 	List->Head = List->Tail = NULL;
 	List->Length = 0;
 	return ml_list_method_sort_state_run(State, NULL);
@@ -1842,6 +1991,7 @@ static void ml_list_sort2_finish(ml_list_sort2_state_t *State, size_t Length, in
 	*Next = NULL;
 	List->Tail = Prev;
 	List->CachedIndex = 1;
+	List->Indexed = 0;
 	List->CachedNode = List->Head;
 	ML_CONTINUE(State->Base.Caller, List);
 }
@@ -2094,6 +2244,7 @@ static void ml_list_insert(ml_value_t *List0, ml_value_t *Value, ml_list_node_t
 #endif
 	List->CachedNode = List->Tail;
 	List->CachedIndex = ++List->Length;
+	List->Indexed = 0;
 }
 
 ML_METHOD("insert", MLListMutableT, MLIntegerT, MLAnyT) {
@@ -2131,6 +2282,7 @@ static void ml_list_delete(ml_list_t *List, ml_list_node_t *Node) {
 	if (Next) Next->Prev = Prev; else List->Tail = Prev;
 	List->CachedNode = List->Head;
 	List->CachedIndex = 1;
+	List->Indexed = 0;
 	--List->Length;
 	--Node->Index;
 }
@@ -2257,6 +2409,7 @@ ML_METHOD("shuffle", MLListMutableT) {
 	Node = List->Head = Nodes[0];
 	List->CachedNode = Node;
 	List->CachedIndex = 1;
+	List->Indexed = 0;
 	Node->Prev = NULL;
 	for (int I = 1; I < N; ++I) {
 		Node->Next = Nodes[I];
@@ -2294,6 +2447,7 @@ ML_METHOD("permute", MLListMutableT) {
 	Node = List->Head = Nodes[0];
 	List->CachedNode = Node;
 	List->CachedIndex = 1;
+	List->Indexed = 0;
 	Node->Prev = NULL;
 	for (int I = 1; I < N; ++I) {
 		Node->Next = Nodes[I];
@@ -2321,6 +2475,7 @@ ML_METHOD("permute", MLListMutableT, MLListT) {
 		ml_list_node_t *Node = Nodes[Index];
 		if (!Node) {
 			List->Head = List->Tail = List->CachedNode = NULL;
+			List->Indexed = 0;
 			List->Length = 0;
 			return ml_error("ValueError", "Invalid permutation");
 		}
@@ -2333,6 +2488,7 @@ ML_METHOD("permute", MLListMutableT, MLListT) {
 	Prev->Next = NULL;
 	List->CachedNode = List->Head;
 	List->CachedIndex = 1;
+	List->Indexed = 0;
 	return (ml_value_t *)List;
 }
 
@@ -2358,6 +2514,7 @@ ML_METHOD("permute", MLListMutableT, MLPermutationT) {
 	*Next = NULL;
 	List->Tail = Prev;
 	List->CachedIndex = 1;
+	List->Indexed = 0;
 	List->CachedNode = List->Head;
 	return (ml_value_t *)List;
 }
@@ -2421,6 +2578,7 @@ ML_METHOD("cycle", MLListMutableT) {
 	Node = List->Head = Nodes[0];
 	List->CachedNode = Node;
 	List->CachedIndex = 1;
+	List->Indexed = 0;
 	Node->Prev = NULL;
 	for (int I = 1; I < N; ++I) {
 		Node->Next = Nodes[I];
@@ -2467,6 +2625,7 @@ static void ML_TYPED_FN(ml_iter_next, MLListPermutationsT, ml_state_t *Caller, m
 	Node = List->Head = Nodes[0];
 	List->CachedNode = Node;
 	List->CachedIndex = 1;
+	List->Indexed = 0;
 	Node->Prev = NULL;
 	for (int I = 1; I < N; ++I) {
 		Node->Next = Nodes[I];
@@ -2609,7 +2768,15 @@ static void ml_list_const_run(ml_list_visit_t *State, ml_value_t *Value) {
 #ifdef ML_GENERICS
 		}
 #endif
-		ML_LIST_FOREACH(State->Dest, Iter) Iter->Type = MLListNodeT;
+		// Constant lists are indexed without a cursor, see ml_list_index.
+		ml_list_t *List = (ml_list_t *)State->Dest;
+		int Index = 0;
+		ML_LIST_FOREACH(List, Iter) {
+			Iter->Type = MLListNodeT;
+			Iter->Index = ++Index;
+		}
+		List->CachedNode = NULL;
+		List->CachedIndex = 0;
 		ML_RETURN(State->Dest);
 	}
 	State->Node = Node;
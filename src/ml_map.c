@@ -342,23 +342,174 @@ ML_METHODV("grow", MLMapMutableT, MLNamesT) {
 
 extern ml_value_t *CompareMethod;
 
+// Constant maps can be shared between threads, the cached compare method is only replaced when it misses.
+#ifdef ML_THREADS
+#define ML_MAP_CACHED_LOAD(MAP) __atomic_load_n(&(MAP)->Cached, __ATOMIC_ACQUIRE)
+#define ML_MAP_CACHED_STORE(MAP, CACHED) __atomic_store_n(&(MAP)->Cached, CACHED, __ATOMIC_RELEASE)
+#else
+#define ML_MAP_CACHED_LOAD(MAP) (MAP)->Cached
+#define ML_MAP_CACHED_STORE(MAP, CACHED) (MAP)->Cached = (CACHED)
+#endif
+
 static inline ml_value_t *ml_map_compare(ml_map_t *Map, ml_value_t **Args) {
-	ml_method_cached_t *Cached =  ml_method_check_cached(NULL, (ml_method_t *)CompareMethod, Map->Cached, 2, Args);
+	ml_method_cached_t *Old = ML_MAP_CACHED_LOAD(Map);
+	ml_method_cached_t *Cached =  ml_method_check_cached(NULL, (ml_method_t *)CompareMethod, Old, 2, Args);
 	if (!Cached) return ml_no_method_error((ml_method_t *)CompareMethod, 2, Args);
-	Map->Cached = Cached;
+	if (Cached != Old) ML_MAP_CACHED_STORE(Map, Cached);
 	return ml_simple_call(Cached->Callback, 2, Args);
 	//return ml_simple_call(CompareMethod, 2, Args);
 }
 
+static inline int ml_map_key_same(ml_value_t *A, ml_value_t *B) {
+	// Identical strings are always equal, which is the common case with interned keys.
+	return A == B && ml_typeof(A) == MLStringT;
+}
+
+// Once a map has ML_MAP_TABLE_MIN entries, lookups go through an open addressing table of (Hash, Node) pairs instead of walking the tree.
+// The tree is still maintained for ordered maps and insertion, the table is built lazily and discarded whenever the map is emptied.
+// Probing compares the stored hashes first so only entries with matching hashes touch their nodes.
+
+#define ML_MAP_TABLE_MIN 32
+
+typedef struct {
+	long Hash;
+	ml_map_node_t *Node;
+} ml_map_entry_t;
+
+struct ml_map_table_t {
+	size_t Mask, Space;
+	ml_map_entry_t Entries[];
+};
+
+static inline int ml_map_key_equal(ml_map_t *Map, ml_value_t *A, ml_value_t *B) {
+	ml_type_t *TypeA = ml_typeof(A), *TypeB = ml_typeof(B);
+	if (TypeA == MLStringT && TypeB == MLStringT) {
+		if (A == B) return 1;
+		size_t Length = ml_string_length(A);
+		if (Length != ml_string_length(B)) return 0;
+		return !memcmp(ml_string_value(A), ml_string_value(B), Length);
+	}
+#ifndef ML_BIGINT
+#ifdef ML_NANBOXING
+	if ((TypeA == MLInteger32T || TypeA == MLInteger64T) && (TypeB == MLInteger32T || TypeB == MLInteger64T)) {
+#else
+	if (TypeA == MLInteger64T && TypeB == MLInteger64T) {
+#endif
+		return ml_integer_value(A) == ml_integer_value(B);
+	}
+#endif
+	ml_value_t *Args[2] = {A, B};
+	ml_value_t *Result = ml_map_compare(Map, Args);
+	if (ml_is_error(Result)) return 0;
+	return !ml_integer_value(Result);
+}
+
+static inline size_t ml_map_table_index(long Hash) {
+	size_t Index = (size_t)Hash * 0x9E3779B97F4A7C15ULL;
+	return Index ^ (Index >> 32);
+}
+
+static void ml_map_table_put(ml_map_table_t *Table, ml_map_node_t *Node) {
+	size_t Mask = Table->Mask;
+	size_t Index = ml_map_table_index(Node->Hash) & Mask;
+	while (Table->Entries[Index].Node) Index = (Index + 1) & Mask;
+	Table->Entries[Index].Hash = Node->Hash;
+	Table->Entries[Index].Node = Node;
+	--Table->Space;
+}
+
+// Lookups in constant maps shared between threads can build the table concurrently, so a new table is only
+// published with a compare and swap and Map->Table is read with acquire loads.
+
+#ifdef ML_THREADS
+#define ML_MAP_TABLE_LOAD(MAP) __atomic_load_n(&(MAP)->Table, __ATOMIC_ACQUIRE)
+#define ML_MAP_TABLE_STORE(MAP, TABLE) __atomic_store_n(&(MAP)->Table, TABLE, __ATOMIC_RELEASE)
+#else
+#define ML_MAP_TABLE_LOAD(MAP) (MAP)->Table
+#define ML_MAP_TABLE_STORE(MAP, TABLE) (MAP)->Table = (TABLE)
+#endif
+
+static ml_map_table_t *ml_map_table_build(ml_map_t *Map, size_t Size) {
+	ml_map_table_t *Table = xnew(ml_map_table_t, Size, ml_map_entry_t);
+	Table->Mask = Size - 1;
+	Table->Space = Size - (Size >> 2);
+	for (ml_map_node_t *Node = Map->Head; Node; Node = Node->Next) ml_map_table_put(Table, Node);
+	return Table;
+}
+
+static ml_map_table_t *ml_map_table(ml_map_t *Map) {
+	ml_map_table_t *Table = ML_MAP_TABLE_LOAD(Map);
+	if (Table) return Table;
+	size_t Size = 2 * ML_MAP_TABLE_MIN;
+	while (Size - (Size >> 2) <= Map->Size) Size <<= 1;
+	Table = ml_map_table_build(Map, Size);
+#ifdef ML_THREADS
+	ml_map_table_t *Existing = NULL;
+	if (!__atomic_compare_exchange_n(&Map->Table, &Existing, Table, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) return Existing;
+#else
+	Map->Table = Table;
+#endif
+	return Table;
+}
+
+static ml_map_node_t *ml_map_table_find(ml_map_t *Map, long Hash, ml_value_t *Key) {
+	ml_map_table_t *Table = ml_map_table(Map);
+	size_t Mask = Table->Mask;
+	size_t Index = ml_map_table_index(Hash) & Mask;
+	for (;;) {
+		ml_map_entry_t *Entry = Table->Entries + Index;
+		if (!Entry->Node) return NULL;
+		if (Entry->Hash == Hash && ml_map_key_equal(Map, Key, Entry->Node->Key)) return Entry->Node;
+		Index = (Index + 1) & Mask;
+	}
+}
+
+static void ml_map_table_insert(ml_map_t *Map, ml_map_node_t *Node) {
+	ml_map_table_t *Table = Map->Table;
+	if (!Table) {
+		if (Map->Size >= ML_MAP_TABLE_MIN) ml_map_table(Map);
+		return;
+	}
+	if (!Table->Space) {
+		ML_MAP_TABLE_STORE(Map, ml_map_table_build(Map, 2 * (Table->Mask + 1)));
+	} else {
+		ml_map_table_put(Table, Node);
+	}
+}
+
+static void ml_map_table_remove(ml_map_t *Map, ml_map_node_t *Node) {
+	ml_map_table_t *Table = Map->Table;
+	if (!Table) return;
+	size_t Mask = Table->Mask;
+	size_t Index = ml_map_table_index(Node->Hash) & Mask;
+	while (Table->Entries[Index].Node != Node) {
+		if (!Table->Entries[Index].Node) return;
+		Index = (Index + 1) & Mask;
+	}
+	// Backward shift deletion keeps probe sequences intact without tombstones.
+	for (size_t Next = (Index + 1) & Mask; Table->Entries[Next].Node; Next = (Next + 1) & Mask) {
+		size_t Home = ml_map_table_index(Table->Entries[Next].Hash) & Mask;
+		if (((Next - Home) & Mask) >= ((Next - Index) & Mask)) {
+			Table->Entries[Index] = Table->Entries[Next];
+			Index = Next;
+		}
+	}
+	Table->Entries[Index].Node = NULL;
+	++Table->Space;
+}
+
 static ml_map_node_t *ml_map_find_node(ml_map_t *Map, ml_value_t *Key) {
-	ml_map_node_t *Node = Map->Root;
 	long Hash = ml_typeof(Key)->hash(Key, NULL);
+	if (ML_MAP_TABLE_LOAD(Map) || Map->Size >= ML_MAP_TABLE_MIN) return ml_map_table_find(Map, Hash, Key);
+	ml_map_node_t *Node = Map->Root;
 	while (Node) {
 		int Compare;
 		if (Hash < Node->Hash) {
 			Compare = -1;
 		} else if (Hash > Node->Hash) {
 			Compare = 1;
+		} else if (ml_map_key_same(Key, Node->Key)) {
+			Compare = 0;
 		} else {
 			ml_value_t *Args[2] = {Key, Node->Key};
 			ml_value_t *Result = ml_map_compare(Map, Args);
@@ -491,6 +642,8 @@ static ml_map_node_t *ml_map_node_child(ml_map_t *Map, ml_map_node_t *Parent, ml
 		Compare = -1;
 	} else if (Hash > Parent->Hash) {
 		Compare = 1;
+	} else if (ml_map_key_same(Key, Parent->Key)) {
+		Compare = 0;
 	} else {
 		ml_value_t *Args[2] = {Key, Parent->Key};
 		ml_value_t *Result = ml_map_compare(Map, Args);
@@ -527,7 +680,19 @@ static ml_map_node_t *ml_map_node_child(ml_map_t *Map, ml_map_node_t *Parent, ml
 
 static ml_map_node_t *ml_map_node(ml_map_t *Map, ml_map_node_t *Node, long Hash, ml_value_t *Key) {
 	ml_map_node_t *Root = Map->Root;
-	if (Root) return ml_map_node_child(Map, Root, Node, Hash, Key);
+	if (Root) {
+		if (ML_MAP_TABLE_LOAD(Map) || Map->Size >= ML_MAP_TABLE_MIN) {
+			ml_map_node_t *Found = ml_map_table_find(Map, Hash, Key);
+			if (Found) {
+				if (Node) Found->Value = Node->Value;
+				return Found;
+			}
+		}
+		int Size = Map->Size;
+		ml_map_node_t *Child = ml_map_node_child(Map, Root, Node, Hash, Key);
+		if (Map->Size != Size) ml_map_table_insert(Map, Child);
+		return Child;
+	}
 	++Map->Size;
 	if (Node) {
 		Node->Next = Node->Prev = Node->Left = Node->Right = NULL;
@@ -579,6 +744,8 @@ static ml_value_t *ml_map_remove_internal(ml_map_t *Map, ml_map_node_t **Slot, l
 		Compare = -1;
 	} else if (Hash > Node->Hash) {
 		Compare = 1;
+	} else if (ml_map_key_same(Key, Node->Key)) {
+		Compare = 0;
 	} else {
 		ml_value_t *Args[2] = {Key, Node->Key};
 		ml_value_t *Result = ml_map_compare(Map, Args);
@@ -618,7 +785,13 @@ static ml_value_t *ml_map_remove_internal(ml_map_t *Map, ml_map_node_t **Slot, l
 
 ml_value_t *ml_map_delete(ml_value_t *Map0, ml_value_t *Key) {
 	ml_map_t *Map = (ml_map_t *)Map0;
-	return ml_map_remove_internal(Map, &Map->Root, ml_typeof(Key)->hash(Key, NULL), Key);
+	long Hash = ml_typeof(Key)->hash(Key, NULL);
+	if (Map->Table) {
+		ml_map_node_t *Node = ml_map_table_find(Map, Hash, Key);
+		if (!Node) return MLNil;
+		ml_map_table_remove(Map, Node);
+	}
+	return ml_map_remove_internal(Map, &Map->Root, Hash, Key);
 }
 
 int ml_map_foreach(ml_value_t *Value, void *Data, int (*callback)(ml_value_t *, ml_value_t *, void *)) {
@@ -724,6 +897,7 @@ ML_METHODX("filter", MLMapMutableT, MLFunctionT) {
 	State->Base.run = (ml_state_fn)ml_map_filter_state_run;
 	ml_map_node_t *Node = State->Node = Map->Head;
 	Map->Head = Map->Tail = Map->Root = NULL;
+	Map->Table = NULL;
 	Map->Size = 0;
 	Map->Type = MLMapMutableT;
 	State->Map = Map;
@@ -765,6 +939,7 @@ ML_METHODX("remove", MLMapMutableT, MLFunctionT) {
 	State->Base.run = (ml_state_fn)ml_map_remove_state_run;
 	ml_map_node_t *Node = State->Node = Map->Head;
 	Map->Head = Map->Tail = Map->Root = NULL;
+	Map->Table = NULL;
 	Map->Size = 0;
 	Map->Type = MLMapMutableT;
 	State->Map = Map;
@@ -806,6 +981,7 @@ ML_METHODX("filter2", MLMapMutableT, MLFunctionT) {
 	State->Base.run = (ml_state_fn)ml_map_filter2_state_run;
 	ml_map_node_t *Node = State->Node = Map->Head;
 	Map->Head = Map->Tail = Map->Root = NULL;
+	Map->Table = NULL;
 	Map->Size = 0;
 	Map->Type = MLMapMutableT;
 	State->Map = Map;
@@ -847,6 +1023,7 @@ ML_METHODX("remove2", MLMapMutableT, MLFunctionT) {
 	State->Base.run = (ml_state_fn)ml_map_remove2_state_run;
 	ml_map_node_t *Node = State->Node = Map->Head;
 	Map->Head = Map->Tail = Map->Root = NULL;
+	Map->Table = NULL;
 	Map->Size = 0;
 	Map->Type = MLMapMutableT;
 	State->Map = Map;
@@ -1019,6 +1196,7 @@ static ml_map_node_t *ml_map_find_node_string(ml_map_t *Map, ml_value_t *Key) {
 	long Hash = ml_hash(Key);
 	int LengthA = ml_string_length(Key);
 	const char *StringA = ml_string_value(Key);
+	if (ML_MAP_TABLE_LOAD(Map) || Map->Size >= ML_MAP_TABLE_MIN) return ml_map_table_find(Map, Hash, Key);
 	ml_map_node_t *Node = Map->Root;
 	while (Node) {
 		int Compare;
@@ -1107,6 +1285,7 @@ ML_METHOD("::", MLMapStringAnyT, MLStringT) {
 static ml_map_node_t *ml_map_find_node_integer(ml_map_t *Map, ml_value_t *Key) {
 	long Hash = ml_hash(Key);
 	int64_t ValueA = ml_integer_value(Key);
+	if (ML_MAP_TABLE_LOAD(Map) || Map->Size >= ML_MAP_TABLE_MIN) return ml_map_table_find(Map, Hash, Key);
 	ml_map_node_t *Node = Map->Root;
 	while (Node) {
 		int Compare;
@@ -1253,6 +1432,7 @@ ML_METHOD("empty", MLMapMutableT) {
 //$= M:empty
 	ml_map_t *Map = (ml_map_t *)Args[0];
 	Map->Root = Map->Head = Map->Tail = NULL;
+	Map->Table = NULL;
 	Map->Size = 0;
 #ifdef ML_GENERICS
 	Map->Type = MLMapMutableT;
@@ -1450,6 +1630,7 @@ ML_METHOD("splice", MLMapMutableT, MLAnyT, MLMapMutableT) {
 		Next->Prev = Tail;
 	}
 	Source->Root = Source->Head = Source->Tail = NULL;
+	Source->Table = NULL;
 	Source->Size = 0;
 	return (ml_value_t *)Removed;
 }
@@ -1498,6 +1679,7 @@ ML_METHOD("splice", MLMapMutableT, MLAnyT, MLIntegerT, MLMapMutableT) {
 		Next->Prev = Tail;
 	}
 	Source->Root = Source->Head = Source->Tail = NULL;
+	Source->Table = NULL;
 	Source->Size = 0;
 	return (ml_value_t *)Removed;
 }
@@ -1676,6 +1858,7 @@ ML_METHOD("take", MLMapMutableT, MLMapMutableT) {
 		Node = Next;
 	}
 	Source->Root = Source->Head = Source->Tail = NULL;
+	Source->Table = NULL;
 	Source->Size = 0;
 	return (ml_value_t *)Map;
 }
@@ -2075,6 +2258,7 @@ ML_METHODX("sort", MLMapMutableT, MLFunctionT) {
 	State->InSize = 1;
 	// TODO: Improve ml_map_sort_state_run so that List is still valid during sort
 	Map->Head = Map->Tail = NULL;
+	Map->Table = NULL;
 	Map->Size = 0;
 	return ml_map_sort_state_run(State, NULL);
 }
@@ -2100,6 +2284,7 @@ ML_METHODX("sort2", MLMapMutableT, MLFunctionT) {
 	State->InSize = 1;
 	// TODO: Improve ml_map_sort_state_run so that List is still valid during sort
 	Map->Head = Map->Tail = NULL;
+	Map->Table = NULL;
 	Map->Size = 0;
 	return ml_map_sort_state_run(State, NULL);
 }
@@ -2224,6 +2409,7 @@ ML_METHODX("sort", MLMapMutableT) {
 	State->InSize = 1;
 	// TODO: Improve ml_map_sort_state_run so that List is still valid during sort
 	Map->Head = Map->Tail = NULL;
+	Map->Table = NULL;
 	Map->Size = 0;
 	return ml_map_method_sort_state_run(State, NULL);
 }
@@ -2250,6 +2436,7 @@ ML_METHODX("sort", MLMapMutableT, MLMethodT) {
 	State->InSize = 1;
 	// TODO: Improve ml_map_sort_state_run so that List is still valid during sort
 	Map->Head = Map->Tail = NULL;
+	Map->Table = NULL;
 	Map->Size = 0;
 	return ml_map_method_sort_state_run(State, NULL);
 }
@@ -20,17 +20,35 @@ struct ml_method_definition_t {
 	ml_type_t *Types[];
 };
 
+// Cached method resolutions are stored in an insert-only open addressing table.
+// Readers never lock, new entries are published with a release store into an empty slot and the table is replaced by a larger copy when full.
+// Writers (method resolution and definition) are serialized by Lock.
+
+typedef struct {
+	size_t Mask, Space;
+	ml_method_cached_t *Entries[];
+} ml_method_table_t;
+
 struct ml_methods_t {
 	ml_type_t *Type;
 	ml_methods_t *Parent;
-	inthash_t Cache[1];
+	ml_method_table_t *Cache;
 	inthash_t Definitions[1];
 	inthash_t Methods[1];
 #ifdef ML_THREADS
+	inthash_t *Defined;
 	volatile atomic_flag Lock[1];
 #endif
 };
 
+#ifdef ML_THREADS
+#define ML_LOAD_ACQUIRE(TYPE, PTR) atomic_load_explicit((_Atomic(TYPE) *)(PTR), memory_order_acquire)
+#define ML_STORE_RELEASE(TYPE, PTR, VALUE) atomic_store_explicit((_Atomic(TYPE) *)(PTR), VALUE, memory_order_release)
+#else
+#define ML_LOAD_ACQUIRE(TYPE, PTR) *(PTR)
+#define ML_STORE_RELEASE(TYPE, PTR, VALUE) *(PTR) = (VALUE)
+#endif
+
 static void ml_methods_call(ml_state_t *Caller, ml_methods_t *Methods, int Count, ml_value_t **Args) {
 	ml_state_t *State = ml_state(Caller);
 	ml_context_set_static(State->Context, ML_METHODS_INDEX, Methods);
@@ -102,11 +120,11 @@ ML_TYPE(MLMethodIsolatedT, (MLFunctionT), "method::isolated",
 
 static ml_methods_t MLRootMethods[1] = {{
 	MLMethodContextT, NULL,
-	{INTHASH_INIT},
+	NULL,
 	{INTHASH_INIT},
 	{INTHASH_INIT}
 #ifdef ML_THREADS
-	, {ATOMIC_FLAG_INIT}
+	, NULL, {ATOMIC_FLAG_INIT}
 #endif
 }};
 
@@ -133,6 +151,47 @@ static inline void ml_methods_unlock(ml_methods_t *Methods) {
 #endif
 }
 
+static inline int ml_methods_defines(ml_methods_t *Methods, ml_method_t *Method) {
+#ifdef ML_THREADS
+	inthash_t *Defined = ML_LOAD_ACQUIRE(inthash_t *, &Methods->Defined);
+	return Defined && inthash_contains_inline(Defined, (uintptr_t)Method);
+#else
+	return inthash_contains_inline(Methods->Definitions, (uintptr_t)Method);
+#endif
+}
+
+static inline uintptr_t rotl(uintptr_t X, unsigned int N) {
+	const unsigned int Mask = (CHAR_BIT * sizeof(uintptr_t) - 1);
+	return (X << (N & Mask)) | (X >> ((-N) & Mask ));
+}
+
+static inline size_t ml_method_table_index(uintptr_t Hash) {
+	return (Hash >> 4) ^ (Hash >> 12);
+}
+
+static void ml_method_table_insert(ml_method_table_t *Table, uintptr_t Hash, ml_method_cached_t *Cached) {
+	size_t Mask = Table->Mask;
+	size_t Index = ml_method_table_index(Hash) & Mask;
+	while (Table->Entries[Index]) Index = (Index + 1) & Mask;
+	ML_STORE_RELEASE(ml_method_cached_t *, &Table->Entries[Index], Cached);
+	--Table->Space;
+}
+
+static ml_method_table_t *ml_method_table_grow(ml_method_table_t *Old) {
+	size_t Size = Old ? 2 * (Old->Mask + 1) : 16;
+	ml_method_table_t *Table = xnew(ml_method_table_t, Size, ml_method_cached_t *);
+	Table->Mask = Size - 1;
+	Table->Space = Size - Size / 4;
+	if (Old) for (size_t I = 0; I <= Old->Mask; ++I) {
+		ml_method_cached_t *Cached = Old->Entries[I];
+		if (!Cached) continue;
+		uintptr_t Hash = (uintptr_t)Cached->Method;
+		for (int J = Cached->Count; --J >= 0;) Hash = rotl(Hash, 1) ^ (uintptr_t)Cached->Types[J];
+		ml_method_table_insert(Table, Hash, Cached);
+	}
+	return Table;
+}
+
 static __attribute__ ((pure)) unsigned int ml_method_definition_score(ml_method_definition_t *Definition, int Count, ml_type_t **Types) {
 	unsigned int Score = 1;
 	if (Definition->Count > Count) return 0;
@@ -152,7 +211,32 @@ static __attribute__ ((pure)) unsigned int ml_method_definition_score(ml_method_
 
 static ml_method_cached_t *ml_method_search_entry(ml_methods_t *Methods, ml_method_t *Method, int Count, ml_type_t **Types, uint64_t Hash);
 
-static __attribute__ ((noinline)) ml_method_cached_t *ml_method_compute(ml_methods_t *Methods, ml_method_t *Method, int Count, ml_type_t **Types, uint64_t Hash, ml_method_cached_t *Cached) {
+static inline ml_method_cached_t *ml_method_table_search(ml_method_table_t *Table, ml_method_t *Method, int Count, ml_type_t **Types, uint64_t Hash) {
+	if (!Table) return NULL;
+	size_t Mask = Table->Mask;
+	size_t Index = ml_method_table_index(Hash) & Mask;
+	ml_method_cached_t *Cached;
+	while ((Cached = ML_LOAD_ACQUIRE(ml_method_cached_t *, &Table->Entries[Index]))) {
+		if (Cached->Method != Method) goto next;
+		if (Cached->Count != Count) goto next;
+		for (int I = 0; I < Count; ++I) {
+			if (Cached->Types[I] != Types[I]) goto next;
+		}
+		return Cached;
+	next:
+		Index = (Index + 1) & Mask;
+	}
+	return NULL;
+}
+
+static __attribute__ ((noinline)) ml_method_cached_t *ml_method_compute(ml_methods_t *Methods, ml_method_t *Method, int Count, ml_type_t **Types, uint64_t Hash) {
+	ml_methods_lock(Methods);
+	// Another thread may have resolved this signature while we waited for the lock.
+	ml_method_cached_t *Cached = ml_method_table_search(Methods->Cache, Method, Count, Types, Hash);
+	if (Cached && Cached->Callback) {
+		ml_methods_unlock(Methods);
+		return Cached;
+	}
 	unsigned int BestScore = 0;
 	ml_value_t *BestCallback = NULL;
 	ml_method_definition_t *Definition = inthash_search(Methods->Definitions, (uintptr_t)Method);
@@ -175,43 +259,34 @@ static __attribute__ ((noinline)) ml_method_cached_t *ml_method_compute(ml_metho
 		ml_methods_unlock(Methods);
 		return NULL;
 	}
-	if (!Cached) {
+	if (Cached) {
+		Cached->Score = BestScore;
+		ML_STORE_RELEASE(ml_value_t *, &Cached->Callback, BestCallback);
+	} else {
 		Cached = xnew(ml_method_cached_t, Count, ml_type_t *);
 		Cached->Methods = Methods;
 		Cached->Method = Method;
+		Cached->Callback = BestCallback;
 		Cached->Count = Count;
+		Cached->Score = BestScore;
 		for (int I = 0; I < Count; ++I) Cached->Types[I] = Types[I];
-		Cached->Next = inthash_insert(Methods->Cache, Hash, Cached);
 		Cached->MethodNext = inthash_insert(Methods->Methods, (uintptr_t)Method, Cached);
+		ml_method_table_t *Table = Methods->Cache;
+		if (!Table || !Table->Space) {
+			Table = ml_method_table_grow(Table);
+			ML_STORE_RELEASE(ml_method_table_t *, &Methods->Cache, Table);
+		}
+		ml_method_table_insert(Table, Hash, Cached);
 	}
-	Cached->Callback = BestCallback;
-	Cached->Score = BestScore;
 	ml_methods_unlock(Methods);
 	return Cached;
 }
 
 static inline ml_method_cached_t *ml_method_search_entry(ml_methods_t *Methods, ml_method_t *Method, int Count, ml_type_t **Types, uint64_t Hash) {
-	ml_methods_lock(Methods);
-	inthash_t *Cache = Methods->Cache;
-	ml_method_cached_t *Cached = inthash_search_inline(Cache, Hash);
-	while (Cached) {
-		if (Cached->Method != Method) goto next;
-		if (Cached->Count != Count) goto next;
-		for (int I = 0; I < Count; ++I) {
-			if (Cached->Types[I] != Types[I]) goto next;
-		}
-		if (!Cached->Callback) break;
-		ml_methods_unlock(Methods);
-		return Cached;
-	next:
-		Cached = Cached->Next;
-	}
-	return ml_method_compute(Methods, Method, Count, Types, Hash, Cached);
-}
-
-static inline uintptr_t rotl(uintptr_t X, unsigned int N) {
-	const unsigned int Mask = (CHAR_BIT * sizeof(uintptr_t) - 1);
-	return (X << (N & Mask)) | (X >> ((-N) & Mask ));
+	ml_method_table_t *Table = ML_LOAD_ACQUIRE(ml_method_table_t *, &Methods->Cache);
+	ml_method_cached_t *Cached = ml_method_table_search(Table, Method, Count, Types, Hash);
+	if (Cached && ML_LOAD_ACQUIRE(ml_value_t *, &Cached->Callback)) return Cached;
+	return ml_method_compute(Methods, Method, Count, Types, Hash);
 }
 
 static __attribute__ ((noinline)) ml_value_t *ml_method_search2(ml_methods_t *Methods, ml_method_t *Method, int Count, ml_value_t **Args) {
@@ -260,13 +335,7 @@ static __attribute__ ((noinline)) ml_method_cached_t *ml_method_search_cached2(m
 ml_method_cached_t *ml_method_search_cached(ml_methods_t *Methods, ml_method_t *Method, int Count, ml_value_t **Args) {
 	// TODO: Use generation numbers to check Methods->Parent for invalidated definitions
 	Methods = Methods ?: MLRootMethods;
-	while (Methods->Parent) {
-		ml_methods_lock(Methods);
-		void *Present = inthash_search(Methods->Definitions, (uintptr_t)Method);
-		ml_methods_unlock(Methods);
-		if (Present) break;
-		Methods = Methods->Parent;
-	}
+	while (Methods->Parent && !ml_methods_defines(Methods, Method)) Methods = Methods->Parent;
 	if (Count > ML_SMALL_METHOD_COUNT) return ml_method_search_cached2(Methods, Method, Count, Args);
 	ml_type_t *Types[ML_SMALL_METHOD_COUNT];
 	uintptr_t Hash = (uintptr_t)Method;
@@ -280,13 +349,7 @@ ml_method_cached_t *ml_method_search_cached(ml_methods_t *Methods, ml_method_t *
 ml_method_cached_t *ml_method_check_cached(ml_methods_t *Methods, ml_method_t *Method, ml_method_cached_t *Cached, int Count, ml_value_t **Args) {
 	// TODO: Use generation numbers to check Methods->Parent for invalidated definitions
 	Methods = Methods ?: MLRootMethods;
-	while (Methods->Parent) {
-		ml_methods_lock(Methods);
-		void *Present = inthash_search(Methods->Definitions, (uintptr_t)Method);
-		ml_methods_unlock(Methods);
-		if (Present) break;
-		Methods = Methods->Parent;
-	}
+	while (Methods->Parent && !ml_methods_defines(Methods, Method)) Methods = Methods->Parent;
 	if (Cached && Cached->Methods == Methods) {
 		if (!Cached->Callback) goto missed;
 		if (Cached->Count != Count) goto missed;
@@ -306,6 +369,30 @@ missed:
 	return ml_method_search_entry(Methods, Method, Count, Types, Hash);
 }
 
+uint64_t MLMethodEpoch = 0;
+
+ml_value_t *ml_method_inline_update(ml_methods_t *Methods, ml_method_t *Method, ml_method_inline_cache_t **Slot, int Count, ml_value_t **Args) {
+	uint64_t Epoch = ML_LOAD_ACQUIRE(uint64_t, &MLMethodEpoch);
+	ml_method_cached_t *Cached = ml_method_search_cached(Methods, Method, Count, Args);
+	if (!Cached) return NULL;
+	ml_value_t *Callback = Cached->Callback;
+	ml_method_inline_cache_t *Old = ML_LOAD_ACQUIRE(ml_method_inline_cache_t *, Slot);
+	int Size = 0;
+	if (Old && Old->Methods == Methods && Old->Epoch == Epoch) {
+		// Megamorphic call sites are left as is and fall back to the full search.
+		if (Old->Size == ML_METHOD_INLINE_CACHE_SIZE) return Callback;
+		Size = Old->Size;
+	}
+	ml_method_inline_cache_t *Cache = new(ml_method_inline_cache_t);
+	Cache->Methods = Methods;
+	Cache->Epoch = Epoch;
+	for (int I = 0; I < Size; ++I) Cache->Entries[I] = Old->Entries[I];
+	Cache->Entries[Size] = Cached;
+	Cache->Size = Size + 1;
+	ML_STORE_RELEASE(ml_method_inline_cache_t *, Slot, Cache);
+	return Callback;
+}
+
 void ml_method_insert(ml_methods_t *Methods, ml_method_t *Method, ml_value_t *Callback, int Count, ml_type_t *Variadic, ml_type_t **Types) {
 	if (!ml_is((ml_value_t *)Method, MLMethodT)) {
 		fprintf(stderr, "Internal error: attempting to define method for non-method value\n");
@@ -318,12 +405,31 @@ void ml_method_insert(ml_methods_t *Methods, ml_method_t *Method, ml_value_t *Ca
 	memcpy(Definition->Types, Types, Count * sizeof(ml_type_t *));
 	ml_methods_lock(Methods);
 	Definition->Next = inthash_insert(Methods->Definitions, (uintptr_t)Method, Definition);
+#ifdef ML_THREADS
+	if (!Definition->Next && Methods->Parent) {
+		// Child contexts publish an immutable copy of their defined methods for lock-free lookups.
+		size_t Size = Methods->Definitions->Size;
+		inthash_t *Defined = new(inthash_t);
+		Defined->Size = Size;
+		Defined->Space = Methods->Definitions->Space;
+		Defined->Keys = anew(uintptr_t, Size);
+		memcpy(Defined->Keys, Methods->Definitions->Keys, Size * sizeof(uintptr_t));
+		Defined->Values = anew(void *, Size);
+		memcpy(Defined->Values, Methods->Definitions->Values, Size * sizeof(void *));
+		ML_STORE_RELEASE(inthash_t *, &Methods->Defined, Defined);
+	}
+#endif
 	ml_method_cached_t *Cached = inthash_search(Methods->Methods, (uintptr_t)Method);
 	while (Cached) {
 		// TODO: Only invalidate cached entries that are superseeded by this definition
-		Cached->Callback = NULL;
+		ML_STORE_RELEASE(ml_value_t *, &Cached->Callback, NULL);
 		Cached = Cached->MethodNext;
 	}
+#ifdef ML_THREADS
+	atomic_fetch_add((_Atomic uint64_t *)&MLMethodEpoch, 1);
+#else
+	++MLMethodEpoch;
+#endif
 	ml_methods_unlock(Methods);
 }
 
@@ -391,9 +497,7 @@ ML_METHOD_ANON(MLMethodDefault, "method::default");
 static void ml_method_call(ml_state_t *Caller, ml_value_t *Value, int Count, ml_value_t **Args) {
 	ml_method_t *Method = (ml_method_t *)Value;
 	ml_methods_t *Methods = ml_context_get_static(Caller->Context, ML_METHODS_INDEX);
-	while (Methods->Parent && !inthash_contains_inline(Methods->Definitions, (uintptr_t)Method)) {
-		Methods = Methods->Parent;
-	}
+	while (Methods->Parent && !ml_methods_defines(Methods, Method)) Methods = Methods->Parent;
 	ml_value_t *Callback = ml_method_search(Methods, Method, Count, Args);
 	if (__builtin_expect(Callback != NULL, 1)) {
 		return ml_call(Caller, Callback, Count, Args);
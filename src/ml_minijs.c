@@ -401,7 +401,7 @@ static int ml_closure_find_labels(ml_inst_t *Inst, uintptr_t *Offset) {
 }
 
 static int ml_closure_inst_encode(ml_inst_t *Inst, ml_minijs_encoder_t *Encoder, ml_value_t *Json, inthash_t *Labels, ml_decls_json_t *Decls) {
-	ml_list_put(Json, ml_integer(Inst->Opcode));
+	ml_list_put(Json, ml_integer(MLInstFusions[Inst->Opcode][0]));
 	ml_list_put(Json, ml_integer(Inst->Line));
 	switch (MLInstTypes[Inst->Opcode]) {
 	case MLIT_NONE:
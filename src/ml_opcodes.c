@@ -71,6 +71,16 @@ const char *MLInstNames[] = {
 	[MLI_VAR_TYPE] = "var_type",
 	[MLI_WITH] = "with",
 	[MLI_WITHX] = "withx",
+	[MLI_LOAD_PUSH_CALL_METHOD] = "load_push_call_method",
+	[MLI_LOCAL_PUSH_CALL_METHOD] = "local_push_call_method",
+	[MLI_LOCAL_PUSH_LOAD_PUSH] = "local_push_load_push",
+	[MLI_LOCAL_PUSH_LOCAL_PUSH] = "local_push_local_push",
+	[MLI_PUSH_CALL] = "push_call",
+	[MLI_PUSH_CALL_METHOD] = "push_call_method",
+	[MLI_PUSH_LOCAL_PUSH] = "push_local_push",
+	[MLI_PUSH_TAIL_CALL_METHOD] = "push_tail_call_method",
+	[MLI_UPVALUE_PUSH] = "upvalue_push",
+	[MLI_WITH_LOCAL_PUSH] = "with_local_push",
 };
 
 const ml_inst_type_t MLInstTypes[] = {
@@ -144,5 +154,98 @@ const ml_inst_type_t MLInstTypes[] = {
 	[MLI_VAR_TYPE] = MLIT_COUNT,
 	[MLI_WITH] = MLIT_DECL,
 	[MLI_WITHX] = MLIT_COUNT_DECL,
+	[MLI_LOAD_PUSH_CALL_METHOD] = MLIT_VALUE,
+	[MLI_LOCAL_PUSH_CALL_METHOD] = MLIT_COUNT,
+	[MLI_LOCAL_PUSH_LOAD_PUSH] = MLIT_COUNT,
+	[MLI_LOCAL_PUSH_LOCAL_PUSH] = MLIT_COUNT,
+	[MLI_PUSH_CALL] = MLIT_NONE,
+	[MLI_PUSH_CALL_METHOD] = MLIT_NONE,
+	[MLI_PUSH_LOCAL_PUSH] = MLIT_NONE,
+	[MLI_PUSH_TAIL_CALL_METHOD] = MLIT_NONE,
+	[MLI_UPVALUE_PUSH] = MLIT_COUNT,
+	[MLI_WITH_LOCAL_PUSH] = MLIT_DECL,
+};
+
+const ml_opcode_t MLInstFusions[][2] = {
+	[MLI_AND] = {MLI_AND, MLI_AND},
+	[MLI_AND_POP] = {MLI_AND_POP, MLI_AND_POP},
+	[MLI_ASSIGN] = {MLI_ASSIGN, MLI_ASSIGN},
+	[MLI_ASSIGN_LOCAL] = {MLI_ASSIGN_LOCAL, MLI_ASSIGN_LOCAL},
+	[MLI_CALL] = {MLI_CALL, MLI_CALL},
+	[MLI_CALL_CONST] = {MLI_CALL_CONST, MLI_CALL_CONST},
+	[MLI_CALL_METHOD] = {MLI_CALL_METHOD, MLI_CALL_METHOD},
+	[MLI_CATCH] = {MLI_CATCH, MLI_CATCH},
+	[MLI_CATCHX] = {MLI_CATCHX, MLI_CATCHX},
+	[MLI_CLOSURE] = {MLI_CLOSURE, MLI_CLOSURE},
+	[MLI_CLOSURE_TYPED] = {MLI_CLOSURE_TYPED, MLI_CLOSURE_TYPED},
+	[MLI_ENTER] = {MLI_ENTER, MLI_ENTER},
+	[MLI_EXIT] = {MLI_EXIT, MLI_EXIT},
+	[MLI_FOR] = {MLI_FOR, MLI_FOR},
+	[MLI_GOTO] = {MLI_GOTO, MLI_GOTO},
+	[MLI_IF_CONFIG] = {MLI_IF_CONFIG, MLI_IF_CONFIG},
+	[MLI_ITER] = {MLI_ITER, MLI_ITER},
+	[MLI_KEY] = {MLI_KEY, MLI_KEY},
+	[MLI_LET] = {MLI_LET, MLI_LET},
+	[MLI_LETI] = {MLI_LETI, MLI_LETI},
+	[MLI_LETX] = {MLI_LETX, MLI_LETX},
+	[MLI_LINK] = {MLI_LINK, MLI_LINK},
+	[MLI_LIST_APPEND] = {MLI_LIST_APPEND, MLI_LIST_APPEND},
+	[MLI_LIST_NEW] = {MLI_LIST_NEW, MLI_LIST_NEW},
+	[MLI_LOAD] = {MLI_LOAD, MLI_LOAD},
+	[MLI_LOAD_PUSH] = {MLI_LOAD_PUSH, MLI_LOAD_PUSH},
+	[MLI_LOAD_VAR] = {MLI_LOAD_VAR, MLI_LOAD_VAR},
+	[MLI_LOCAL] = {MLI_LOCAL, MLI_LOCAL},
+	[MLI_LOCALI] = {MLI_LOCALI, MLI_LOCALI},
+	[MLI_LOCAL_PUSH] = {MLI_LOCAL_PUSH, MLI_LOCAL_PUSH},
+	[MLI_MAP_INSERT] = {MLI_MAP_INSERT, MLI_MAP_INSERT},
+	[MLI_MAP_NEW] = {MLI_MAP_NEW, MLI_MAP_NEW},
+	[MLI_NEXT] = {MLI_NEXT, MLI_NEXT},
+	[MLI_NIL] = {MLI_NIL, MLI_NIL},
+	[MLI_NIL_PUSH] = {MLI_NIL_PUSH, MLI_NIL_PUSH},
+	[MLI_NOT] = {MLI_NOT, MLI_NOT},
+	[MLI_OR] = {MLI_OR, MLI_OR},
+	[MLI_PARAM_TYPE] = {MLI_PARAM_TYPE, MLI_PARAM_TYPE},
+	[MLI_PARTIAL_NEW] = {MLI_PARTIAL_NEW, MLI_PARTIAL_NEW},
+	[MLI_PARTIAL_SET] = {MLI_PARTIAL_SET, MLI_PARTIAL_SET},
+	[MLI_POP] = {MLI_POP, MLI_POP},
+	[MLI_PUSH] = {MLI_PUSH, MLI_PUSH},
+	[MLI_REF] = {MLI_REF, MLI_REF},
+	[MLI_REFI] = {MLI_REFI, MLI_REFI},
+	[MLI_REFX] = {MLI_REFX, MLI_REFX},
+	[MLI_RESOLVE] = {MLI_RESOLVE, MLI_RESOLVE},
+	[MLI_RESUME] = {MLI_RESUME, MLI_RESUME},
+	[MLI_RETRY] = {MLI_RETRY, MLI_RETRY},
+	[MLI_RETURN] = {MLI_RETURN, MLI_RETURN},
+	[MLI_STRING_ADD] = {MLI_STRING_ADD, MLI_STRING_ADD},
+	[MLI_STRING_ADDS] = {MLI_STRING_ADDS, MLI_STRING_ADDS},
+	[MLI_STRING_ADD_1] = {MLI_STRING_ADD_1, MLI_STRING_ADD_1},
+	[MLI_STRING_END] = {MLI_STRING_END, MLI_STRING_END},
+	[MLI_STRING_NEW] = {MLI_STRING_NEW, MLI_STRING_NEW},
+	[MLI_STRING_POP] = {MLI_STRING_POP, MLI_STRING_POP},
+	[MLI_SUSPEND] = {MLI_SUSPEND, MLI_SUSPEND},
+	[MLI_SWITCH] = {MLI_SWITCH, MLI_SWITCH},
+	[MLI_TAIL_CALL] = {MLI_TAIL_CALL, MLI_TAIL_CALL},
+	[MLI_TAIL_CALL_CONST] = {MLI_TAIL_CALL_CONST, MLI_TAIL_CALL_CONST},
+	[MLI_TAIL_CALL_METHOD] = {MLI_TAIL_CALL_METHOD, MLI_TAIL_CALL_METHOD},
+	[MLI_TRY] = {MLI_TRY, MLI_TRY},
+	[MLI_TUPLE_NEW] = {MLI_TUPLE_NEW, MLI_TUPLE_NEW},
+	[MLI_UPVALUE] = {MLI_UPVALUE, MLI_UPVALUE},
+	[MLI_VALUE_1] = {MLI_VALUE_1, MLI_VALUE_1},
+	[MLI_VALUE_2] = {MLI_VALUE_2, MLI_VALUE_2},
+	[MLI_VAR] = {MLI_VAR, MLI_VAR},
+	[MLI_VARX] = {MLI_VARX, MLI_VARX},
+	[MLI_VAR_TYPE] = {MLI_VAR_TYPE, MLI_VAR_TYPE},
+	[MLI_WITH] = {MLI_WITH, MLI_WITH},
+	[MLI_WITHX] = {MLI_WITHX, MLI_WITHX},
+	[MLI_LOAD_PUSH_CALL_METHOD] = {MLI_LOAD_PUSH, MLI_CALL_METHOD},
+	[MLI_LOCAL_PUSH_CALL_METHOD] = {MLI_LOCAL_PUSH, MLI_CALL_METHOD},
+	[MLI_LOCAL_PUSH_LOAD_PUSH] = {MLI_LOCAL_PUSH, MLI_LOAD_PUSH},
+	[MLI_LOCAL_PUSH_LOCAL_PUSH] = {MLI_LOCAL_PUSH, MLI_LOCAL_PUSH},
+	[MLI_PUSH_CALL] = {MLI_PUSH, MLI_CALL},
+	[MLI_PUSH_CALL_METHOD] = {MLI_PUSH, MLI_CALL_METHOD},
+	[MLI_PUSH_LOCAL_PUSH] = {MLI_PUSH, MLI_LOCAL_PUSH},
+	[MLI_PUSH_TAIL_CALL_METHOD] = {MLI_PUSH, MLI_TAIL_CALL_METHOD},
+	[MLI_UPVALUE_PUSH] = {MLI_UPVALUE, MLI_PUSH},
+	[MLI_WITH_LOCAL_PUSH] = {MLI_WITH, MLI_LOCAL_PUSH},
 };
 
@@ -1,7 +1,7 @@
 #ifndef ML_OPCODES_H
 #define ML_OPCODES_H
 
-#define ML_BYTECODE_VERSION 5
+#define ML_BYTECODE_VERSION 6
 
 typedef enum {
 	MLI_AND = 0,
@@ -74,8 +74,20 @@ typedef enum {
 	MLI_VAR_TYPE = 67,
 	MLI_WITH = 68,
 	MLI_WITHX = 69,
+	MLI_LOAD_PUSH_CALL_METHOD = 70,
+	MLI_LOCAL_PUSH_CALL_METHOD = 71,
+	MLI_LOCAL_PUSH_LOAD_PUSH = 72,
+	MLI_LOCAL_PUSH_LOCAL_PUSH = 73,
+	MLI_PUSH_CALL = 74,
+	MLI_PUSH_CALL_METHOD = 75,
+	MLI_PUSH_LOCAL_PUSH = 76,
+	MLI_PUSH_TAIL_CALL_METHOD = 77,
+	MLI_UPVALUE_PUSH = 78,
+	MLI_WITH_LOCAL_PUSH = 79,
 } ml_opcode_t;
 
+#define ML_OPCODE_COUNT 80
+
 typedef enum {
 	MLIT_CLOSURE,
 	MLIT_COUNT,
@@ -97,5 +109,6 @@ typedef enum {
 
 extern const char *MLInstNames[];
 extern const ml_inst_type_t MLInstTypes[];
+extern const ml_opcode_t MLInstFusions[][2];
 
 #endif
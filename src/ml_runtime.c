@@ -1297,6 +1297,7 @@ ml_scheduler_queue_t *ml_default_queue_init(ml_context_t *Context, int Slice) {
 #ifdef ML_HOSTTHREADS
 
 #include <semaphore.h>
+#include <stdatomic.h>
 
 typedef struct ml_scheduler_thread_t ml_scheduler_thread_t;
 
@@ -1421,6 +1422,169 @@ ml_value_t *ml_call_wait(ml_context_t *Context, ml_value_t *Fn, int Count, ml_va
 	return State.Value;
 }
 
+// Scheduler pools run queued states on several host threads.
+// Each worker owns a queue, new states are added to the current worker's queue and idle workers steal from the others.
+// The thread calling Scheduler->run (normally the main thread) acts as worker 0.
+
+typedef struct {
+	ml_scheduler_pool_t *Pool;
+	int Index;
+} ml_scheduler_worker_t;
+
+struct ml_scheduler_pool_t {
+	ml_scheduler_t Base;
+	ml_scheduler_queue_t **Queues;
+	pthread_mutex_t Lock[1];
+	pthread_cond_t Available[1];
+	uint64_t Slice;
+	int NumWorkers;
+	_Atomic int NumIdle;
+};
+
+static __thread ml_scheduler_worker_t CurrentWorker = {NULL, 0};
+
+#ifndef ML_TIMESCHED
+__thread uint64_t MLWorkerCounter = UINT_MAX;
+#endif
+
+static int ml_scheduler_pool_index(ml_scheduler_pool_t *Pool) {
+	return CurrentWorker.Pool == Pool ? CurrentWorker.Index : 0;
+}
+
+static int ml_scheduler_pool_add(ml_scheduler_pool_t *Pool, ml_state_t *State, ml_value_t *Value) {
+	int Fill = ml_scheduler_queue_add(Pool->Queues[ml_scheduler_pool_index(Pool)], State, Value);
+	atomic_thread_fence(memory_order_seq_cst);
+	if (atomic_load(&Pool->NumIdle)) {
+		pthread_mutex_lock(Pool->Lock);
+		pthread_cond_signal(Pool->Available);
+		pthread_mutex_unlock(Pool->Lock);
+	}
+	return Fill;
+}
+
+static int ml_scheduler_pool_fill(ml_scheduler_pool_t *Pool) {
+	int Fill = 0;
+	for (int I = 0; I < Pool->NumWorkers; ++I) Fill += Pool->Queues[I]->Base.Fill;
+	return Fill;
+}
+
+static ml_queued_state_t ml_scheduler_pool_next(ml_scheduler_pool_t *Pool, int Index) {
+	int NumWorkers = Pool->NumWorkers;
+	for (;;) {
+		for (int I = 0; I < NumWorkers; ++I) {
+			ml_queued_state_t Next = ml_scheduler_queue_next(Pool->Queues[(Index + I) % NumWorkers]);
+			if (Next.State) return Next;
+		}
+		pthread_mutex_lock(Pool->Lock);
+		atomic_fetch_add(&Pool->NumIdle, 1);
+		atomic_thread_fence(memory_order_seq_cst);
+		// Recheck under the lock, ml_scheduler_pool_add() signals after writing so no wakeups are lost.
+		if (!ml_scheduler_pool_fill(Pool)) pthread_cond_wait(Pool->Available, Pool->Lock);
+		atomic_fetch_sub(&Pool->NumIdle, 1);
+		pthread_mutex_unlock(Pool->Lock);
+	}
+}
+
+static void ml_scheduler_pool_run(ml_scheduler_pool_t *Pool) {
+	ml_queued_state_t Queued = ml_scheduler_pool_next(Pool, ml_scheduler_pool_index(Pool));
+#ifndef ML_TIMESCHED
+	MLWorkerCounter = Pool->Slice;
+#endif
+	Queued.State->run(Queued.State, Queued.Value);
+}
+
+static void *ml_scheduler_pool_fn(ml_scheduler_worker_t *Worker) {
+#ifdef Darwin
+	pthread_setname_np("minilang");
+#endif
+	CurrentWorker = *Worker;
+	ml_scheduler_pool_t *Pool = Worker->Pool;
+	GC_add_roots(MLArgCache, MLArgCache + ML_ARG_CACHE_SIZE);
+	for (;;) ml_scheduler_pool_run(Pool);
+	return NULL;
+}
+
+typedef struct {
+	ml_scheduler_t *Scheduler;
+	ml_state_t *State;
+	ml_value_t *Result;
+	double Duration;
+} ml_scheduler_sleeper_t;
+
+static void *ml_scheduler_sleeper_fn(ml_scheduler_sleeper_t *Sleeper) {
+	struct timespec Remainder;
+	double Seconds;
+	Remainder.tv_nsec = modf(Sleeper->Duration, &Seconds) * 1000000000;
+	Remainder.tv_sec = Seconds;
+	ml_value_t *Result = Sleeper->Result;
+	while (nanosleep(&Remainder, &Remainder)) {
+		if (errno != EINTR) {
+			Result = ml_error("SleepError", "Failed to sleep");
+			break;
+		}
+	}
+	Sleeper->Scheduler->add(Sleeper->Scheduler, Sleeper->State, Result);
+	return NULL;
+}
+
+static void ml_scheduler_pool_sleep(ml_scheduler_t *Scheduler, ml_state_t *State, double Duration, ml_value_t *Result) {
+	// Workers never block, the sleeping state is requeued from a short lived thread instead.
+	ml_scheduler_sleeper_t *Sleeper = new(ml_scheduler_sleeper_t);
+	Sleeper->Scheduler = Scheduler;
+	Sleeper->State = State;
+	Sleeper->Result = Result;
+	Sleeper->Duration = Duration;
+	pthread_attr_t Attr;
+	pthread_attr_init(&Attr);
+	pthread_attr_setdetachstate(&Attr, PTHREAD_CREATE_DETACHED);
+	pthread_t Thread;
+	if (GC_pthread_create(&Thread, &Attr, (void *)ml_scheduler_sleeper_fn, Sleeper)) {
+		Scheduler->add(Scheduler, State, ml_error("SleepError", "Failed to sleep"));
+	}
+}
+
+ml_scheduler_pool_t *ml_scheduler_pool(int NumWorkers, int Slice) {
+	if (NumWorkers < 1) NumWorkers = 1;
+	ml_scheduler_pool_t *Pool = new(ml_scheduler_pool_t);
+	Pool->Base.add = (ml_scheduler_add_fn)ml_scheduler_pool_add;
+	Pool->Base.run = (ml_scheduler_run_fn)ml_scheduler_pool_run;
+	Pool->Base.fill = (ml_scheduler_fill_fn)ml_scheduler_pool_fill;
+	Pool->Base.sleep = ml_scheduler_pool_sleep;
+	Pool->NumWorkers = NumWorkers;
+	Pool->Queues = anew(ml_scheduler_queue_t *, NumWorkers);
+	// Only the first queue is given the slice so that ML_TIMESCHED starts a single timer.
+	for (int I = 0; I < NumWorkers; ++I) Pool->Queues[I] = ml_scheduler_queue(I ? 0 : Slice);
+	pthread_mutex_init(Pool->Lock, NULL);
+	pthread_cond_init(Pool->Available, NULL);
+	Pool->Slice = Slice;
+	CurrentWorker.Pool = Pool;
+	CurrentWorker.Index = 0;
+	for (int I = 1; I < NumWorkers; ++I) {
+		ml_scheduler_worker_t *Worker = new(ml_scheduler_worker_t);
+		Worker->Pool = Pool;
+		Worker->Index = I;
+		pthread_attr_t Attr;
+		pthread_attr_init(&Attr);
+		pthread_attr_setdetachstate(&Attr, PTHREAD_CREATE_DETACHED);
+		pthread_t Thread;
+		GC_pthread_create(&Thread, &Attr, (void *)ml_scheduler_pool_fn, Worker);
+#ifndef Darwin
+		pthread_setname_np(Thread, "minilang");
+#endif
+	}
+	return Pool;
+}
+
+ml_scheduler_pool_t *ml_default_pool_init(ml_context_t *Context, int NumWorkers, int Slice) {
+	ml_scheduler_pool_t *Pool = ml_scheduler_pool(NumWorkers, Slice);
+	ml_context_set_static(Context, ML_SCHEDULER_INDEX, Pool);
+#ifndef ML_TIMESCHED
+	// States can move between workers, so each worker thread uses MLWorkerCounter.
+	ml_context_set_static(Context, ML_COUNTER_INDEX, NULL);
+#endif
+	return Pool;
+}
+
 #else
 
 ml_value_t *ml_call_wait(ml_context_t *Context, ml_value_t *Fn, int Count, ml_value_t **Args) {
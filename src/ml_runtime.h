@@ -292,6 +292,13 @@ extern volatile int MLPreempt;
 
 #endif
 
+#if defined(ML_SCHEDULER) && defined(ML_HOSTTHREADS) && !defined(ML_TIMESCHED)
+
+// Contexts run by a scheduler pool publish a NULL counter, each worker thread counts down its own slice instead.
+extern __thread uint64_t MLWorkerCounter;
+
+#endif
+
 typedef struct ml_scheduler_t ml_scheduler_t;
 
 typedef int (*ml_scheduler_add_fn)(ml_scheduler_t *Scheduler, ml_state_t *State, ml_value_t *Value);
@@ -373,6 +380,15 @@ void ml_threads_set_max_count(int Max);
 void ml_scheduler_split(ml_scheduler_t *Scheduler);
 void ml_scheduler_join(ml_scheduler_t *Scheduler);
 
+#ifdef ML_SCHEDULER
+
+typedef struct ml_scheduler_pool_t ml_scheduler_pool_t;
+
+ml_scheduler_pool_t *ml_scheduler_pool(int NumWorkers, int Slice);
+ml_scheduler_pool_t *ml_default_pool_init(ml_context_t *Context, int NumWorkers, int Slice);
+
+#endif
+
 #endif
 
 // Locks
@@ -142,17 +142,157 @@ ML_METHODVX("grow", MLSetMutableT, MLSequenceT) {
 
 extern ml_value_t *CompareMethod;
 
+// Constant sets can be shared between threads, the cached compare method is only replaced when it misses.
+#ifdef ML_THREADS
+#define ML_SET_CACHED_LOAD(SET) __atomic_load_n(&(SET)->Cached, __ATOMIC_ACQUIRE)
+#define ML_SET_CACHED_STORE(SET, CACHED) __atomic_store_n(&(SET)->Cached, CACHED, __ATOMIC_RELEASE)
+#else
+#define ML_SET_CACHED_LOAD(SET) (SET)->Cached
+#define ML_SET_CACHED_STORE(SET, CACHED) (SET)->Cached = (CACHED)
+#endif
+
 static inline ml_value_t *ml_set_compare(ml_set_t *Set, ml_value_t **Args) {
-	ml_method_cached_t *Cached =  ml_method_check_cached(NULL, (ml_method_t *)CompareMethod, Set->Cached, 2, Args);
+	ml_method_cached_t *Old = ML_SET_CACHED_LOAD(Set);
+	ml_method_cached_t *Cached =  ml_method_check_cached(NULL, (ml_method_t *)CompareMethod, Old, 2, Args);
 	if (!Cached) return ml_no_method_error((ml_method_t *)CompareMethod, 2, Args);
-	Set->Cached = Cached;
+	if (Cached != Old) ML_SET_CACHED_STORE(Set, Cached);
 	return ml_simple_call(Cached->Callback, 2, Args);
 	//return ml_simple_call(CompareMethod, 2, Args);
 }
 
+// Large sets use an open addressing table for lookups, see the corresponding comment in ml_map.c.
+
+#define ML_SET_TABLE_MIN 32
+
+typedef struct {
+	long Hash;
+	ml_set_node_t *Node;
+} ml_set_entry_t;
+
+struct ml_set_table_t {
+	size_t Mask, Space;
+	ml_set_entry_t Entries[];
+};
+
+static inline int ml_set_key_equal(ml_set_t *Set, ml_value_t *A, ml_value_t *B) {
+	ml_type_t *TypeA = ml_typeof(A), *TypeB = ml_typeof(B);
+	if (TypeA == MLStringT && TypeB == MLStringT) {
+		size_t Length = ml_string_length(A);
+		if (Length != ml_string_length(B)) return 0;
+		return !memcmp(ml_string_value(A), ml_string_value(B), Length);
+	}
+#ifndef ML_BIGINT
+#ifdef ML_NANBOXING
+	if ((TypeA == MLInteger32T || TypeA == MLInteger64T) && (TypeB == MLInteger32T || TypeB == MLInteger64T)) {
+#else
+	if (TypeA == MLInteger64T && TypeB == MLInteger64T) {
+#endif
+		return ml_integer_value(A) == ml_integer_value(B);
+	}
+#endif
+	ml_value_t *Args[2] = {A, B};
+	ml_value_t *Result = ml_set_compare(Set, Args);
+	if (ml_is_error(Result)) return 0;
+	return !ml_integer_value(Result);
+}
+
+static inline size_t ml_set_table_index(long Hash) {
+	size_t Index = (size_t)Hash * 0x9E3779B97F4A7C15ULL;
+	return Index ^ (Index >> 32);
+}
+
+static void ml_set_table_put(ml_set_table_t *Table, ml_set_node_t *Node) {
+	size_t Mask = Table->Mask;
+	size_t Index = ml_set_table_index(Node->Hash) & Mask;
+	while (Table->Entries[Index].Node) Index = (Index + 1) & Mask;
+	Table->Entries[Index].Hash = Node->Hash;
+	Table->Entries[Index].Node = Node;
+	--Table->Space;
+}
+
+// Lookups in constant sets shared between threads can build the table concurrently, so a new table is only
+// published with a compare and swap and Set->Table is read with acquire loads.
+
+#ifdef ML_THREADS
+#define ML_SET_TABLE_LOAD(SET) __atomic_load_n(&(SET)->Table, __ATOMIC_ACQUIRE)
+#define ML_SET_TABLE_STORE(SET, TABLE) __atomic_store_n(&(SET)->Table, TABLE, __ATOMIC_RELEASE)
+#else
+#define ML_SET_TABLE_LOAD(SET) (SET)->Table
+#define ML_SET_TABLE_STORE(SET, TABLE) (SET)->Table = (TABLE)
+#endif
+
+static ml_set_table_t *ml_set_table_build(ml_set_t *Set, size_t Size) {
+	ml_set_table_t *Table = xnew(ml_set_table_t, Size, ml_set_entry_t);
+	Table->Mask = Size - 1;
+	Table->Space = Size - (Size >> 2);
+	for (ml_set_node_t *Node = Set->Head; Node; Node = Node->Next) ml_set_table_put(Table, Node);
+	return Table;
+}
+
+static ml_set_table_t *ml_set_table(ml_set_t *Set) {
+	ml_set_table_t *Table = ML_SET_TABLE_LOAD(Set);
+	if (Table) return Table;
+	size_t Size = 2 * ML_SET_TABLE_MIN;
+	while (Size - (Size >> 2) <= Set->Size) Size <<= 1;
+	Table = ml_set_table_build(Set, Size);
+#ifdef ML_THREADS
+	ml_set_table_t *Existing = NULL;
+	if (!__atomic_compare_exchange_n(&Set->Table, &Existing, Table, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) return Existing;
+#else
+	Set->Table = Table;
+#endif
+	return Table;
+}
+
+static ml_set_node_t *ml_set_table_find(ml_set_t *Set, long Hash, ml_value_t *Key) {
+	ml_set_table_t *Table = ml_set_table(Set);
+	size_t Mask = Table->Mask;
+	size_t Index = ml_set_table_index(Hash) & Mask;
+	for (;;) {
+		ml_set_entry_t *Entry = Table->Entries + Index;
+		if (!Entry->Node) return NULL;
+		if (Entry->Hash == Hash && ml_set_key_equal(Set, Key, Entry->Node->Key)) return Entry->Node;
+		Index = (Index + 1) & Mask;
+	}
+}
+
+static void ml_set_table_insert(ml_set_t *Set, ml_set_node_t *Node) {
+	ml_set_table_t *Table = Set->Table;
+	if (!Table) {
+		if (Set->Size >= ML_SET_TABLE_MIN) ml_set_table(Set);
+		return;
+	}
+	if (!Table->Space) {
+		ML_SET_TABLE_STORE(Set, ml_set_table_build(Set, 2 * (Table->Mask + 1)));
+	} else {
+		ml_set_table_put(Table, Node);
+	}
+}
+
+static void ml_set_table_remove(ml_set_t *Set, ml_set_node_t *Node) {
+	ml_set_table_t *Table = Set->Table;
+	if (!Table) return;
+	size_t Mask = Table->Mask;
+	size_t Index = ml_set_table_index(Node->Hash) & Mask;
+	while (Table->Entries[Index].Node != Node) {
+		if (!Table->Entries[Index].Node) return;
+		Index = (Index + 1) & Mask;
+	}
+	for (size_t Next = (Index + 1) & Mask; Table->Entries[Next].Node; Next = (Next + 1) & Mask) {
+		size_t Home = ml_set_table_index(Table->Entries[Next].Hash) & Mask;
+		if (((Next - Home) & Mask) >= ((Next - Index) & Mask)) {
+			Table->Entries[Index] = Table->Entries[Next];
+			Index = Next;
+		}
+	}
+	Table->Entries[Index].Node = NULL;
+	++Table->Space;
+}
+
 static ml_set_node_t *ml_set_find_node(ml_set_t *Set, ml_value_t *Key) {
-	ml_set_node_t *Node = Set->Root;
 	long Hash = ml_typeof(Key)->hash(Key, NULL);
+	if (ML_SET_TABLE_LOAD(Set) || Set->Size >= ML_SET_TABLE_MIN) return ml_set_table_find(Set, Hash, Key);
+	ml_set_node_t *Node = Set->Root;
 	while (Node) {
 		int Compare;
 		if (Hash < Node->Hash) {
@@ -323,7 +463,16 @@ static ml_set_node_t *ml_set_node_child(ml_set_t *Set, ml_set_node_t *Parent, ml
 
 static ml_set_node_t *ml_set_node(ml_set_t *Set, ml_set_node_t *Node, long Hash, ml_value_t *Key) {
 	ml_set_node_t *Root = Set->Root;
-	if (Root) return ml_set_node_child(Set, Root, Node, Hash, Key);
+	if (Root) {
+		if (ML_SET_TABLE_LOAD(Set) || Set->Size >= ML_SET_TABLE_MIN) {
+			ml_set_node_t *Found = ml_set_table_find(Set, Hash, Key);
+			if (Found) return Found;
+		}
+		int Size = Set->Size;
+		ml_set_node_t *Child = ml_set_node_child(Set, Root, Node, Hash, Key);
+		if (Set->Size != Size) ml_set_table_insert(Set, Child);
+		return Child;
+	}
 	++Set->Size;
 	if (Node) {
 		Node->Next = Node->Prev = Node->Left = Node->Right = NULL;
@@ -408,7 +557,13 @@ static ml_value_t *ml_set_remove_internal(ml_set_t *Set, ml_set_node_t **Slot, l
 
 ml_value_t *ml_set_delete(ml_value_t *Set0, ml_value_t *Key) {
 	ml_set_t *Set = (ml_set_t *)Set0;
-	return ml_set_remove_internal(Set, &Set->Root, ml_typeof(Key)->hash(Key, NULL), Key);
+	long Hash = ml_typeof(Key)->hash(Key, NULL);
+	if (Set->Table) {
+		ml_set_node_t *Node = ml_set_table_find(Set, Hash, Key);
+		if (!Node) return MLNil;
+		ml_set_table_remove(Set, Node);
+	}
+	return ml_set_remove_internal(Set, &Set->Root, Hash, Key);
 }
 
 int ml_set_foreach(ml_value_t *Value, void *Data, int (*callback)(ml_value_t *, void *)) {
@@ -514,6 +669,7 @@ ML_METHODX("filter", MLSetMutableT, MLFunctionT) {
 	State->Base.run = (ml_state_fn)ml_set_filter_state_run;
 	ml_set_node_t *Node = State->Node = Set->Head;
 	Set->Head = Set->Tail = Set->Root = NULL;
+	Set->Table = NULL;
 	Set->Size = 0;
 	Set->Type = MLSetMutableT;
 	State->Set = Set;
@@ -555,6 +711,7 @@ ML_METHODX("remove", MLSetMutableT, MLFunctionT) {
 	State->Base.run = (ml_state_fn)ml_set_remove_state_run;
 	ml_set_node_t *Node = State->Node = Set->Head;
 	Set->Head = Set->Tail = Set->Root = NULL;
+	Set->Table = NULL;
 	Set->Size = 0;
 	Set->Type = MLSetMutableT;
 	State->Set = Set;
@@ -655,6 +812,7 @@ ML_METHOD("empty", MLSetMutableT) {
 //$= S:empty
 	ml_set_t *Set = (ml_set_t *)Args[0];
 	Set->Root = Set->Head = Set->Tail = NULL;
+	Set->Table = NULL;
 	Set->Size = 0;
 #ifdef ML_GENERICS
 	Set->Type = MLSetMutableT;
@@ -801,6 +959,7 @@ ML_METHOD("splice", MLSetMutableT, MLAnyT, MLSetMutableT) {
 		Next->Prev = Tail;
 	}
 	Source->Root = Source->Head = Source->Tail = NULL;
+	Source->Table = NULL;
 	Source->Size = 0;
 	return (ml_value_t *)Removed;
 }
@@ -849,6 +1008,7 @@ ML_METHOD("splice", MLSetMutableT, MLAnyT, MLIntegerT, MLSetMutableT) {
 		Next->Prev = Tail;
 	}
 	Source->Root = Source->Head = Source->Tail = NULL;
+	Source->Table = NULL;
 	Source->Size = 0;
 	return (ml_value_t *)Removed;
 }
@@ -945,6 +1105,7 @@ ML_METHOD("take", MLSetMutableT, MLSetMutableT) {
 		Node = Next;
 	}
 	Source->Root = Source->Head = Source->Tail = NULL;
+	Source->Table = NULL;
 	Source->Size = 0;
 	return (ml_value_t *)Set;
 }
@@ -1396,6 +1557,7 @@ ML_METHODX("sort", MLSetMutableT, MLFunctionT) {
 	State->InSize = 1;
 	// TODO: Improve ml_set_sort_state_run so that List is still valid during sort
 	Set->Head = Set->Tail = NULL;
+	Set->Table = NULL;
 	Set->Size = 0;
 	return ml_set_sort_state_run(State, NULL);
 }
@@ -1495,6 +1657,29 @@ finished:
 	ML_CONTINUE(State->Base.Caller, Result);
 }
 
+static int ml_set_sort_native(ml_set_t *Set, ml_value_t *Compare, ml_context_t *Context) {
+	int Size = Set->Size;
+	ml_value_t **Keys = anew(ml_value_t *, Size);
+	ml_set_node_t **Nodes = anew(ml_set_node_t *, Size);
+	int I = 0;
+	for (ml_set_node_t *Node = Set->Head; Node; Node = Node->Next, ++I) {
+		Keys[I] = Node->Key;
+		Nodes[I] = Node;
+	}
+	if (!ml_values_sort(Context, Compare, Size, Keys, (void **)Nodes)) return 0;
+	ml_set_node_t *Prev = NULL;
+	for (I = 0; I < Size; ++I) {
+		ml_set_node_t *Node = Nodes[I];
+		Node->Prev = Prev;
+		if (Prev) Prev->Next = Node;
+		Prev = Node;
+	}
+	Prev->Next = NULL;
+	Set->Head = Nodes[0];
+	Set->Tail = Prev;
+	return 1;
+}
+
 extern ml_value_t *LessMethod;
 
 ML_METHODX("sort", MLSetMutableT) {
@@ -1504,6 +1689,7 @@ ML_METHODX("sort", MLSetMutableT) {
 //$= let S := set("cake")
 //$= S:sort
 	if (!ml_set_size(Args[0])) ML_RETURN(Args[0]);
+	if (ml_set_sort_native((ml_set_t *)Args[0], LessMethod, Caller->Context)) ML_RETURN(Args[0]);
 	ml_set_method_sort_state_t *State = new(ml_set_method_sort_state_t);
 	State->Base.Caller = Caller;
 	State->Base.Context = Caller->Context;
@@ -1517,6 +1703,7 @@ ML_METHODX("sort", MLSetMutableT) {
 	State->InSize = 1;
 	// TODO: Improve ml_set_sort_state_run so that List is still valid during sort
 	Set->Head = Set->Tail = NULL;
+	Set->Table = NULL;
 	Set->Size = 0;
 	return ml_set_method_sort_state_run(State, NULL);
 }
@@ -1529,6 +1716,7 @@ ML_METHODX("sort", MLSetMutableT, MLMethodT) {
 //$= let S := set("cake")
 //$= S:sort(>)
 	if (!ml_set_size(Args[0])) ML_RETURN(Args[0]);
+	if (ml_set_sort_native((ml_set_t *)Args[0], Args[1], Caller->Context)) ML_RETURN(Args[0]);
 	ml_set_method_sort_state_t *State = new(ml_set_method_sort_state_t);
 	State->Base.Caller = Caller;
 	State->Base.Context = Caller->Context;
@@ -1542,6 +1730,7 @@ ML_METHODX("sort", MLSetMutableT, MLMethodT) {
 	State->InSize = 1;
 	// TODO: Improve ml_set_sort_state_run so that List is still valid during sort
 	Set->Head = Set->Tail = NULL;
+	Set->Table = NULL;
 	Set->Size = 0;
 	return ml_set_method_sort_state_run(State, NULL);
 }
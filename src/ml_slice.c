@@ -1487,6 +1487,7 @@ ML_METHODX("sort", MLSliceT) {
 	ml_slice_t *Slice = (ml_slice_t *)Args[0];
 	size_t Length = Slice->Length;
 	if (Length < 2) ML_RETURN(Slice);
+	if (ml_values_sort(Caller->Context, LessEqualMethod, Length, (ml_value_t **)(Slice->Nodes + Slice->Offset), NULL)) ML_RETURN(Slice);
 	ml_slice_method_sort_state_t *State = new(ml_slice_method_sort_state_t);
 	State->Methods = ml_context_get_static(Caller->Context, ML_METHODS_INDEX);
 	State->Base.Caller = Caller;
@@ -1524,6 +1525,7 @@ ML_METHODX("sort", MLSliceT, MLMethodT) {
 	ml_slice_t *Slice = (ml_slice_t *)Args[0];
 	size_t Length = Slice->Length;
 	if (Length < 2) ML_RETURN(Slice);
+	if (ml_values_sort(Caller->Context, Args[1], Length, (ml_value_t **)(Slice->Nodes + Slice->Offset), NULL)) ML_RETURN(Slice);
 	ml_slice_method_sort_state_t *State = new(ml_slice_method_sort_state_t);
 	State->Base.Caller = Caller;
 	State->Base.Context = Caller->Context;
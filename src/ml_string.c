@@ -31,6 +31,75 @@
 #undef I
 #endif
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define ML_STRING_SIMD
+#endif
+
+#ifdef ML_STRING_SIMD
+
+// Substring search compares the first and last bytes of the needle against a
+// whole block of candidate positions at once, only candidates matching both
+// are checked with memcmp. The tail of the haystack is left to memmem.
+// Longer needles use memmem directly, since its two-way search is linear even
+// when most candidates match on their first and last bytes.
+
+#define ML_MEMMEM_SIMD_MAX 16
+
+__attribute__ ((target("sse2")))
+static const char *ml_memmem_sse2(const char *Haystack, size_t HaystackLength, const char *Needle, size_t NeedleLength) {
+	const __m128i First = _mm_set1_epi8(Needle[0]);
+	const __m128i Last = _mm_set1_epi8(Needle[NeedleLength - 1]);
+	const char *Limit = Haystack + HaystackLength - NeedleLength + 1;
+	const char *P = Haystack;
+	for (; P + 16 <= Limit; P += 16) {
+		__m128i BlockFirst = _mm_loadu_si128((const __m128i *)P);
+		__m128i BlockLast = _mm_loadu_si128((const __m128i *)(P + NeedleLength - 1));
+		unsigned Mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(First, BlockFirst), _mm_cmpeq_epi8(Last, BlockLast)));
+		while (Mask) {
+			int Bit = __builtin_ctz(Mask);
+			if (!memcmp(P + Bit + 1, Needle + 1, NeedleLength - 2)) return P + Bit;
+			Mask &= Mask - 1;
+		}
+	}
+	if (P == Limit) return NULL;
+	return memmem(P, (Limit - P) + NeedleLength - 1, Needle, NeedleLength);
+}
+
+__attribute__ ((target("avx2")))
+static const char *ml_memmem_avx2(const char *Haystack, size_t HaystackLength, const char *Needle, size_t NeedleLength) {
+	const __m256i First = _mm256_set1_epi8(Needle[0]);
+	const __m256i Last = _mm256_set1_epi8(Needle[NeedleLength - 1]);
+	const char *Limit = Haystack + HaystackLength - NeedleLength + 1;
+	const char *P = Haystack;
+	for (; P + 32 <= Limit; P += 32) {
+		__m256i BlockFirst = _mm256_loadu_si256((const __m256i *)P);
+		__m256i BlockLast = _mm256_loadu_si256((const __m256i *)(P + NeedleLength - 1));
+		unsigned Mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(First, BlockFirst), _mm256_cmpeq_epi8(Last, BlockLast)));
+		while (Mask) {
+			int Bit = __builtin_ctz(Mask);
+			if (!memcmp(P + Bit + 1, Needle + 1, NeedleLength - 2)) return P + Bit;
+			Mask &= Mask - 1;
+		}
+	}
+	if (P == Limit) return NULL;
+	return ml_memmem_sse2(P, (Limit - P) + NeedleLength - 1, Needle, NeedleLength);
+}
+
+// Selected in ml_string_init() according to the features of the running CPU.
+static const char *(*ml_memmem_simd)(const char *, size_t, const char *, size_t) = ml_memmem_sse2;
+
+#endif
+
+static inline const char *ml_memmem(const char *Haystack, size_t HaystackLength, const char *Needle, size_t NeedleLength) {
+	if (NeedleLength <= 1) return NeedleLength ? memchr(Haystack, Needle[0], HaystackLength) : Haystack;
+	if (NeedleLength > HaystackLength) return NULL;
+#ifdef ML_STRING_SIMD
+	if (NeedleLength <= ML_MEMMEM_SIMD_MAX) return ml_memmem_simd(Haystack, HaystackLength, Needle, NeedleLength);
+#endif
+	return memmem(Haystack, HaystackLength, Needle, NeedleLength);
+}
+
 #undef ML_CATEGORY
 #define ML_CATEGORY "string"
 
@@ -106,7 +175,7 @@ ML_METHOD("@", MLAddressT, MLIntegerT) {
 	if (Length > Address->Length) return ml_error("SizeError", "Size larger than buffer");
 	if (Length < 0) return ml_error("ValueError", "Address size must be non-negative");
 	ml_address_t *Address2 = new(ml_address_t);
-	Address2->Type = Address->Type;
+	Address2->Type = ml_is((ml_value_t *)Address, MLBufferT) ? MLBufferViewT : Address->Type;
 	Address2->Value = Address->Value;
 	Address2->Length = Length;
 	return (ml_value_t *)Address2;
@@ -128,7 +197,7 @@ ML_METHOD("@", MLAddressT, MLIntegerT, MLIntegerT) {
 	if (Length < 0) return ml_error("ValueError", "Address size must be non-negative");
 	if (Offset + Length > Address->Length) return ml_error("SizeError", "Offset + size larger than buffer");
 	ml_address_t *Address2 = new(ml_address_t);
-	Address2->Type = Address->Type;
+	Address2->Type = ml_is((ml_value_t *)Address, MLBufferT) ? MLBufferViewT : Address->Type;
 	Address2->Value = Address->Value + Offset;
 	Address2->Length = Length;
 	return (ml_value_t *)Address2;
@@ -147,7 +216,7 @@ ML_METHOD("+", MLAddressT, MLIntegerT) {
 	if (Offset < 0) return ml_error("SizeError", "Offset must be non-negative");
 	if (Offset > Address->Length) return ml_error("SizeError", "Offset larger than buffer");
 	ml_address_t *Address2 = new(ml_address_t);
-	Address2->Type = Address->Type;
+	Address2->Type = ml_is((ml_value_t *)Address, MLBufferT) ? MLBufferViewT : Address->Type;
 	Address2->Value = Address->Value + Offset;
 	Address2->Length = Address->Length - Offset;
 	return (ml_value_t *)Address2;
@@ -301,7 +370,7 @@ ML_METHOD("find", MLAddressT, MLAddressT) {
 //$= A:find("other")
 	ml_address_t *Address1 = (ml_address_t *)Args[0];
 	ml_address_t *Address2 = (ml_address_t *)Args[1];
-	char *Find = memmem(Address1->Value, Address1->Length, Address2->Value, Address2->Length);
+	char *Find = (char *)ml_memmem(Address1->Value, Address1->Length, Address2->Value, Address2->Length);
 	if (!Find) return MLNil;
 	return ml_integer(Find - Address1->Value);
 }
@@ -321,7 +390,7 @@ ML_METHOD("find", MLAddressT, MLAddressT, MLIntegerT) {
 	long Start = ml_integer_value(Args[2]);
 	if (Start < 0) return ml_error("SizeError", "Offset must be non-negative");
 	if (Start > Address1->Length) return ml_error("SizeError", "Offset larger than buffer");
-	char *Find = memmem(Address1->Value + Start, Address1->Length - Start, Address2->Value, Address2->Length);
+	char *Find = (char *)ml_memmem(Address1->Value + Start, Address1->Length - Start, Address2->Value, Address2->Length);
 	if (!Find) return MLNil;
 	return ml_integer(Find - Address1->Value);
 }
@@ -344,6 +413,11 @@ ML_TYPE(MLBufferT, (MLAddressT), "buffer",
 // A buffer represents a writable bounded section of memory.
 );
 
+ML_TYPE(MLBufferViewT, (MLBufferT), "buffer::view",
+//!buffer
+// A writable section of memory belonging to another value, e.g. part of a :mini:`buffer`.
+);
+
 ml_value_t *ml_buffer(char *Value, int Length) {
 	ml_address_t *Buffer = new(ml_address_t);
 	Buffer->Type = MLBufferT;
@@ -688,10 +762,20 @@ ML_METHOD("put", MLBufferT, MLAddressT) {
 static long ml_string_hash(ml_string_t *String, ml_hash_chain_t *Chain) {
 	long Hash = String->Hash;
 	if (!Hash) {
-		Hash = 5381;
-		int Length = String->Length;
-		for (const unsigned char *P = (const unsigned char *)String->Value; --Length >= 0; ++P) Hash = ((Hash << 5) + Hash) + P[0];
-		String->Hash = Hash;
+		// Computes Hash = Hash * 33 + P[I] over each byte, 8 bytes at a time so
+		// that the multiplications do not depend on each other.
+		uint64_t Value = 5381;
+		size_t Length = String->Length;
+		const unsigned char *P = (const unsigned char *)String->Value;
+		for (; Length >= 8; Length -= 8, P += 8) {
+			Value = Value * 1406408618241UL
+				+ P[0] * 42618442977UL + P[1] * 1291467969UL
+				+ P[2] * 39135393UL + P[3] * 1185921UL
+				+ P[4] * 35937UL + P[5] * 1089UL
+				+ P[6] * 33UL + P[7];
+		}
+		while (Length--) Value = Value * 33 + *P++;
+		String->Hash = Hash = (long)Value;
 	}
 	return Hash;
 }
@@ -767,12 +851,9 @@ int GC_asprintf(char **Ptr, const char *Format, ...) {
 	return Result;
 }
 
-#ifdef ML_STRINGCACHE
-
-#define ML_STRINGCACHE_MAX 64
-
 #include "weakmap.h"
 
+// Interned strings, also used to share short strings when ML_STRINGCACHE is enabled.
 static weakmap_t StringCache[1] = {WEAKMAP_INIT};
 
 static void *_ml_string(const char *Value, int Length) {
@@ -783,6 +864,10 @@ static void *_ml_string(const char *Value, int Length) {
 	return String;
 }
 
+#ifdef ML_STRINGCACHE
+
+#define ML_STRINGCACHE_MAX 64
+
 ML_FUNCTION(MLStringCheckCache) {
 	if (weakmap_check(StringCache)) return ml_error("InternalError", "Cache is corrupted");
 	return MLNil;
@@ -792,6 +877,24 @@ ML_FUNCTION(MLStringCheckCache) {
 
 static ml_string_t MLEmptyString[1] = {{MLStringT, "", 0, 0}};
 
+ml_value_t *ml_string_intern(const char *Value, int Length) {
+	if (!Value) return (ml_value_t *)MLEmptyString;
+	if (Length < 0) Length = strlen(Value);
+	if (!Length) return (ml_value_t *)MLEmptyString;
+	return weakmap_insert(StringCache, Value, Length, _ml_string);
+}
+
+ML_FUNCTION(MLStringIntern) {
+//@string::intern
+//<String
+//>string
+// Returns the interned copy of :mini:`String`. All interned strings with the same contents are the same value, so comparing them or using them as map keys only needs to compare pointers.
+//$= string::intern("Hello")
+	ML_CHECK_ARG_COUNT(1);
+	ML_CHECK_ARG_TYPE(0, MLStringT);
+	return ml_string_intern(ml_string_value(Args[0]), ml_string_length(Args[0]));
+}
+
 ml_value_t *ml_string(const char *Value, int Length) {
 	if (!Length || !Value) return (ml_value_t *)MLEmptyString;
 	if (Length > 0 && Value[Length]) {
@@ -1545,8 +1648,31 @@ static const char *utf8_next(const char *A) {
 	}
 }
 
+#ifdef ML_STRING_SIMD
+__attribute__ ((target("sse2")))
+#endif
 static size_t utf8_position(const char *P, const char *Q) {
 	size_t N = 0;
+#ifdef ML_STRING_SIMD
+	// Counts runs of ASCII characters 16 bytes at a time.
+	while (Q - P >= 16) {
+		unsigned Mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)P));
+		if (!Mask) {
+			N += 16;
+			P += 16;
+			continue;
+		}
+		int Ascii = __builtin_ctz(Mask);
+		N += Ascii + 1;
+		P += Ascii;
+		// Stray continuation bytes count as single characters, as below.
+		if (utf8_is_multibyte(*P)) {
+			do ++P; while (utf8_is_continuation(*P));
+		} else {
+			++P;
+		}
+	}
+#endif
 	while (P < Q) {
 		++N;
 		if (utf8_is_multibyte(*P)) {
@@ -1593,8 +1719,30 @@ typedef struct {
 	size_t Length;
 } subject_t;
 
+#ifdef ML_STRING_SIMD
+__attribute__ ((target("sse2")))
+#endif
 static subject_t utf8_index(const char *S, int L, int P) {
 	const char *E = S + L;
+#ifdef ML_STRING_SIMD
+	// Skips runs of ASCII characters 16 bytes at a time.
+	while (P >= 16 && E - S >= 16) {
+		unsigned Mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)S));
+		if (!Mask) {
+			S += 16;
+			P -= 16;
+			continue;
+		}
+		int Ascii = __builtin_ctz(Mask);
+		S += Ascii;
+		P -= Ascii + 1;
+		if (utf8_is_multibyte(*S)) {
+			do ++S; while (utf8_is_continuation(*S));
+		} else {
+			++S;
+		}
+	}
+#endif
 	while (S <= E) {
 		if (P == 0) return (subject_t){S, E - S};
 		--P;
@@ -1644,11 +1792,563 @@ static void ML_TYPED_FN(ml_iterate, MLStringT, ml_state_t *Caller, ml_value_t *S
 	ML_RETURN(Iter);
 }
 
+// Regex prefilter DFA.
+// Patterns without backreferences are also translated into a byte level NFA
+// which accepts a superset of the strings matched by the regex engine (UTF-8
+// classes are widened to "any multibyte character", word boundaries become
+// empty, etc). The NFA is converted lazily into a DFA one state at a time
+// while scanning subjects, which rejects non-matching subjects in a single
+// linear pass. Subjects which are not rejected are still passed to the regex
+// engine, which remains responsible for match positions and submatches.
+
+#define ML_DFA_MAX_NODES 4096
+#define ML_DFA_MAX_STATES 512
+#define ML_DFA_MAX_REPEAT 255
+
+typedef enum {
+	ML_DFA_EMPTY,
+	ML_DFA_SPLIT,
+	ML_DFA_BYTES,
+	ML_DFA_MATCH
+} ml_dfa_kind_t;
+
+typedef struct {
+	ml_dfa_kind_t Kind;
+	int Out, Out1;
+	uint64_t Bytes[4];
+} ml_dfa_node_t;
+
+typedef struct ml_dfa_state_t ml_dfa_state_t;
+
+struct ml_dfa_state_t {
+	ml_dfa_state_t **Next;
+	int Match, Count;
+	int Nodes[];
+};
+
+typedef struct {
+	ml_dfa_node_t *Nodes;
+	ml_dfa_state_t **States;
+	ml_dfa_state_t *Start;
+	int *Stack, *Marks;
+	int NumNodes, NumStates, NumClasses, StartNode, Mark;
+	int AnchorStart, AnchorEnd, Failed;
+	unsigned char Classes[256], Bytes[256];
+#ifdef ML_HOSTTHREADS
+	pthread_mutex_t Lock[1];
+#endif
+} ml_dfa_t;
+
+#ifdef ML_HOSTTHREADS
+#define ML_DFA_LOAD(X) __atomic_load_n(&(X), __ATOMIC_ACQUIRE)
+#define ML_DFA_STORE(X, V) __atomic_store_n(&(X), V, __ATOMIC_RELEASE)
+#else
+#define ML_DFA_LOAD(X) (X)
+#define ML_DFA_STORE(X, V) (X) = (V)
+#endif
+
+#define ML_DFA_TEST(BYTES, B) (((BYTES)[(B) >> 6] >> ((B) & 63)) & 1)
+#define ML_DFA_SET(BYTES, B) ((BYTES)[(B) >> 6] |= (1ULL << ((B) & 63)))
+
+typedef struct {
+	int Start, End;
+} ml_dfa_frag_t;
+
+typedef struct {
+	const unsigned char *Pattern, *Next, *End, *Limit;
+	ml_dfa_node_t *Nodes;
+	int NumNodes, MaxNodes;
+	int AnchorStart, AnchorEnd, Alternates, Error;
+} ml_dfa_parser_t;
+
+static int ml_dfa_node(ml_dfa_parser_t *Parser, ml_dfa_kind_t Kind, int Out, int Out1) {
+	if (Parser->NumNodes == Parser->MaxNodes) {
+		if (Parser->MaxNodes == ML_DFA_MAX_NODES) {
+			Parser->Error = 1;
+			return 0;
+		}
+		int MaxNodes = 2 * Parser->MaxNodes;
+		ml_dfa_node_t *Nodes = (ml_dfa_node_t *)GC_MALLOC_ATOMIC(MaxNodes * sizeof(ml_dfa_node_t));
+		memcpy(Nodes, Parser->Nodes, Parser->NumNodes * sizeof(ml_dfa_node_t));
+		Parser->Nodes = Nodes;
+		Parser->MaxNodes = MaxNodes;
+	}
+	int Index = Parser->NumNodes++;
+	ml_dfa_node_t *Node = Parser->Nodes + Index;
+	Node->Kind = Kind;
+	Node->Out = Out;
+	Node->Out1 = Out1;
+	memset(Node->Bytes, 0, sizeof(Node->Bytes));
+	return Index;
+}
+
+static inline void ml_dfa_patch(ml_dfa_parser_t *Parser, int Index, int Out) {
+	Parser->Nodes[Index].Out = Out;
+}
+
+static ml_dfa_frag_t ml_dfa_empty(ml_dfa_parser_t *Parser) {
+	int End = ml_dfa_node(Parser, ML_DFA_EMPTY, 0, 0);
+	return (ml_dfa_frag_t){End, End};
+}
+
+static ml_dfa_frag_t ml_dfa_bytes(ml_dfa_parser_t *Parser, const uint64_t Bytes[4], int Multibyte) {
+	int End = ml_dfa_node(Parser, ML_DFA_EMPTY, 0, 0);
+	int Start = ml_dfa_node(Parser, ML_DFA_BYTES, End, 0);
+	memcpy(Parser->Nodes[Start].Bytes, Bytes, sizeof(Parser->Nodes[Start].Bytes));
+	if (Multibyte) {
+		// Any multibyte character: any non-ASCII byte followed by continuation bytes.
+		int Split = ml_dfa_node(Parser, ML_DFA_SPLIT, 0, End);
+		int Continue = ml_dfa_node(Parser, ML_DFA_BYTES, Split, 0);
+		Parser->Nodes[Split].Out = Continue;
+		ml_dfa_node_t *Node = Parser->Nodes + Start;
+		Node->Out = Split;
+		Node->Bytes[2] = Node->Bytes[3] = ~0ULL;
+		Parser->Nodes[Continue].Bytes[2] = ~0ULL;
+	}
+	return (ml_dfa_frag_t){Start, End};
+}
+
+static ml_dfa_frag_t ml_dfa_byte(ml_dfa_parser_t *Parser, unsigned char Byte) {
+	uint64_t Bytes[4] = {0};
+	ML_DFA_SET(Bytes, Byte);
+	return ml_dfa_bytes(Parser, Bytes, 0);
+}
+
+static ml_dfa_frag_t ml_dfa_any(ml_dfa_parser_t *Parser) {
+	uint64_t Bytes[4] = {~0ULL, ~0ULL, 0, 0};
+	return ml_dfa_bytes(Parser, Bytes, 1);
+}
+
+static ml_dfa_frag_t ml_dfa_concat(ml_dfa_parser_t *Parser, ml_dfa_frag_t A, ml_dfa_frag_t B) {
+	ml_dfa_patch(Parser, A.End, B.Start);
+	return (ml_dfa_frag_t){A.Start, B.End};
+}
+
+static ml_dfa_frag_t ml_dfa_alternate(ml_dfa_parser_t *Parser, ml_dfa_frag_t A, ml_dfa_frag_t B) {
+	int End = ml_dfa_node(Parser, ML_DFA_EMPTY, 0, 0);
+	int Start = ml_dfa_node(Parser, ML_DFA_SPLIT, A.Start, B.Start);
+	ml_dfa_patch(Parser, A.End, End);
+	ml_dfa_patch(Parser, B.End, End);
+	return (ml_dfa_frag_t){Start, End};
+}
+
+static ml_dfa_frag_t ml_dfa_optional(ml_dfa_parser_t *Parser, ml_dfa_frag_t A) {
+	int End = ml_dfa_node(Parser, ML_DFA_EMPTY, 0, 0);
+	int Start = ml_dfa_node(Parser, ML_DFA_SPLIT, A.Start, End);
+	ml_dfa_patch(Parser, A.End, End);
+	return (ml_dfa_frag_t){Start, End};
+}
+
+static ml_dfa_frag_t ml_dfa_repeat(ml_dfa_parser_t *Parser, ml_dfa_frag_t A, int Empty) {
+	int End = ml_dfa_node(Parser, ML_DFA_EMPTY, 0, 0);
+	int Split = ml_dfa_node(Parser, ML_DFA_SPLIT, A.Start, End);
+	ml_dfa_patch(Parser, A.End, Split);
+	return (ml_dfa_frag_t){Empty ? Split : A.Start, End};
+}
+
+static ml_dfa_frag_t ml_dfa_parse_alternates(ml_dfa_parser_t *Parser, int Depth);
+static ml_dfa_frag_t ml_dfa_parse_sequence(ml_dfa_parser_t *Parser, int Depth);
+
+static int ml_dfa_parse_char(ml_dfa_parser_t *Parser) {
+	// Returns the next character if it is ASCII, skips it and returns -1 otherwise.
+	const unsigned char *Next = Parser->Next;
+	int Char = *Next++;
+	if (Char >= 0x80) {
+		while (Next < Parser->End && (*Next & 0xC0) == 0x80) ++Next;
+		Char = -1;
+	}
+	Parser->Next = Next;
+	return Char;
+}
+
+static ml_dfa_frag_t ml_dfa_parse_literal(ml_dfa_parser_t *Parser) {
+	const unsigned char *Next = Parser->Next;
+	ml_dfa_frag_t Frag = ml_dfa_byte(Parser, *Next++);
+	if (Next[-1] >= 0xC0) {
+		while (Next < Parser->End && (*Next & 0xC0) == 0x80) {
+			Frag = ml_dfa_concat(Parser, Frag, ml_dfa_byte(Parser, *Next++));
+		}
+	}
+	Parser->Next = Next;
+	return Frag;
+}
+
+static int ml_dfa_parse_class(ml_dfa_parser_t *Parser, uint64_t Bytes[4]) {
+	const unsigned char *Name = Parser->Next + 2;
+	const unsigned char *Next = Name;
+	while (Next + 1 < Parser->End && (Next[0] != ':' || Next[1] != ']')) ++Next;
+	if (Next + 1 >= Parser->End) return 1;
+	int (*Test)(int);
+	size_t Length = Next - Name;
+#define ML_DFA_CLASS(NAME) if (Length == strlen(#NAME) && !memcmp(Name, #NAME, Length)) Test = is ## NAME; else
+	ML_DFA_CLASS(alpha) ML_DFA_CLASS(digit) ML_DFA_CLASS(alnum)
+	ML_DFA_CLASS(upper) ML_DFA_CLASS(lower) ML_DFA_CLASS(space)
+	ML_DFA_CLASS(blank) ML_DFA_CLASS(punct) ML_DFA_CLASS(print)
+	ML_DFA_CLASS(graph) ML_DFA_CLASS(cntrl) ML_DFA_CLASS(xdigit)
+	return 1;
+#undef ML_DFA_CLASS
+	for (int Char = 0; Char < 0x80; ++Char) if (Test(Char)) ML_DFA_SET(Bytes, Char);
+	Parser->Next = Next + 2;
+	return 0;
+}
+
+static ml_dfa_frag_t ml_dfa_parse_bracket(ml_dfa_parser_t *Parser) {
+	uint64_t Bytes[4] = {0};
+	int Negate = 0, Multibyte = 0;
+	if (Parser->Next < Parser->End && *Parser->Next == '^') {
+		Negate = 1;
+		++Parser->Next;
+	}
+	for (int First = 1;; First = 0) {
+		if (Parser->Next >= Parser->End) goto error;
+		const unsigned char *Next = Parser->Next;
+		if (Next[0] == ']' && !First) {
+			++Parser->Next;
+			break;
+		}
+		if (Next[0] == '\\') goto error;
+		if (Next[0] == '[' && Next + 1 < Parser->End) {
+			if (Next[1] == ':') {
+				// Character classes may also contain non-ASCII characters.
+				if (ml_dfa_parse_class(Parser, Bytes)) goto error;
+				Multibyte = 1;
+				continue;
+			} else if (Next[1] == '=' || Next[1] == '.') {
+				goto error;
+			}
+		}
+		int Lo = ml_dfa_parse_char(Parser), Hi = Lo;
+		Next = Parser->Next;
+		if (Next + 1 < Parser->End && Next[0] == '-' && Next[1] != ']') {
+			++Parser->Next;
+			if (Next[1] == '\\' || Next[1] == '[') goto error;
+			Hi = ml_dfa_parse_char(Parser);
+			if (Hi < 0) {
+				Multibyte = 1;
+				if (Lo >= 0) Hi = 0x7F;
+			} else if (Lo < 0) {
+				goto error;
+			}
+		}
+		if (Lo < 0) {
+			Multibyte = 1;
+		} else {
+			for (int Char = Lo; Char <= Hi; ++Char) ML_DFA_SET(Bytes, Char);
+		}
+	}
+	if (Negate) {
+		Bytes[0] = ~Bytes[0];
+		Bytes[1] = ~Bytes[1];
+		Multibyte = 1;
+	}
+	return ml_dfa_bytes(Parser, Bytes, Multibyte);
+error:
+	Parser->Error = 1;
+	return ml_dfa_empty(Parser);
+}
+
+static ml_dfa_frag_t ml_dfa_parse_atom(ml_dfa_parser_t *Parser, int Depth, int *Quantifiable) {
+	const unsigned char *Next = Parser->Next;
+	*Quantifiable = 1;
+	switch (*Next) {
+	case '(': {
+		if (++Next < Parser->End && *Next == '?') break;
+		Parser->Next = Next;
+		ml_dfa_frag_t Frag = ml_dfa_parse_alternates(Parser, Depth + 1);
+		if (Parser->Next >= Parser->End || *Parser->Next != ')') break;
+		++Parser->Next;
+		return Frag;
+	}
+	case '[':
+		Parser->Next = Next + 1;
+		return ml_dfa_parse_bracket(Parser);
+	case '.':
+		Parser->Next = Next + 1;
+		return ml_dfa_any(Parser);
+	case '^':
+		// Only a leading anchor restricts matches, any other anchor is treated as empty.
+		if (Next == Parser->Pattern) Parser->AnchorStart = 1;
+		Parser->Next = Next + 1;
+		*Quantifiable = 0;
+		return ml_dfa_empty(Parser);
+	case '$':
+		// The regex engine without length support stops at the first NUL, so
+		// a trailing anchor can only be trusted when matching with lengths.
+#ifdef ML_TRE
+		if (Next + 1 == Parser->Limit) Parser->AnchorEnd = 1;
+#endif
+		Parser->Next = Next + 1;
+		*Quantifiable = 0;
+		return ml_dfa_empty(Parser);
+	case '\\': {
+		if (++Next == Parser->End) break;
+		switch (*Next) {
+		case 'w': case 'W': case 's': case 'S': case 'd': case 'D':
+			Parser->Next = Next + 1;
+			return ml_dfa_any(Parser);
+		case 'b': case 'B': case '<': case '>': case '`': case '\'':
+			Parser->Next = Next + 1;
+			*Quantifiable = 0;
+			return ml_dfa_empty(Parser);
+		}
+		if (*Next < 0x80 && isalnum(*Next)) break;
+		Parser->Next = Next;
+		return ml_dfa_parse_literal(Parser);
+	}
+	case '*': case '+': case '?': case '{': case ')': case '|':
+		break;
+	default:
+		return ml_dfa_parse_literal(Parser);
+	}
+	Parser->Error = 1;
+	return ml_dfa_empty(Parser);
+}
+
+static ml_dfa_frag_t ml_dfa_parse_copy(ml_dfa_parser_t *Parser, const unsigned char *Start, const unsigned char *End, int Depth) {
+	const unsigned char *Next = Parser->Next, *Limit = Parser->End;
+	Parser->Next = Start;
+	Parser->End = End;
+	ml_dfa_frag_t Frag = ml_dfa_parse_sequence(Parser, Depth);
+	Parser->Next = Next;
+	Parser->End = Limit;
+	return Frag;
+}
+
+static int ml_dfa_parse_count(ml_dfa_parser_t *Parser, int Required) {
+	const unsigned char *Next = Parser->Next;
+	if (Next >= Parser->End || !isdigit(*Next)) {
+		if (Required) Parser->Error = 1;
+		return -1;
+	}
+	int Value = 0;
+	while (Next < Parser->End && isdigit(*Next)) {
+		Value = Value * 10 + (*Next++ - '0');
+		if (Value > ML_DFA_MAX_REPEAT) {
+			Parser->Error = 1;
+			return 0;
+		}
+	}
+	Parser->Next = Next;
+	return Value;
+}
+
+static ml_dfa_frag_t ml_dfa_parse_sequence(ml_dfa_parser_t *Parser, int Depth) {
+	ml_dfa_frag_t Frag = ml_dfa_empty(Parser);
+	while (!Parser->Error && Parser->Next < Parser->End) {
+		const unsigned char *Start = Parser->Next;
+		if (*Start == '|' || *Start == ')') break;
+		int Quantifiable;
+		ml_dfa_frag_t Atom = ml_dfa_parse_atom(Parser, Depth, &Quantifiable);
+		while (!Parser->Error && Parser->Next < Parser->End) {
+			const unsigned char *Next = Parser->Next;
+			if (*Next == '*' || *Next == '+' || *Next == '?') {
+				if (!Quantifiable) Parser->Error = 1;
+				Parser->Next = Next + 1;
+				if (*Next == '*') {
+					Atom = ml_dfa_repeat(Parser, Atom, 1);
+				} else if (*Next == '+') {
+					Atom = ml_dfa_repeat(Parser, Atom, 0);
+				} else {
+					Atom = ml_dfa_optional(Parser, Atom);
+				}
+			} else if (*Next == '{') {
+				if (!Quantifiable) Parser->Error = 1;
+				Parser->Next = Next + 1;
+				int Min = ml_dfa_parse_count(Parser, 1), Max = Min;
+				if (Parser->Next < Parser->End && *Parser->Next == ',') {
+					++Parser->Next;
+					Max = ml_dfa_parse_count(Parser, 0);
+				}
+				if (Parser->Next >= Parser->End || *Parser->Next != '}') Parser->Error = 1;
+				if (Max >= 0 && Max < Min) Parser->Error = 1;
+				if (Parser->Error) break;
+				++Parser->Next;
+				// Each repetition is a fresh copy of the atom (including any earlier quantifiers).
+				ml_dfa_frag_t Repeat = ml_dfa_empty(Parser);
+				int Used = 0;
+				for (int I = 0; I < Min && !Parser->Error; ++I) {
+					ml_dfa_frag_t Copy = Used++ ? ml_dfa_parse_copy(Parser, Start, Next, Depth) : Atom;
+					Repeat = ml_dfa_concat(Parser, Repeat, Copy);
+				}
+				if (Max < 0) {
+					ml_dfa_frag_t Copy = Used++ ? ml_dfa_parse_copy(Parser, Start, Next, Depth) : Atom;
+					Repeat = ml_dfa_concat(Parser, Repeat, ml_dfa_repeat(Parser, Copy, 1));
+				} else {
+					for (int I = Min; I < Max && !Parser->Error; ++I) {
+						ml_dfa_frag_t Copy = Used++ ? ml_dfa_parse_copy(Parser, Start, Next, Depth) : Atom;
+						Repeat = ml_dfa_concat(Parser, Repeat, ml_dfa_optional(Parser, Copy));
+					}
+				}
+				Atom = Repeat;
+			} else {
+				break;
+			}
+		}
+		Frag = ml_dfa_concat(Parser, Frag, Atom);
+	}
+	return Frag;
+}
+
+static ml_dfa_frag_t ml_dfa_parse_alternates(ml_dfa_parser_t *Parser, int Depth) {
+	ml_dfa_frag_t Frag = ml_dfa_parse_sequence(Parser, Depth);
+	while (!Parser->Error && Parser->Next < Parser->End && *Parser->Next == '|') {
+		if (!Depth) Parser->Alternates = 1;
+		++Parser->Next;
+		Frag = ml_dfa_alternate(Parser, Frag, ml_dfa_parse_sequence(Parser, Depth));
+	}
+	return Frag;
+}
+
+static ml_dfa_t *ml_dfa(const char *Pattern, size_t Length) {
+	ml_dfa_parser_t Parser[1] = {0};
+	Parser->Pattern = Parser->Next = (const unsigned char *)Pattern;
+	Parser->End = Parser->Limit = Parser->Pattern + Length;
+	Parser->MaxNodes = 64;
+	Parser->Nodes = (ml_dfa_node_t *)GC_MALLOC_ATOMIC(Parser->MaxNodes * sizeof(ml_dfa_node_t));
+	ml_dfa_frag_t Frag = ml_dfa_parse_alternates(Parser, 0);
+	if (Parser->Next != Parser->End) return NULL;
+	int Match = ml_dfa_node(Parser, ML_DFA_MATCH, 0, 0);
+	if (Parser->Error) return NULL;
+	ml_dfa_patch(Parser, Frag.End, Match);
+	ml_dfa_t *Dfa = new(ml_dfa_t);
+	Dfa->Nodes = Parser->Nodes;
+	Dfa->NumNodes = Parser->NumNodes;
+	Dfa->StartNode = Frag.Start;
+	if (!Parser->Alternates) {
+		Dfa->AnchorStart = Parser->AnchorStart;
+		Dfa->AnchorEnd = Parser->AnchorEnd;
+	}
+	// Partition bytes into classes which no node can distinguish.
+	int NumClasses = 1;
+	for (int I = 0; I < Dfa->NumNodes; ++I) {
+		ml_dfa_node_t *Node = Dfa->Nodes + I;
+		if (Node->Kind != ML_DFA_BYTES) continue;
+		int Split[256][2];
+		memset(Split, -1, NumClasses * sizeof(Split[0]));
+		int Count = 0;
+		for (int Byte = 0; Byte < 256; ++Byte) {
+			int *Class = &Split[Dfa->Classes[Byte]][ML_DFA_TEST(Node->Bytes, Byte)];
+			if (*Class < 0) *Class = Count++;
+			Dfa->Classes[Byte] = *Class;
+		}
+		NumClasses = Count;
+	}
+	for (int Byte = 256; --Byte >= 0;) Dfa->Bytes[Dfa->Classes[Byte]] = Byte;
+	Dfa->NumClasses = NumClasses;
+	Dfa->Stack = anew(int, Dfa->NumNodes);
+	Dfa->Marks = anew(int, Dfa->NumNodes);
+	Dfa->States = anew(ml_dfa_state_t *, ML_DFA_MAX_STATES);
+#ifdef ML_HOSTTHREADS
+	pthread_mutex_init(Dfa->Lock, NULL);
+#endif
+	return Dfa;
+}
+
+static int ml_dfa_compare(const void *A, const void *B) {
+	return *(const int *)A - *(const int *)B;
+}
+
+static ml_dfa_state_t *ml_dfa_state(ml_dfa_t *Dfa, ml_dfa_state_t *From, unsigned char Byte) {
+	int Mark = ++Dfa->Mark, *Marks = Dfa->Marks;
+	int *Stack = Dfa->Stack, Top = 0;
+	int Nodes[Dfa->NumNodes], Count = 0;
+	if (!From || !Dfa->AnchorStart) {
+		Marks[Dfa->StartNode] = Mark;
+		Stack[Top++] = Dfa->StartNode;
+	}
+	if (From) for (int I = 0; I < From->Count; ++I) {
+		ml_dfa_node_t *Node = Dfa->Nodes + From->Nodes[I];
+		if (Node->Kind != ML_DFA_BYTES || !ML_DFA_TEST(Node->Bytes, Byte)) continue;
+		if (Marks[Node->Out] == Mark) continue;
+		Marks[Node->Out] = Mark;
+		Stack[Top++] = Node->Out;
+	}
+	int Match = 0;
+	while (Top) {
+		int Index = Stack[--Top];
+		ml_dfa_node_t *Node = Dfa->Nodes + Index;
+		switch (Node->Kind) {
+		case ML_DFA_SPLIT:
+			if (Marks[Node->Out1] != Mark) {
+				Marks[Node->Out1] = Mark;
+				Stack[Top++] = Node->Out1;
+			}
+			// fallthrough
+		case ML_DFA_EMPTY:
+			if (Marks[Node->Out] != Mark) {
+				Marks[Node->Out] = Mark;
+				Stack[Top++] = Node->Out;
+			}
+			break;
+		case ML_DFA_MATCH:
+			Match = 1;
+			// fallthrough
+		case ML_DFA_BYTES:
+			Nodes[Count++] = Index;
+			break;
+		}
+	}
+	qsort(Nodes, Count, sizeof(int), ml_dfa_compare);
+	for (int I = 0; I < Dfa->NumStates; ++I) {
+		ml_dfa_state_t *State = Dfa->States[I];
+		if (State->Count == Count && !memcmp(State->Nodes, Nodes, Count * sizeof(int))) return State;
+	}
+	if (Dfa->NumStates == ML_DFA_MAX_STATES) return NULL;
+	ml_dfa_state_t *State = xnew(ml_dfa_state_t, Count, int);
+	State->Next = anew(ml_dfa_state_t *, Dfa->NumClasses);
+	State->Match = Match;
+	State->Count = Count;
+	memcpy(State->Nodes, Nodes, Count * sizeof(int));
+	Dfa->States[Dfa->NumStates++] = State;
+	return State;
+}
+
+static ml_dfa_state_t *ml_dfa_next(ml_dfa_t *Dfa, ml_dfa_state_t *State, int Class) {
+#ifdef ML_HOSTTHREADS
+	pthread_mutex_lock(Dfa->Lock);
+#endif
+	ml_dfa_state_t *Next = State ? State->Next[Class] : Dfa->Start;
+	if (!Next && !Dfa->Failed) {
+		Next = ml_dfa_state(Dfa, State, Dfa->Bytes[Class]);
+		if (!Next) {
+			// Too many states, give up on this pattern and leave matching to the regex engine.
+			Dfa->Failed = 1;
+		} else if (State) {
+			ML_DFA_STORE(State->Next[Class], Next);
+		} else {
+			ML_DFA_STORE(Dfa->Start, Next);
+		}
+	}
+#ifdef ML_HOSTTHREADS
+	pthread_mutex_unlock(Dfa->Lock);
+#endif
+	return Next;
+}
+
+static int ml_dfa_rejects(ml_dfa_t *Dfa, const char *Subject, size_t Length) {
+	if (ML_DFA_LOAD(Dfa->Failed)) return 0;
+	ml_dfa_state_t *State = ML_DFA_LOAD(Dfa->Start);
+	if (!State && !(State = ml_dfa_next(Dfa, NULL, 0))) return 0;
+	int AnchorStart = Dfa->AnchorStart, AnchorEnd = Dfa->AnchorEnd;
+	const unsigned char *Classes = Dfa->Classes;
+	const unsigned char *Next = (const unsigned char *)Subject, *End = Next + Length;
+	while (Next < End) {
+		if (State->Match && !AnchorEnd) return 0;
+		if (AnchorStart && !State->Count) return 1;
+		int Class = Classes[*Next++];
+		ml_dfa_state_t *Target = ML_DFA_LOAD(State->Next[Class]);
+		if (!Target && !(Target = ml_dfa_next(Dfa, State, Class))) return 0;
+		State = Target;
+	}
+	return !State->Match;
+}
+
 typedef struct ml_regex_t ml_regex_t;
 
 typedef struct ml_regex_t {
 	ml_type_t *Type;
 	const char *Pattern;
+	ml_dfa_t *Dfa;
 	regex_t Value[1];
 } ml_regex_t;
 
@@ -1657,6 +2357,11 @@ regex_t *ml_regex_value(const ml_value_t *Value) {
 	return Regex->Value;
 }
 
+static inline int ml_regex_rejects(const ml_value_t *Value, const char *Subject, size_t Length) {
+	ml_dfa_t *Dfa = ((ml_regex_t *)Value)->Dfa;
+	return Dfa && ml_dfa_rejects(Dfa, Subject, Length);
+}
+
 ML_METHOD("append", MLStringBufferT, MLStringT) {
 //<Buffer
 //<Value
@@ -2579,6 +3284,7 @@ ML_METHOD("<>", MLStringT, MLStringT) {
 //$= "Hello" <> "Hello"
 //$= "abcd" <> "abc"
 //$= "abc" <> "abcd"
+	if (Args[0] == Args[1]) return (ml_value_t *)Zero;
 	const char *StringA = ml_string_value(Args[0]);
 	const char *StringB = ml_string_value(Args[1]);
 	int LengthA = ml_string_length(Args[0]);
@@ -2614,7 +3320,9 @@ ML_METHOD(#NAME, MLStringT, MLStringT) { \
 	int LengthA = ml_string_length(Args[0]); \
 	int LengthB = ml_string_length(Args[1]); \
 	int Compare; \
-	if (LengthA < LengthB) { \
+	if (Args[0] == Args[1]) { \
+		Compare = 0; \
+	} else if (LengthA < LengthB) { \
 		Compare = memcmp(StringA, StringB, LengthA) ?: -1; \
 	} else if (LengthA > LengthB) { \
 		Compare = memcmp(StringA, StringB, LengthB) ?: 1; \
@@ -2807,10 +3515,10 @@ ML_METHOD("/", MLStringT, MLStringT) {
 	size_t PatternLength = ml_string_length(Args[1]);
 	if (!PatternLength) return ml_error("ValueError", "Empty pattern used in split");
 	for (;;) {
-		const char *Next = memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
+		const char *Next = ml_memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
 		while (Next == Subject) {
 			Subject += PatternLength;
-			Next = memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
+			Next = ml_memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
 		}
 		if (Subject == SubjectEnd) return Results;
 		if (Next) {
@@ -2951,7 +3659,7 @@ ML_METHOD("/*", MLStringT, MLStringT) {
 	size_t PatternLength = ml_string_length(Args[1]);
 	const char *SubjectEnd = Subject + ml_string_length(Args[0]);
 	ml_value_t *Results = ml_tuple(2);
-	const char *Next = memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
+	const char *Next = ml_memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
 	if (Next) {
 		ml_tuple_set(Results, 1, ml_string(Subject, Next - Subject));
 		Next += PatternLength;
@@ -3138,7 +3846,7 @@ ML_METHOD("contains", MLStringT, MLStringT) {
 	size_t SubjectLength = ml_string_length(Args[0]);
 	const char *Pattern = ml_string_value(Args[1]);
 	size_t PatternLength = ml_string_length(Args[1]);
-	return memmem(Subject, SubjectLength, Pattern, PatternLength) ? Args[0] : MLNil;
+	return ml_memmem(Subject, SubjectLength, Pattern, PatternLength) ? Args[0] : MLNil;
 }
 
 ML_METHOD("find", MLStringT, MLStringT) {
@@ -3152,7 +3860,7 @@ ML_METHOD("find", MLStringT, MLStringT) {
 	size_t HaystackLength = ml_string_length(Args[0]);
 	const char *Needle = ml_string_value(Args[1]);
 	size_t NeedleLength = ml_string_length(Args[1]);
-	const char *Match = memmem(Haystack, HaystackLength, Needle, NeedleLength);
+	const char *Match = ml_memmem(Haystack, HaystackLength, Needle, NeedleLength);
 	if (Match) {
 		return ml_integer(1 + utf8_position(Haystack, Match));
 	} else {
@@ -3171,7 +3879,7 @@ ML_METHOD("find2", MLStringT, MLStringT) {
 	size_t HaystackLength = ml_string_length(Args[0]);
 	const char *Needle = ml_string_value(Args[1]);
 	size_t NeedleLength = ml_string_length(Args[1]);
-	const char *Match = memmem(Haystack, HaystackLength, Needle, NeedleLength);
+	const char *Match = ml_memmem(Haystack, HaystackLength, Needle, NeedleLength);
 	if (Match) {
 		return ml_tuplev(2, ml_integer(1 + utf8_position(Haystack, Match)), Args[1]);
 	} else {
@@ -3192,7 +3900,7 @@ ML_METHOD("find", MLStringT, MLStringT, MLIntegerT) {
 	if (!Subject.Length) return MLNil;
 	const char *Needle = ml_string_value(Args[1]);
 	size_t NeedleLength = ml_string_length(Args[1]);
-	const char *Match = memmem(Subject.Chars, Subject.Length, Needle, NeedleLength);
+	const char *Match = ml_memmem(Subject.Chars, Subject.Length, Needle, NeedleLength);
 	if (Match) {
 		return ml_integer(1 + utf8_position(ml_string_value(Args[0]), Match));
 	} else {
@@ -3213,7 +3921,7 @@ ML_METHOD("find2", MLStringT, MLStringT, MLIntegerT) {
 	if (!Subject.Length) return MLNil;
 	const char *Needle = ml_string_value(Args[1]);
 	size_t NeedleLength = ml_string_length(Args[1]);
-	const char *Match = memmem(Subject.Chars, Subject.Length, Needle, NeedleLength);
+	const char *Match = ml_memmem(Subject.Chars, Subject.Length, Needle, NeedleLength);
 	if (Match) {
 		return ml_tuplev(2, ml_integer(1 + utf8_position(ml_string_value(Args[0]), Match)), Args[1]);
 	} else {
@@ -3229,6 +3937,7 @@ ML_METHOD("contains", MLStringT, MLRegexT) {
 //$= "The cat snored as he slept":contains(r"[a-z]{3}")
 //$= "The cat snored as he slept":contains(r"[0-9]+")
 	const char *Haystack = ml_string_value(Args[0]);
+	if (ml_regex_rejects(Args[1], Haystack, ml_string_length(Args[0]))) return MLNil;
 	regex_t *Regex = ml_regex_value(Args[1]);
 	regmatch_t Matches[1];
 #ifdef ML_TRE
@@ -3257,6 +3966,7 @@ ML_METHOD("find", MLStringT, MLRegexT) {
 //$= "The cat snored as he slept":find(r"[a-z]{3}")
 //$= "The cat snored as he slept":find(r"[0-9]+")
 	const char *Haystack = ml_string_value(Args[0]);
+	if (ml_regex_rejects(Args[1], Haystack, ml_string_length(Args[0]))) return MLNil;
 	regex_t *Regex = ml_regex_value(Args[1]);
 	regmatch_t Matches[1];
 #ifdef ML_TRE
@@ -3285,6 +3995,7 @@ ML_METHOD("find2", MLStringT, MLRegexT) {
 //$= "The cat snored as he slept":find2(r"[a-z]{3}")
 //$= "The cat snored as he slept":find2(r"[0-9]+")
 	const char *Haystack = ml_string_value(Args[0]);
+	if (ml_regex_rejects(Args[1], Haystack, ml_string_length(Args[0]))) return MLNil;
 	regex_t *Regex = ml_regex_value(Args[1]);
 	regmatch_t Matches[Regex->re_nsub + 1];
 #ifdef ML_TRE
@@ -3326,6 +4037,7 @@ ML_METHOD("find", MLStringT, MLRegexT, MLIntegerT) {
 //$= "The cat snored as he slept":find(r"s[a-z]+", 10)
 //$= "The cat snored as he slept":find(r"s[a-z]+", -6)
 	subject_t Subject = utf8_subject(Args[0], ml_integer_value(Args[2]));
+	if (ml_regex_rejects(Args[1], Subject.Chars, Subject.Length)) return MLNil;
 	regex_t *Regex = ml_regex_value(Args[1]);
 	regmatch_t Matches[1];
 #ifdef ML_TRE
@@ -3355,6 +4067,7 @@ ML_METHOD("find2", MLStringT, MLRegexT, MLIntegerT) {
 //$= "The cat snored as he slept":find2(r"s[a-z]+", 10)
 //$= "The cat snored as he slept":find2(r"s[a-z]+", -6)
 	subject_t Subject = utf8_subject(Args[0], ml_integer_value(Args[2]));
+	if (ml_regex_rejects(Args[1], Subject.Chars, Subject.Length)) return MLNil;
 	regex_t *Regex = ml_regex_value(Args[1]);
 	regmatch_t Matches[Regex->re_nsub + 1];
 #ifdef ML_TRE
@@ -3402,7 +4115,7 @@ ML_METHOD("find2", MLStringT, MLStringT, MLTupleIntegerStringT) {
 	subject_t Subject = utf8_subject(Args[0], Start);
 	const char *Needle = ml_string_value(Args[1]);
 	size_t NeedleLength = ml_string_length(Args[1]);
-	const char *Match = memmem(Subject.Chars, Subject.Length, Needle, NeedleLength);
+	const char *Match = ml_memmem(Subject.Chars, Subject.Length, Needle, NeedleLength);
 	if (Match) {
 		return ml_tuplev(2, ml_integer(1 + utf8_position(ml_string_value(Args[0]), Match)), Args[1]);
 	} else {
@@ -3421,6 +4134,7 @@ ML_METHOD("find2", MLStringT, MLRegexT, MLTupleIntegerStringT) {
 //$= "The cat snored as he slept":find2(r"s[a-z]+", -6)
 	int Start = ml_integer_value(ml_tuple_get(Args[2], 1)) + ml_string_length(ml_tuple_get(Args[2], 2));
 	subject_t Subject = utf8_subject(Args[0], Start);
+	if (ml_regex_rejects(Args[1], Subject.Chars, Subject.Length)) return MLNil;
 	regex_t *Regex = ml_regex_value(Args[1]);
 	regmatch_t Matches[Regex->re_nsub + 1];
 #ifdef ML_TRE
@@ -3495,6 +4209,7 @@ ML_METHOD("%", MLStringT, MLRegexT) {
 }
 
 int ml_regex_match(ml_value_t *Value, const char *Subject, int Length) {
+	if (ml_regex_rejects(Value, Subject, Length)) return 1;
 	regex_t *Regex = ml_regex_value(Value);
 #ifdef ML_TRE
 	switch (regnexec(Regex, Subject, Length, 0, NULL, 0)) {
@@ -3515,6 +4230,7 @@ ML_METHOD("?", MLStringT, MLRegexT) {
 //$= "2022-03-08" ? r"([0-9]+)[/-]([0-9]+)[/-]([0-9]+)"
 //$= "Not a date" ? r"([0-9]+)[/-]([0-9]+)[/-]([0-9]+)"
 	const char *Subject = ml_string_value(Args[0]);
+	if (ml_regex_rejects(Args[1], Subject, ml_string_length(Args[0]))) return MLNil;
 	regex_t *Regex = ml_regex_value(Args[1]);
 	regmatch_t Matches[Regex->re_nsub + 1];
 #ifdef ML_TRE
@@ -3547,6 +4263,7 @@ ML_METHOD("!?", MLStringT, MLRegexT) {
 //$= "2022-03-08" !? r"([0-9]+)[/-]([0-9]+)[/-]([0-9]+)"
 //$= "Not a date" !? r"([0-9]+)[/-]([0-9]+)[/-]([0-9]+)"
 	const char *Subject = ml_string_value(Args[0]);
+	if (ml_regex_rejects(Args[1], Subject, ml_string_length(Args[0]))) return Args[0];
 	regex_t *Regex = ml_regex_value(Args[1]);
 	regmatch_t Matches[Regex->re_nsub + 1];
 #ifdef ML_TRE
@@ -3594,6 +4311,7 @@ ML_METHOD("starts", MLStringT, MLRegexT) {
 //$= "Hello world":starts(r"[A-Z]")
 //$= "Hello world":starts(r"[0-9]")
 	const char *Subject = ml_string_value(Args[0]);
+	if (ml_regex_rejects(Args[1], Subject, ml_string_length(Args[0]))) return MLNil;
 	regex_t *Regex = ml_regex_value(Args[1]);
 	regmatch_t Matches[Regex->re_nsub + 1];
 #ifdef ML_TRE
@@ -3645,7 +4363,7 @@ ML_METHOD("after", MLStringT, MLStringT) {
 	size_t HaystackLength = ml_string_length(Args[0]);
 	const char *Needle = ml_string_value(Args[1]);
 	size_t NeedleLength = ml_string_length(Args[1]);
-	const char *Match = memmem(Haystack, HaystackLength, Needle, NeedleLength);
+	const char *Match = ml_memmem(Haystack, HaystackLength, Needle, NeedleLength);
 	if (Match) {
 		Match += NeedleLength;
 		int Length = HaystackLength - (Match - Haystack);
@@ -3671,7 +4389,7 @@ ML_METHOD("after", MLStringT, MLStringT, MLIntegerT) {
 	int Index = ml_integer_value(Args[2]);
 	if (Index > 0) {
 		for (;;) {
-			const char *Match = memmem(Haystack, HaystackLength, Needle, NeedleLength);
+			const char *Match = ml_memmem(Haystack, HaystackLength, Needle, NeedleLength);
 			if (!Match) return MLNil;
 			if (--Index) {
 				Haystack = Match + NeedleLength;
@@ -3710,7 +4428,7 @@ ML_METHOD("before", MLStringT, MLStringT) {
 	size_t HaystackLength = ml_string_length(Args[0]);
 	const char *Needle = ml_string_value(Args[1]);
 	size_t NeedleLength = ml_string_length(Args[1]);
-	const char *Match = memmem(Haystack, HaystackLength, Needle, NeedleLength);
+	const char *Match = ml_memmem(Haystack, HaystackLength, Needle, NeedleLength);
 	if (Match) {
 		return ml_string(Haystack, Match - Haystack);
 	} else {
@@ -3734,7 +4452,7 @@ ML_METHOD("before", MLStringT, MLStringT, MLIntegerT) {
 	int Index = ml_integer_value(Args[2]);
 	if (Index > 0) {
 		for (;;) {
-			const char *Match = memmem(Haystack, HaystackLength, Needle, NeedleLength);
+			const char *Match = ml_memmem(Haystack, HaystackLength, Needle, NeedleLength);
 			if (!Match) return MLNil;
 			if (--Index) {
 				Haystack = Match + NeedleLength;
@@ -3774,12 +4492,12 @@ ML_METHOD("replace", MLStringT, MLStringT, MLStringT) {
 	const char *Replace = ml_string_value(Args[2]);
 	int ReplaceLength = ml_string_length(Args[2]);
 	ml_stringbuffer_t Buffer[1] = {ML_STRINGBUFFER_INIT};
-	const char *Find = memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
+	const char *Find = ml_memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
 	while (Find) {
 		if (Find > Subject) ml_stringbuffer_write(Buffer, Subject, Find - Subject);
 		ml_stringbuffer_write(Buffer, Replace, ReplaceLength);
 		Subject = Find + PatternLength;
-		Find = memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
+		Find = ml_memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
 	}
 	if (SubjectEnd > Subject) {
 		ml_stringbuffer_write(Buffer, Subject, SubjectEnd - Subject);
@@ -3849,12 +4567,12 @@ ML_METHOD("replace2", MLStringT, MLStringT, MLStringT) {
 	int ReplaceLength = ml_string_length(Args[2]);
 	ml_stringbuffer_t Buffer[1] = {ML_STRINGBUFFER_INIT};
 	int Total = 0;
-	const char *Find = memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
+	const char *Find = ml_memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
 	while (Find) {
 		if (Find > Subject) ml_stringbuffer_write(Buffer, Subject, Find - Subject);
 		ml_stringbuffer_write(Buffer, Replace, ReplaceLength);
 		Subject = Find + PatternLength;
-		Find = memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
+		Find = ml_memmem(Subject, SubjectEnd - Subject, Pattern, PatternLength);
 		++Total;
 	}
 	if (SubjectEnd > Subject) {
@@ -3987,7 +4705,7 @@ static void ml_str_replacement_next(ml_str_replacement_state_t *State, ml_value_
 				}
 				}
 			} else {
-				const char *Find = memmem(Subject, Length, Test->Pattern.String, Test->PatternLength);
+				const char *Find = ml_memmem(Subject, Length, Test->Pattern.String, Test->PatternLength);
 				if (Find) {
 					int Start = Find - Subject;
 					if (Start < MatchStart) {
@@ -4376,6 +5094,7 @@ static void ml_regex_call(ml_state_t *Caller, ml_regex_t *Value, int Count, ml_v
 	ML_CHECKX_ARG_TYPE(0, MLStringT);
 	regex_t *Regex = Value->Value;
 	const char *Subject = ml_string_value(ml_deref(Args[0]));
+	if (ml_regex_rejects((ml_value_t *)Value, Subject, ml_string_length(ml_deref(Args[0])))) ML_RETURN(MLNil);
 	regmatch_t Matches[Regex->re_nsub + 1];
 #ifdef ML_TRE
 	int Length = ml_string_length(Args[0]);
@@ -4415,49 +5134,85 @@ ML_TYPE(MLRegexT, (MLFunctionT), "regex",
 	.Constructor = (ml_value_t *)MLRegex
 );
 
-#ifdef ML_STRINGCACHE
+#define ML_REGEX_CACHE_SIZE 64
 
-static weakmap_t RegexCache[1] = {WEAKMAP_INIT};
+typedef struct {
+	ml_regex_t *Regex;
+	long Hash;
+	int Length;
+} ml_regex_cache_entry_t;
 
-static void *_ml_regex(const char *Pattern, int Length) {
-	ml_regex_t *Regex = new(ml_regex_t);
-	Regex->Type = MLRegexT;
-	char *Copy = snew(Length + 1);
-	memcpy(Copy, Pattern, Length);
-	Copy[Length] = 0;
-	Regex->Pattern = Copy;
-#ifdef ML_TRE
-	int Error = regncomp(Regex->Value, Pattern, Length, REG_EXTENDED);
-#else
-	int Error = regcomp(Regex->Value, Pattern, REG_EXTENDED);
+// Most recently used compiled patterns, kept in order of last use.
+static ml_regex_cache_entry_t RegexCache[ML_REGEX_CACHE_SIZE];
+static int RegexCacheCount = 0;
+
+#ifdef ML_HOSTTHREADS
+static pthread_mutex_t RegexCacheLock[1] = {PTHREAD_MUTEX_INITIALIZER};
 #endif
-	if (Error) {
-		size_t ErrorSize = regerror(Error, Regex->Value, NULL, 0);
-		char *ErrorMessage = snew(ErrorSize + 1);
-		regerror(Error, Regex->Value, ErrorMessage, ErrorSize);
-		return ml_error("RegexError", "%s", ErrorMessage);
-	}
-	return (ml_value_t *)Regex;
+
+static size_t ml_regex_cache_usage(void *Data) {
+	return RegexCacheCount;
 }
 
+static void ml_regex_cache_clear(void *Data) {
+#ifdef ML_HOSTTHREADS
+	pthread_mutex_lock(RegexCacheLock);
+#endif
+	memset(RegexCache, 0, sizeof(RegexCache));
+	RegexCacheCount = 0;
+#ifdef ML_HOSTTHREADS
+	pthread_mutex_unlock(RegexCacheLock);
 #endif
+}
 
-ml_value_t *ml_regex(const char *Pattern, int Length) {
-#ifdef ML_STRINGCACHE
-	if (Length < ML_STRINGCACHE_MAX) {
-		return weakmap_insert(RegexCache, Pattern, Length, _ml_regex);
+static ml_regex_t *ml_regex_cache_find(const char *Pattern, int Length, long Hash) {
+	ml_regex_t *Regex = NULL;
+#ifdef ML_HOSTTHREADS
+	pthread_mutex_lock(RegexCacheLock);
+#endif
+	for (int I = 0; I < RegexCacheCount; ++I) {
+		ml_regex_cache_entry_t *Entry = RegexCache + I;
+		if (Entry->Hash != Hash || Entry->Length != Length) continue;
+		if (memcmp(Entry->Regex->Pattern, Pattern, Length)) continue;
+		ml_regex_cache_entry_t Found = *Entry;
+		memmove(RegexCache + 1, RegexCache, I * sizeof(ml_regex_cache_entry_t));
+		RegexCache[0] = Found;
+		Regex = Found.Regex;
+		break;
 	}
+#ifdef ML_HOSTTHREADS
+	pthread_mutex_unlock(RegexCacheLock);
 #endif
-	ml_regex_t *Regex = new(ml_regex_t);
+	return Regex;
+}
+
+static void ml_regex_cache_insert(ml_regex_t *Regex, int Length, long Hash) {
+#ifdef ML_HOSTTHREADS
+	pthread_mutex_lock(RegexCacheLock);
+#endif
+	if (RegexCacheCount < ML_REGEX_CACHE_SIZE) ++RegexCacheCount;
+	memmove(RegexCache + 1, RegexCache, (RegexCacheCount - 1) * sizeof(ml_regex_cache_entry_t));
+	RegexCache[0] = (ml_regex_cache_entry_t){Regex, Hash, Length};
+#ifdef ML_HOSTTHREADS
+	pthread_mutex_unlock(RegexCacheLock);
+#endif
+}
+
+static ml_value_t *ml_regex_compile(const char *Pattern, int Length) {
+	long Hash = 5381;
+	for (int I = 0; I < Length; ++I) Hash = ((Hash << 5) + Hash) + Pattern[I];
+	ml_regex_t *Regex = ml_regex_cache_find(Pattern, Length, Hash);
+	if (Regex) return (ml_value_t *)Regex;
+	Regex = new(ml_regex_t);
 	Regex->Type = MLRegexT;
 	char *Copy = snew(Length + 1);
 	memcpy(Copy, Pattern, Length);
 	Copy[Length] = 0;
 	Regex->Pattern = Copy;
 #ifdef ML_TRE
-	int Error = regncomp(Regex->Value, Pattern, Length, REG_EXTENDED);
+	int Error = regncomp(Regex->Value, Copy, Length, REG_EXTENDED);
 #else
-	int Error = regcomp(Regex->Value, Pattern, REG_EXTENDED);
+	int Error = regcomp(Regex->Value, Copy, REG_EXTENDED);
 #endif
 	if (Error) {
 		size_t ErrorSize = regerror(Error, Regex->Value, NULL, 0);
@@ -4465,27 +5220,19 @@ ml_value_t *ml_regex(const char *Pattern, int Length) {
 		regerror(Error, Regex->Value, ErrorMessage, ErrorSize);
 		return ml_error("RegexError", "%s", ErrorMessage);
 	}
+	Regex->Dfa = ml_dfa(Copy, Length);
+	ml_regex_cache_insert(Regex, Length, Hash);
 	return (ml_value_t *)Regex;
 }
 
+ml_value_t *ml_regex(const char *Pattern, int Length) {
+	return ml_regex_compile(Pattern, Length);
+}
+
 ml_value_t *ml_regexi(const char *Pattern0, int Length) {
-	ml_regex_t *Regex = new(ml_regex_t);
-	Regex->Type = MLRegexT;
 	char *Pattern;
 	Length = GC_asprintf(&Pattern, "(?i)%s", Pattern0);
-	Regex->Pattern = Pattern;
-#ifdef ML_TRE
-	int Error = regncomp(Regex->Value, Pattern, Length, REG_EXTENDED);
-#else
-	int Error = regcomp(Regex->Value, Pattern, REG_EXTENDED);
-#endif
-	if (Error) {
-		size_t ErrorSize = regerror(Error, Regex->Value, NULL, 0);
-		char *ErrorMessage = snew(ErrorSize + 1);
-		regerror(Error, Regex->Value, ErrorMessage, ErrorSize);
-		return ml_error("RegexError", "%s", ErrorMessage);
-	}
-	return (ml_value_t *)Regex;
+	return ml_regex_compile(Pattern, Length);
 }
 
 static void ML_TYPED_FN(ml_value_sha256, MLRegexT, ml_regex_t *Value, ml_hash_chain_t *Chain, unsigned char Hash[SHA256_BLOCK_SIZE]) {
@@ -4711,6 +5458,7 @@ static void ml_string_switch(ml_state_t *Caller, ml_string_switch_t *Switch, int
 				if (!memcmp(Subject, Case->String->Value, Length)) ML_RETURN(Case->Index);
 			}
 		} else if (Case->Regex) {
+			if (ml_regex_rejects((ml_value_t *)Case->Regex, Subject, Length)) continue;
 #ifdef ML_TRE
 			int Length = ml_string_length(Args[0]);
 			if (!regnexec(Case->Regex->Value, Subject, Length, 0, NULL, 0)) {
@@ -5092,6 +5840,19 @@ ml_value_t *ml_stringbuffer_to_buffer(ml_stringbuffer_t *Buffer) {
 	return ml_buffer(Chars, Length);
 }
 
+ml_value_t *ml_stringbuffer_intern(ml_stringbuffer_t *Buffer) {
+	int Start = Buffer->Start, Length = Buffer->Length;
+	if (Length == 0) return (ml_value_t *)MLEmptyString;
+	if (Start + Length <= ML_STRINGBUFFER_NODE_SIZE) {
+		ml_value_t *String = ml_string_intern(Buffer->Head->Chars + Start, Length);
+		ml_stringbuffer_clear(Buffer);
+		return String;
+	}
+	char *Chars = snew(Length + 1);
+	ml_stringbuffer_finish(Buffer, Chars);
+	return ml_string_intern(Chars, Length);
+}
+
 ml_value_t *ml_stringbuffer_to_string(ml_stringbuffer_t *Buffer) {
 	int Start = Buffer->Start, Length = Buffer->Length;
 	if (Length == 0) return (ml_value_t *)MLEmptyString;
@@ -5486,14 +6247,405 @@ ML_METHOD("splice", MLStringTableT, MLIntegerT, MLIntegerT, MLStringT) {
 	return (ml_value_t *)Table;
 }
 
+struct ml_rope_t {
+	ml_type_t *Type;
+	ml_rope_t *Left, *Right;
+	const char *Chars;
+	ml_value_t *String;
+	size_t Length, Count;
+	int Height;
+};
+
+static long ml_rope_hash(ml_value_t *Rope, ml_hash_chain_t *Chain) {
+	return ml_string_hash((ml_string_t *)ml_rope_string(Rope), Chain);
+}
+
+ML_TYPE(MLStringRopeT, (), "string::rope",
+//@string::rope
+// An immutable string stored as a balanced tree of shared pieces. Concatenation and slicing take :math:`O(log n)` time and only copy small pieces, the contents are only flattened into a single string when required.
+// Ropes can be compared with and used in place of strings in the common string methods (e.g. :mini:`=`, :mini:`find`, :mini:`?`), these flatten the rope first.
+	.hash = (void *)ml_rope_hash
+);
+
+#define ML_ROPE_LEAF_SIZE ML_STRINGBUFFER_NODE_SIZE
+#define ML_ROPE_UNCOUNTED ((size_t)-1)
+
+static ml_rope_t MLEmptyRope[1] = {{MLStringRopeT, NULL, NULL, "", NULL, 0, 0, 0}};
+
+static ml_rope_t *ml_rope_leaf(const char *Chars, size_t Length) {
+	if (!Length) return MLEmptyRope;
+	ml_rope_t *Rope = new(ml_rope_t);
+	Rope->Type = MLStringRopeT;
+	Rope->Chars = Chars;
+	Rope->Length = Length;
+	Rope->Count = ML_ROPE_UNCOUNTED;
+	return Rope;
+}
+
+ml_value_t *ml_rope(const char *Chars, size_t Length) {
+	return (ml_value_t *)ml_rope_leaf(Chars, Length);
+}
+
+static ml_rope_t *ml_rope_node(ml_rope_t *Left, ml_rope_t *Right) {
+	ml_rope_t *Rope = new(ml_rope_t);
+	Rope->Type = MLStringRopeT;
+	Rope->Left = Left;
+	Rope->Right = Right;
+	Rope->Length = Left->Length + Right->Length;
+	if (Left->Count == ML_ROPE_UNCOUNTED || Right->Count == ML_ROPE_UNCOUNTED) {
+		Rope->Count = ML_ROPE_UNCOUNTED;
+	} else {
+		Rope->Count = Left->Count + Right->Count;
+	}
+	Rope->Height = (Left->Height > Right->Height ? Left->Height : Right->Height) + 1;
+	return Rope;
+}
+
+static char *ml_rope_copy(char *Chars, ml_rope_t *Rope) {
+	while (!Rope->String && Rope->Left) {
+		Chars = ml_rope_copy(Chars, Rope->Left);
+		Rope = Rope->Right;
+	}
+	if (Rope->String) return mempcpy(Chars, ml_string_value(Rope->String), Rope->Length);
+	return mempcpy(Chars, Rope->Chars, Rope->Length);
+}
+
+static size_t ml_rope_count(ml_rope_t *Rope) {
+	if (Rope->Count != ML_ROPE_UNCOUNTED) return Rope->Count;
+	size_t Count;
+	if (Rope->Left) {
+		Count = ml_rope_count(Rope->Left) + ml_rope_count(Rope->Right);
+	} else {
+		Count = 0;
+		const char *Chars = Rope->Chars;
+		for (size_t I = 0; I < Rope->Length; ++I) Count += !utf8_is_continuation(Chars[I]);
+	}
+	return Rope->Count = Count;
+}
+
+static ml_rope_t *ml_rope_rotate_left(ml_rope_t *Rope) {
+	ml_rope_t *Right = Rope->Right;
+	return ml_rope_node(ml_rope_node(Rope->Left, Right->Left), Right->Right);
+}
+
+static ml_rope_t *ml_rope_rotate_right(ml_rope_t *Rope) {
+	ml_rope_t *Left = Rope->Left;
+	return ml_rope_node(Left->Left, ml_rope_node(Left->Right, Rope->Right));
+}
+
+static ml_rope_t *ml_rope_join_right(ml_rope_t *A, ml_rope_t *B) {
+	// Assumes A->Height > B->Height + 1.
+	ml_rope_t *Left = A->Left, *Right = A->Right, *Node;
+	if (Right->Height <= B->Height + 1) {
+		Node = ml_rope_node(Right, B);
+		if (Node->Height <= Left->Height + 1) return ml_rope_node(Left, Node);
+		return ml_rope_rotate_left(ml_rope_node(Left, ml_rope_rotate_right(Node)));
+	}
+	Node = ml_rope_join_right(Right, B);
+	if (Node->Height <= Left->Height + 1) return ml_rope_node(Left, Node);
+	return ml_rope_rotate_left(ml_rope_node(Left, Node));
+}
+
+static ml_rope_t *ml_rope_join_left(ml_rope_t *A, ml_rope_t *B) {
+	// Assumes B->Height > A->Height + 1.
+	ml_rope_t *Left = B->Left, *Right = B->Right, *Node;
+	if (Left->Height <= A->Height + 1) {
+		Node = ml_rope_node(A, Left);
+		if (Node->Height <= Right->Height + 1) return ml_rope_node(Node, Right);
+		return ml_rope_rotate_right(ml_rope_node(ml_rope_rotate_left(Node), Right));
+	}
+	Node = ml_rope_join_left(A, Left);
+	if (Node->Height <= Right->Height + 1) return ml_rope_node(Node, Right);
+	return ml_rope_rotate_right(ml_rope_node(Node, Right));
+}
+
+static ml_rope_t *ml_rope_append_leaf(ml_rope_t *A, ml_rope_t *B) {
+	// Merges the small leaf B into the last leaf of A if it fits, otherwise returns NULL.
+	if (A->Left) {
+		ml_rope_t *Right = ml_rope_append_leaf(A->Right, B);
+		return Right ? ml_rope_node(A->Left, Right) : NULL;
+	}
+	size_t Length = A->Length + B->Length;
+	if (Length > ML_ROPE_LEAF_SIZE) return NULL;
+	char *Chars = snew(Length);
+	memcpy(mempcpy(Chars, A->Chars, A->Length), B->Chars, B->Length);
+	return ml_rope_leaf(Chars, Length);
+}
+
+static ml_rope_t *ml_rope_prepend_leaf(ml_rope_t *A, ml_rope_t *B) {
+	// Merges the small leaf A into the first leaf of B if it fits, otherwise returns NULL.
+	if (B->Left) {
+		ml_rope_t *Left = ml_rope_prepend_leaf(A, B->Left);
+		return Left ? ml_rope_node(Left, B->Right) : NULL;
+	}
+	size_t Length = A->Length + B->Length;
+	if (Length > ML_ROPE_LEAF_SIZE) return NULL;
+	char *Chars = snew(Length);
+	memcpy(mempcpy(Chars, A->Chars, A->Length), B->Chars, B->Length);
+	return ml_rope_leaf(Chars, Length);
+}
+
+static ml_rope_t *ml_rope_join(ml_rope_t *A, ml_rope_t *B) {
+	if (!A->Length) return B;
+	if (!B->Length) return A;
+	size_t Length = A->Length + B->Length;
+	if (Length <= ML_ROPE_LEAF_SIZE) {
+		char *Chars = snew(Length);
+		ml_rope_copy(ml_rope_copy(Chars, A), B);
+		return ml_rope_leaf(Chars, Length);
+	}
+	ml_rope_t *Rope;
+	if (!B->Left && B->Length < ML_ROPE_LEAF_SIZE && (Rope = ml_rope_append_leaf(A, B))) return Rope;
+	if (!A->Left && A->Length < ML_ROPE_LEAF_SIZE && (Rope = ml_rope_prepend_leaf(A, B))) return Rope;
+	if (A->Height > B->Height + 1) return ml_rope_join_right(A, B);
+	if (B->Height > A->Height + 1) return ml_rope_join_left(A, B);
+	return ml_rope_node(A, B);
+}
+
+ml_value_t *ml_rope_concat(ml_value_t *A, ml_value_t *B) {
+	return (ml_value_t *)ml_rope_join((ml_rope_t *)A, (ml_rope_t *)B);
+}
+
+static ml_rope_t *ml_rope_slice_bytes(ml_rope_t *Rope, size_t Start, size_t End) {
+	if (Start == 0 && End == Rope->Length) return Rope;
+	if (Start >= End) return MLEmptyRope;
+	if (!Rope->Left) return ml_rope_leaf(Rope->Chars + Start, End - Start);
+	size_t Split = Rope->Left->Length;
+	if (End <= Split) return ml_rope_slice_bytes(Rope->Left, Start, End);
+	if (Start >= Split) return ml_rope_slice_bytes(Rope->Right, Start - Split, End - Split);
+	return ml_rope_join(
+		ml_rope_slice_bytes(Rope->Left, Start, Split),
+		ml_rope_slice_bytes(Rope->Right, 0, End - Split)
+	);
+}
+
+ml_value_t *ml_rope_slice(ml_value_t *Rope, size_t Start, size_t End) {
+	return (ml_value_t *)ml_rope_slice_bytes((ml_rope_t *)Rope, Start, End);
+}
+
+static size_t ml_rope_offset(ml_rope_t *Rope, size_t Index) {
+	// Returns the byte offset of the character at Index (from 0), or the length of Rope if Index equals its count.
+	size_t Offset = 0;
+	while (Rope->Left) {
+		size_t Count = ml_rope_count(Rope->Left);
+		if (Index < Count) {
+			Rope = Rope->Left;
+		} else {
+			Index -= Count;
+			Offset += Rope->Left->Length;
+			Rope = Rope->Right;
+		}
+	}
+	const char *Chars = Rope->Chars;
+	size_t I = 0;
+	for (; I < Rope->Length; ++I) {
+		if (!utf8_is_continuation(Chars[I]) && !Index--) break;
+	}
+	return Offset + I;
+}
+
+size_t ml_rope_length(ml_value_t *Rope) {
+	return ((ml_rope_t *)Rope)->Length;
+}
+
+ml_value_t *ml_rope_string(ml_value_t *Value) {
+	ml_rope_t *Rope = (ml_rope_t *)Value;
+	if (Rope->String) return Rope->String;
+	char *Chars = snew(Rope->Length + 1);
+	*ml_rope_copy(Chars, Rope) = 0;
+	return Rope->String = ml_string(Chars, Rope->Length);
+}
+
+ml_value_t *ml_stringbuffer_to_rope(ml_stringbuffer_t *Buffer) {
+	ml_rope_t *Rope = MLEmptyRope;
+	size_t Start = Buffer->Start;
+	for (ml_stringbuffer_node_t *Node = Buffer->Head; Node; Node = Node->Next) {
+		size_t Limit = ML_STRINGBUFFER_NODE_SIZE;
+		if (Node == Buffer->Tail) Limit -= Buffer->Space;
+		Rope = ml_rope_join(Rope, ml_rope_leaf(Node->Chars + Start, Limit - Start));
+		Start = 0;
+	}
+	// The nodes are now shared with the rope so they are not returned to the node cache.
+	Buffer->Head = Buffer->Tail = NULL;
+	Buffer->Length = Buffer->Space = Buffer->Start = 0;
+	return (ml_value_t *)Rope;
+}
+
+ML_METHOD(MLStringRopeT) {
+//>string::rope
+// Returns an empty rope.
+	return (ml_value_t *)MLEmptyRope;
+}
+
+ML_METHOD(MLStringRopeT, MLStringT) {
+//<String
+//>string::rope
+// Returns a rope with the contents of :mini:`String`, sharing its characters.
+//$= string::rope("Hello world")
+	ml_rope_t *Rope = ml_rope_leaf(ml_string_value(Args[0]), ml_string_length(Args[0]));
+	if (Rope->Length) Rope->String = Args[0];
+	return (ml_value_t *)Rope;
+}
+
+ML_METHOD(MLStringRopeT, MLStringRopeT) {
+//<Rope
+//>string::rope
+// Returns :mini:`Rope`.
+	return Args[0];
+}
+
+ML_METHOD(MLStringRopeT, MLStringBufferT) {
+//<Buffer
+//>string::rope
+// Returns a rope with the contents of :mini:`Buffer` and clears :mini:`Buffer`. The rope takes over the storage of :mini:`Buffer` without copying.
+//$- let B := string::buffer()
+//$- B:write("Hello world")
+//$= string::rope(B)
+//$= B:length
+	return ml_stringbuffer_to_rope((ml_stringbuffer_t *)Args[0]);
+}
+
+ML_METHOD("+", MLStringRopeT, MLStringRopeT) {
+//<A
+//<B
+//>string::rope
+// Returns :mini:`A` and :mini:`B` concatenated, sharing the contents of both.
+	return (ml_value_t *)ml_rope_join((ml_rope_t *)Args[0], (ml_rope_t *)Args[1]);
+}
+
+ML_METHOD("+", MLStringRopeT, MLStringT) {
+//<A
+//<B
+//>string::rope
+// Returns :mini:`A` and :mini:`B` concatenated, sharing the contents of both.
+//$- var R := string::rope()
+//$- for I in 1 .. 5 do R := R + string(I) end
+//$= R
+	ml_rope_t *Rope = ml_rope_leaf(ml_string_value(Args[1]), ml_string_length(Args[1]));
+	return (ml_value_t *)ml_rope_join((ml_rope_t *)Args[0], Rope);
+}
+
+ML_METHOD("+", MLStringT, MLStringRopeT) {
+//<A
+//<B
+//>string::rope
+// Returns :mini:`A` and :mini:`B` concatenated, sharing the contents of both.
+	ml_rope_t *Rope = ml_rope_leaf(ml_string_value(Args[0]), ml_string_length(Args[0]));
+	return (ml_value_t *)ml_rope_join(Rope, (ml_rope_t *)Args[1]);
+}
+
+ML_METHOD("length", MLStringRopeT) {
+//<Rope
+//>integer
+// Returns the number of UTF-8 characters in :mini:`Rope`. Use :mini:`:size` to get the number of bytes.
+//$= string::rope("λ:😀 → 😺"):length
+	return ml_integer(ml_rope_count((ml_rope_t *)Args[0]));
+}
+
+ML_METHOD("size", MLStringRopeT) {
+//<Rope
+//>integer
+// Returns the number of bytes in :mini:`Rope`.
+//$= string::rope("λ:😀 → 😺"):size
+	return ml_integer(((ml_rope_t *)Args[0])->Length);
+}
+
+ML_METHOD("[]", MLStringRopeT, MLIntegerT) {
+//<Rope
+//<Index
+//>string|nil
+// Returns the substring of :mini:`Rope` of length 1 at :mini:`Index`.
+//$- let R := string::rope("λ:😀") + " → 😺"
+//$= map(-7 .. 7 => (2, 2 -> R[_]))
+	ml_rope_t *Rope = (ml_rope_t *)Args[0];
+	int64_t Length = ml_rope_count(Rope);
+	int64_t Index = ml_integer_value(Args[1]);
+	if (Index <= 0) Index += Length + 1;
+	if (Index <= 0 || Index > Length) return MLNil;
+	size_t Start = ml_rope_offset(Rope, Index - 1);
+	size_t End = ml_rope_offset(Rope, Index);
+	return ml_rope_string((ml_value_t *)ml_rope_slice_bytes(Rope, Start, End));
+}
+
+ML_METHOD("[]", MLStringRopeT, MLIntegerT, MLIntegerT) {
+//<Rope
+//<Start
+//<End
+//>string::rope|nil
+// Returns the subrope of :mini:`Rope` from :mini:`Start` to :mini:`End - 1` inclusively, sharing the contents of :mini:`Rope`.
+//$- let R := string::rope("λ:😀") + " → 😺"
+//$= R[2, -1]
+	ml_rope_t *Rope = (ml_rope_t *)Args[0];
+	int64_t Length = ml_rope_count(Rope);
+	int64_t Lo = ml_integer_value(Args[1]);
+	int64_t Hi = ml_integer_value(Args[2]);
+	if (Lo <= 0) Lo += Length + 1;
+	if (Hi <= 0) Hi += Length + 1;
+	if (Lo <= 0 || Hi > Length + 1 || Lo > Hi) return MLNil;
+	size_t Start = ml_rope_offset(Rope, Lo - 1);
+	size_t End = ml_rope_offset(Rope, Hi - 1);
+	return (ml_value_t *)ml_rope_slice_bytes(Rope, Start, End);
+}
+
+ML_METHOD("string", MLStringRopeT) {
+//<Rope
+//>string
+// Returns the contents of :mini:`Rope` as a string. The string is cached in :mini:`Rope`.
+//$= (string::rope("Hello") + " world"):string
+	return ml_rope_string(Args[0]);
+}
+
+static void ml_rope_write(ml_stringbuffer_t *Buffer, ml_rope_t *Rope) {
+	while (!Rope->String && Rope->Left) {
+		ml_rope_write(Buffer, Rope->Left);
+		Rope = Rope->Right;
+	}
+	if (Rope->String) {
+		ml_stringbuffer_write(Buffer, ml_string_value(Rope->String), Rope->Length);
+	} else {
+		ml_stringbuffer_write(Buffer, Rope->Chars, Rope->Length);
+	}
+}
+
+ML_METHOD("append", MLStringBufferT, MLStringRopeT) {
+//<Buffer
+//<Rope
+// Appends the contents of :mini:`Rope` to :mini:`Buffer` without flattening it.
+	ml_rope_t *Rope = (ml_rope_t *)Args[1];
+	if (!Rope->Length) return MLNil;
+	ml_rope_write((ml_stringbuffer_t *)Args[0], Rope);
+	return MLSome;
+}
+
+static void ml_rope_string_method(ml_state_t *Caller, ml_value_t *Method, int Count, ml_value_t **Args) {
+	for (int I = 0; I < Count; ++I) {
+		if (ml_typeof(Args[I]) == MLStringRopeT) Args[I] = ml_rope_string(Args[I]);
+	}
+	return ml_call(Caller, Method, Count, Args);
+}
+
+static const char *MLRopeStringMethods[] = {
+	"=", "!=", "<", ">", "<=", ">=", "<>",
+	"?", "!?", "find", "find2", "starts", "ends", "contains", "before", "after",
+	"/", "/*", "*/", "%", "replace", "replace2", "trim", "ltrim", "rtrim", "lower", "upper", "title",
+	NULL
+};
+
 void ml_string_init() {
 	setlocale(LC_ALL, "C.UTF-8");
 	GC_word StringBufferLayout[] = {1};
 	StringBufferDesc = GC_make_descriptor(StringBufferLayout, 1);
 	ml_cache_register("StringBufferNode", ml_stringbuffer_cache_usage, ml_stringbuffer_cache_clear, NULL);
+	ml_cache_register("Regex", ml_regex_cache_usage, ml_regex_cache_clear, NULL);
+#ifdef ML_STRING_SIMD
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) ml_memmem_simd = ml_memmem_avx2;
+#endif
 	stringmap_insert(MLStringT->Exports, "buffer", MLStringBufferT);
 	stringmap_insert(MLStringBufferT->Exports, "count", MLStringBufferCount);
 	stringmap_insert(MLStringT->Exports, "table", MLStringTableT);
+	stringmap_insert(MLStringT->Exports, "rope", MLStringRopeT);
+	stringmap_insert(MLStringT->Exports, "intern", MLStringIntern);
 	regcomp(IntFormat, "^\\s*%[-+ #'0]*[.0-9]*[diouxX]\\s*$", REG_NOSUB);
 	regcomp(LongFormat, "^\\s*%[-+ #'0]*[.0-9]*l[diouxX]\\s*$", REG_NOSUB);
 #ifdef ML_BIGINT
@@ -5507,6 +6659,15 @@ void ml_string_init() {
 #include "ml_string_init.c"
 	stringmap_insert(MLAddressT->Exports, "LE", ml_enum_value(MLByteOrderT, 1));
 	stringmap_insert(MLAddressT->Exports, "BE", ml_enum_value(MLByteOrderT, 2));
+	stringmap_insert(MLBufferT->Exports, "view", MLBufferViewT);
+	// Ropes are flattened and passed to the string methods which do not have rope specific versions.
+	for (const char **Name = MLRopeStringMethods; *Name; ++Name) {
+		ml_value_t *Method = ml_method(*Name);
+		ml_value_t *Function = ml_cfunctionx(Method, (ml_callbackx_t)ml_rope_string_method);
+		ml_method_definev(Method, Function, NULL, MLStringRopeT, MLAnyT, NULL);
+		ml_method_definev(Method, Function, NULL, MLStringT, MLStringRopeT, NULL);
+		ml_method_definev(Method, Function, MLAnyT, MLStringRopeT, NULL);
+	}
 	ml_method_definev(ml_method("+"), (ml_value_t *)MLAddStringString, NULL, MLStringT, MLStringT, NULL);
 #ifdef ML_GENERICS
 	ml_type_t *TArgs[3] = {MLSequenceT, MLIntegerT, MLStringT};
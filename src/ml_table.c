@@ -200,6 +200,7 @@ static void ml_table_column_assign(ml_state_t *Caller, ml_table_column_t *Column
 		Data = snew(RowSize * Table->Capacity);
 	}
 	Array->Base.Value = Data + RowSize * Table->Offset;
+	Array->View = 1;
 	ml_array_copy_data(Source, Array->Base.Value);
 	Column->Values = Array;
 	ml_table_column_append(Table, Column);
@@ -241,6 +242,7 @@ ml_array_t *ml_table_insert_column(ml_table_t *Table, const char *Name, ml_array
 		Data = snew(RowSize * Table->Capacity);
 	}
 	Array->Base.Value = Data + RowSize * Table->Offset;
+	Array->View = 1;
 	ml_array_copy_data(Source, Array->Base.Value);
 	Column->Values = Array;
 	ml_table_column_append(Table, Column);
@@ -962,17 +964,7 @@ static ml_value_t *ML_TYPED_FN(ml_serialize, MLTableT, ml_table_t *Table) {
 	return Result;
 }
 
-ML_DESERIALIZER("table") {
-	ML_CHECK_ARG_COUNT(1);
-	ML_CHECK_ARG_TYPE(0, MLMapT);
-	ml_table_t *Table = (ml_table_t *)ml_table();
-	ML_MAP_FOREACH(Args[0], Iter) {
-		if (!ml_is(Iter->Key, MLStringT)) return ml_error("SerializationError", "Invalid table");
-		ml_array_t *Source = (ml_array_t *)ml_array_of(Iter->Value);
-		if (Source->Base.Type == MLErrorT) return (ml_value_t *)Source;
-		ml_value_t *Result = (ml_value_t *)ml_table_insert_column(Table, ml_string_value(Iter->Key), Source);
-		if (ml_is_error(Result)) return ml_error("SerializationError", "Invalid table");
-	}
+static ml_value_t *ml_table_init_rows(ml_table_t *Table) {
 	ml_table_column_t *Column = Table->Columns;
 	if (Column) {
 		size_t Length = Column->Values->Dimensions[0].Size;
@@ -991,8 +983,110 @@ ML_DESERIALIZER("table") {
 	return (ml_value_t *)Table;
 }
 
+ML_DESERIALIZER("table") {
+	ML_CHECK_ARG_COUNT(1);
+	ML_CHECK_ARG_TYPE(0, MLMapT);
+	ml_table_t *Table = (ml_table_t *)ml_table();
+	ML_MAP_FOREACH(Args[0], Iter) {
+		if (!ml_is(Iter->Key, MLStringT)) return ml_error("SerializationError", "Invalid table");
+		ml_array_t *Source = (ml_array_t *)ml_array_of(Iter->Value);
+		if (Source->Base.Type == MLErrorT) return (ml_value_t *)Source;
+		ml_value_t *Result = (ml_value_t *)ml_table_insert_column(Table, ml_string_value(Iter->Key), Source);
+		if (ml_is_error(Result)) return ml_error("SerializationError", "Invalid table");
+	}
+	return ml_table_init_rows(Table);
+}
+
+#ifdef ML_CBOR
+
+#include "ml_cbor.h"
+
+static void ML_TYPED_FN(ml_cbor_write, MLTableT, ml_cbor_writer_t *Writer, ml_table_t *Table) {
+	// Same encoding as the serialized form but written directly, each column is written as a typed array.
+	ml_cbor_write_tag(Writer, ML_CBOR_TAG_OBJECT);
+	ml_cbor_write_array(Writer, 2);
+	ml_cbor_write_string(Writer, strlen("table"));
+	ml_cbor_write_raw(Writer, "table", strlen("table"));
+	int Width = 0;
+	for (ml_table_column_t *Column = Table->Columns; Column; Column = Column->Next) ++Width;
+	ml_cbor_write_map(Writer, Width);
+	for (ml_table_column_t *Column = Table->Columns; Column; Column = Column->Next) {
+		ml_cbor_write(Writer, Column->Name);
+		ml_cbor_write(Writer, (ml_value_t *)Column->Values);
+	}
+}
+
+static int ml_cbor_same_key(ml_value_t *A, ml_value_t *B) {
+	if (A == B) return 1;
+	if (!ml_is(B, MLStringT)) return 0;
+	size_t Length = ml_string_length(A);
+	if (ml_string_length(B) != Length) return 0;
+	return !memcmp(ml_string_value(A), ml_string_value(B), Length);
+}
+
+static ml_value_t *ml_cbor_read_rows_fn(ml_value_t *List) {
+	// Converts a list of maps with identical string keys into a table with one column per key.
+	ml_list_node_t *Node = ((ml_list_t *)List)->Head;
+	if (!Node || !ml_is(Node->Value, MLMapT)) return NULL;
+	ml_map_t *First = (ml_map_t *)Node->Value;
+	if (!First->Size) return NULL;
+	for (ml_map_node_t *Key = First->Head; Key; Key = Key->Next) {
+		if (!ml_is(Key->Key, MLStringT)) return NULL;
+	}
+	size_t Length = 0;
+	ml_map_node_t **Cursors = anew(ml_map_node_t *, ml_list_length(List));
+	ML_LIST_FOREACH(List, Iter) {
+		ml_map_t *Map = (ml_map_t *)Iter->Value;
+		if (!ml_is((ml_value_t *)Map, MLMapT) || Map->Size != First->Size) return NULL;
+		for (ml_map_node_t *A = First->Head, *B = Map->Head; A; A = A->Next, B = B->Next) {
+			if (!ml_cbor_same_key(A->Key, B->Key)) return NULL;
+		}
+		Cursors[Length++] = Map->Head;
+	}
+	ml_table_t *Table = (ml_table_t *)ml_table();
+	for (ml_map_node_t *Key = First->Head; Key; Key = Key->Next) {
+		ml_array_format_t Format = ML_ARRAY_FORMAT_I64;
+		for (size_t I = 0; I < Length; ++I) {
+			ml_value_t *Value = Cursors[I]->Value;
+			if (ml_is(Value, MLIntegerT)) continue;
+			if (ml_is(Value, MLRealT)) {
+				Format = ML_ARRAY_FORMAT_F64;
+				continue;
+			}
+			Format = ML_ARRAY_FORMAT_ANY;
+			break;
+		}
+		ml_array_t *Source = ml_array(Format, 1, Length);
+		switch (Format) {
+		case ML_ARRAY_FORMAT_I64: {
+			int64_t *Values = (int64_t *)Source->Base.Value;
+			for (size_t I = 0; I < Length; ++I) Values[I] = ml_integer_value(Cursors[I]->Value);
+			break;
+		}
+		case ML_ARRAY_FORMAT_F64: {
+			double *Values = (double *)Source->Base.Value;
+			for (size_t I = 0; I < Length; ++I) Values[I] = ml_real_value(Cursors[I]->Value);
+			break;
+		}
+		default: {
+			ml_value_t **Values = (ml_value_t **)Source->Base.Value;
+			for (size_t I = 0; I < Length; ++I) Values[I] = Cursors[I]->Value;
+			break;
+		}
+		}
+		for (size_t I = 0; I < Length; ++I) Cursors[I] = Cursors[I]->Next;
+		ml_table_insert_column(Table, ml_string_value(Key->Key), Source);
+	}
+	return ml_table_init_rows(Table);
+}
+
+#endif
+
 void ml_table_init(stringmap_t *Globals) {
 #include "ml_table_init.c"
 	stringmap_insert(Globals, "table", MLTableT);
+#ifdef ML_CBOR
+	ml_cbor_default_list(ml_cbor_read_rows_fn);
+#endif
 }
 
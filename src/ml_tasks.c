@@ -3,9 +3,97 @@
 #include "ml_macros.h"
 #include "ml_logging.h"
 
+#ifdef ML_HOSTTHREADS
+#include <stdatomic.h>
+#endif
+
 #undef ML_CATEGORY
 #define ML_CATEGORY "tasks"
 
+#ifdef ML_HOSTTHREADS
+
+// Under a scheduler pool, the states used by parallel, buffered and diffused can be resumed by several workers at once.
+// Each combinator guards its bookkeeping with an owner lock. Reentrant calls from the owning thread proceed as before, calls from other threads are requeued instead of blocking.
+
+typedef struct {
+	void *_Atomic Owner;
+	int Depth;
+} ml_tasks_lock_t;
+
+static __thread char MLTasksThread[1];
+
+static int ml_tasks_lock(ml_tasks_lock_t *Lock) {
+	void *Self = MLTasksThread;
+	if (atomic_load_explicit(&Lock->Owner, memory_order_relaxed) == Self) {
+		++Lock->Depth;
+		return 1;
+	}
+	void *Expected = NULL;
+	if (!atomic_compare_exchange_strong(&Lock->Owner, &Expected, Self)) return 0;
+	Lock->Depth = 1;
+	return 1;
+}
+
+static void ml_tasks_unlock(ml_tasks_lock_t *Lock) {
+	if (--Lock->Depth == 0) atomic_store(&Lock->Owner, NULL);
+}
+
+typedef void (*ml_tasks_iter_fn)(ml_state_t *Caller, ml_value_t *Iter);
+
+typedef struct {
+	ml_state_t Base;
+	ml_value_t *Iter;
+	ml_tasks_iter_fn fn;
+} ml_tasks_retry_t;
+
+static void ml_tasks_retry_run(ml_tasks_retry_t *Retry, ml_value_t *Value) {
+	return Retry->fn(Retry->Base.Caller, Retry->Iter);
+}
+
+static void ml_tasks_retry(ml_state_t *Caller, ml_value_t *Iter, ml_tasks_iter_fn fn) {
+	ml_tasks_retry_t *Retry = new(ml_tasks_retry_t);
+	Retry->Base.Caller = Caller;
+	Retry->Base.Context = Caller->Context;
+	Retry->Base.run = (ml_state_fn)ml_tasks_retry_run;
+	Retry->Iter = Iter;
+	Retry->fn = fn;
+	ml_state_schedule((ml_state_t *)Retry, MLNil);
+}
+
+#define ML_TASKS_GUARD(NAME, TYPE, STATE, VALUE, LOCK) \
+static void NAME ## _unguarded(TYPE *STATE, ml_value_t *VALUE); \
+\
+static void NAME(TYPE *STATE, ml_value_t *VALUE) { \
+	ml_tasks_lock_t *Lock = LOCK; \
+	if (!ml_tasks_lock(Lock)) return ml_state_schedule((ml_state_t *)STATE, VALUE); \
+	NAME ## _unguarded(STATE, VALUE); \
+	ml_tasks_unlock(Lock); \
+} \
+\
+static void NAME ## _unguarded(TYPE *STATE, ml_value_t *VALUE)
+
+#define ML_TASKS_GUARD_ITER(NAME, TYPE, LOCK) \
+static void NAME ## _unguarded(ml_state_t *Caller, TYPE *State); \
+\
+static void NAME(ml_state_t *Caller, TYPE *State) { \
+	ml_tasks_lock_t *Lock = LOCK; \
+	if (!ml_tasks_lock(Lock)) return ml_tasks_retry(Caller, (ml_value_t *)State, (ml_tasks_iter_fn)NAME); \
+	NAME ## _unguarded(Caller, State); \
+	ml_tasks_unlock(Lock); \
+} \
+\
+static void NAME ## _unguarded(ml_state_t *Caller, TYPE *State)
+
+#define ML_TASKS_LOCK_FIELD ml_tasks_lock_t Lock[1];
+
+#else
+
+#define ML_TASKS_GUARD(NAME, TYPE, STATE, VALUE, LOCK) static void NAME(TYPE *STATE, ml_value_t *VALUE)
+#define ML_TASKS_GUARD_ITER(NAME, TYPE, LOCK) static void NAME(ml_state_t *Caller, TYPE *State)
+#define ML_TASKS_LOCK_FIELD
+
+#endif
+
 typedef struct ml_waiter_t ml_waiter_t;
 
 struct ml_waiter_t {
@@ -61,6 +149,14 @@ static void ml_task_run(ml_task_t *Task, ml_value_t *Result) {
 	if (!Task->Value) ml_task_set(Task, Result);
 }
 
+ml_state_t *ml_task_state(ml_context_t *Context) {
+	ml_task_t *Task = new(ml_task_t);
+	Task->Base.Type = MLTaskT;
+	Task->Base.Context = Context;
+	Task->Base.run = (ml_state_fn)ml_task_run;
+	return (ml_state_t *)Task;
+}
+
 ML_METHODVZ(MLTaskT, MLAnyT) {
 //<Arg/1...
 //<Arg/n:any
@@ -440,9 +536,10 @@ typedef struct {
 	ml_value_t *Iter, *Fn, *Error;
 	ml_value_t *Args[2];
 	size_t NumRunning, MaxRunning, Burst;
+	ML_TASKS_LOCK_FIELD
 } ml_parallel_t;
 
-static void parallel_iter_next(ml_state_t *State, ml_value_t *Iter) {
+ML_TASKS_GUARD(parallel_iter_next, ml_state_t, State, Iter, ((ml_parallel_t *)((char *)State - offsetof(ml_parallel_t, NextState)))->Lock) {
 	ml_parallel_t *Parallel = (ml_parallel_t *)((char *)State - offsetof(ml_parallel_t, NextState));
 	if (Parallel->Error) return;
 	if (Iter == MLNil) {
@@ -456,14 +553,14 @@ static void parallel_iter_next(ml_state_t *State, ml_value_t *Iter) {
 	return ml_iter_key(Parallel->KeyState, Parallel->Iter = Iter);
 }
 
-static void parallel_iter_key(ml_state_t *State, ml_value_t *Value) {
+ML_TASKS_GUARD(parallel_iter_key, ml_state_t, State, Value, ((ml_parallel_t *)((char *)State - offsetof(ml_parallel_t, KeyState)))->Lock) {
 	ml_parallel_t *Parallel = (ml_parallel_t *)((char *)State - offsetof(ml_parallel_t, KeyState));
 	if (Parallel->Error) return;
 	Parallel->Args[0] = Value;
 	return ml_iter_value(Parallel->ValueState, Parallel->Iter);
 }
 
-static void parallel_iter_value(ml_state_t *State, ml_value_t *Value) {
+ML_TASKS_GUARD(parallel_iter_value, ml_state_t, State, Value, ((ml_parallel_t *)((char *)State - offsetof(ml_parallel_t, ValueState)))->Lock) {
 	ml_parallel_t *Parallel = (ml_parallel_t *)((char *)State - offsetof(ml_parallel_t, ValueState));
 	if (Parallel->Error) return;
 	Parallel->Args[1] = Value;
@@ -475,7 +572,7 @@ static void parallel_iter_value(ml_state_t *State, ml_value_t *Value) {
 	}
 }
 
-static void parallel_continue(ml_parallel_t *Parallel, ml_value_t *Value) {
+ML_TASKS_GUARD(parallel_continue, ml_parallel_t, Parallel, Value, Parallel->Lock) {
 	if (Parallel->Error) return;
 	if (ml_is_error(Value)) {
 		Parallel->Error = Value;
@@ -558,6 +655,7 @@ typedef struct {
 	ml_value_t *Iter, *Fn;
 	ml_value_t *Key, *Value;
 	int Size, Use, Fetch, Head;
+	ML_TASKS_LOCK_FIELD
 	ml_buffered_entry_t Entries[];
 } ml_buffered_state_t;
 
@@ -584,7 +682,7 @@ static void ml_buffered_call(ml_state_t *Caller, ml_buffered_state_t *State, ml_
 	}
 }
 
-static void ML_TYPED_FN(ml_iter_next, MLBufferedStateT, ml_state_t *Caller, ml_buffered_state_t *State) {
+ML_TASKS_GUARD_ITER(ml_buffered_next, ml_buffered_state_t, State->Lock) {
 	ml_buffered_entry_t *Entry = State->Entries + (State->Use % State->Size);
 	if (Entry->Value) {
 		return ml_buffered_call(Caller, State, Entry);
@@ -594,6 +692,10 @@ static void ML_TYPED_FN(ml_iter_next, MLBufferedStateT, ml_state_t *Caller, ml_b
 	}
 }
 
+static void ML_TYPED_FN(ml_iter_next, MLBufferedStateT, ml_state_t *Caller, ml_buffered_state_t *State) {
+	return ml_buffered_next(Caller, State);
+}
+
 static void ML_TYPED_FN(ml_iter_key, MLBufferedStateT, ml_state_t *Caller, ml_buffered_state_t *State) {
 	ML_RETURN(State->Key);
 }
@@ -602,7 +704,7 @@ static void ML_TYPED_FN(ml_iter_value, MLBufferedStateT, ml_state_t *Caller, ml_
 	ML_RETURN(State->Value);
 }
 
-static void ml_buffered_entry_call(ml_buffered_entry_t *Entry, ml_value_t *Value) {
+ML_TASKS_GUARD(ml_buffered_entry_call, ml_buffered_entry_t, Entry, Value, ((ml_buffered_state_t *)Entry->Base.Caller)->Lock) {
 	ml_buffered_state_t *State = (ml_buffered_state_t *)Entry->Base.Caller;
 	int Index = Entry - State->Entries;
 	Entry->Value = Value;
@@ -612,7 +714,7 @@ static void ml_buffered_entry_call(ml_buffered_entry_t *Entry, ml_value_t *Value
 	}
 }
 
-static void ml_buffered_value(ml_buffered_state_t *State, ml_value_t *Value) {
+ML_TASKS_GUARD(ml_buffered_value, ml_buffered_state_t, State, Value, State->Lock) {
 	ml_buffered_entry_t *Entry = &State->Entries[State->Fetch % State->Size];
 	if (ml_is_error(Value)) {
 		++State->Fetch;
@@ -635,7 +737,7 @@ static void ml_buffered_value(ml_buffered_state_t *State, ml_value_t *Value) {
 	}
 }
 
-static void ml_buffered_key(ml_buffered_state_t *State, ml_value_t *Value) {
+ML_TASKS_GUARD(ml_buffered_key, ml_buffered_state_t, State, Value, State->Lock) {
 	ml_buffered_entry_t *Entry = &State->Entries[State->Fetch % State->Size];
 	if (ml_is_error(Value)) {
 		++State->Fetch;
@@ -648,7 +750,7 @@ static void ml_buffered_key(ml_buffered_state_t *State, ml_value_t *Value) {
 	}
 }
 
-static void ml_buffered_iterate(ml_buffered_state_t *State, ml_value_t *Value) {
+ML_TASKS_GUARD(ml_buffered_iterate, ml_buffered_state_t, State, Value, State->Lock) {
 	ml_buffered_entry_t *Entry = &State->Entries[State->Fetch % State->Size];
 	if (ml_is_error(Value)) {
 		++State->Fetch;
@@ -730,6 +832,7 @@ typedef struct {
 	ml_value_t *Iter, *Fn, *Final;
 	ml_diffused_task_t *Head, *Tail, *Next;
 	int Size, Waiting;
+	ML_TASKS_LOCK_FIELD
 	ml_diffused_task_t Tasks[];
 } ml_diffused_state_t;
 
@@ -738,7 +841,7 @@ ML_TYPE(MLDiffusedStateT, (MLStateT), "diffused-state");
 
 static void ml_diffused_iterate(ml_diffused_state_t *Task, ml_value_t *Value);
 
-static void ML_TYPED_FN(ml_iter_next, MLDiffusedStateT, ml_state_t *Caller, ml_diffused_state_t *State) {
+ML_TASKS_GUARD_ITER(ml_diffused_next, ml_diffused_state_t, State->Lock) {
 	if (State->Waiting <= 0) ML_RETURN(State->Final);
 	if (!State->Head) ML_ERROR("StateError", "Invalid state");
 	ml_diffused_task_t *Task = State->Head;
@@ -763,6 +866,10 @@ static void ML_TYPED_FN(ml_iter_next, MLDiffusedStateT, ml_state_t *Caller, ml_d
 	}
 }
 
+static void ML_TYPED_FN(ml_iter_next, MLDiffusedStateT, ml_state_t *Caller, ml_diffused_state_t *State) {
+	return ml_diffused_next(Caller, State);
+}
+
 static void ML_TYPED_FN(ml_iter_key, MLDiffusedStateT, ml_state_t *Caller, ml_diffused_state_t *State) {
 	if (!State->Head) ML_ERROR("StateError", "Invalid state");
 	ML_RETURN(State->Head->Key);
@@ -773,7 +880,7 @@ static void ML_TYPED_FN(ml_iter_value, MLDiffusedStateT, ml_state_t *Caller, ml_
 	ML_RETURN(State->Head->Value);
 }
 
-static void ml_diffused_task_call(ml_diffused_task_t *Task, ml_value_t *Value) {
+ML_TASKS_GUARD(ml_diffused_task_call, ml_diffused_task_t, Task, Value, ((ml_diffused_state_t *)Task->Base.Caller)->Lock) {
 	ml_diffused_state_t *State = (ml_diffused_state_t *)Task->Base.Caller;
 	Task->Value = Value;
 	if (ml_is_error(Value)) {
@@ -797,7 +904,7 @@ static void ml_diffused_task_call(ml_diffused_task_t *Task, ml_value_t *Value) {
 	}
 }
 
-static void ml_diffused_value(ml_diffused_state_t *State, ml_value_t *Value) {
+ML_TASKS_GUARD(ml_diffused_value, ml_diffused_state_t, State, Value, State->Lock) {
 	if (ml_is_error(Value)) {
 		State->Final = Value;
 		State->Waiting = 0;
@@ -822,7 +929,7 @@ static void ml_diffused_value(ml_diffused_state_t *State, ml_value_t *Value) {
 	}
 }
 
-static void ml_diffused_key(ml_diffused_state_t *State, ml_value_t *Value) {
+ML_TASKS_GUARD(ml_diffused_key, ml_diffused_state_t, State, Value, State->Lock) {
 	if (ml_is_error(Value)) {
 		State->Final = Value;
 		State->Waiting = 0;
@@ -838,7 +945,7 @@ static void ml_diffused_key(ml_diffused_state_t *State, ml_value_t *Value) {
 	}
 }
 
-static void ml_diffused_iterate(ml_diffused_state_t *State, ml_value_t *Value) {
+ML_TASKS_GUARD(ml_diffused_iterate, ml_diffused_state_t, State, Value, State->Lock) {
 	if (ml_is_error(Value)) {
 		State->Final = Value;
 		State->Waiting = 0;
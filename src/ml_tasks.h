@@ -2,6 +2,7 @@
 #define ML_TASKS_H
 
 #include "stringmap.h"
+#include "ml_runtime.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -9,6 +10,9 @@ extern "C" {
 
 void ml_tasks_init(stringmap_t *Globals);
 
+// Returns a new task as a state, running the state completes the task (on the thread running the state).
+ml_state_t *ml_task_state(ml_context_t *Context);
+
 #ifdef __cplusplus
 }
 #endif
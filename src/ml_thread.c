@@ -3,6 +3,10 @@
 #include "ml_compiler2.h"
 #include "ml_stream.h"
 #include "ml_time.h"
+#include "ml_tasks.h"
+#include <stdatomic.h>
+#include <unistd.h>
+#include <semaphore.h>
 
 typedef struct {
 	ml_state_t Base;
@@ -77,6 +81,41 @@ static ml_value_t *ML_TYPED_FN(ml_is_threadsafe, MLTupleT, ml_tuple_t *Tuple) {
 	return NULL;
 }
 
+#ifdef ML_MUTABLES
+
+// Lists and maps can only be shared once they are constant.
+
+extern ml_type_t MLListMutableT[];
+extern ml_type_t MLMapMutableT[];
+
+static ml_value_t *ML_TYPED_FN(ml_is_threadsafe, MLListMutableT, ml_value_t *Value) {
+	return ml_error("ThreadError", "%s is not safe to pass to another thread", ml_typeof(Value)->Name);
+}
+
+static ml_value_t *ML_TYPED_FN(ml_is_threadsafe, MLListT, ml_value_t *List) {
+	ML_LIST_FOREACH(List, Iter) {
+		ml_value_t *Error = ml_is_threadsafe(Iter->Value);
+		if (Error) return Error;
+	}
+	return NULL;
+}
+
+static ml_value_t *ML_TYPED_FN(ml_is_threadsafe, MLMapMutableT, ml_value_t *Value) {
+	return ml_error("ThreadError", "%s is not safe to pass to another thread", ml_typeof(Value)->Name);
+}
+
+static ml_value_t *ML_TYPED_FN(ml_is_threadsafe, MLMapT, ml_value_t *Map) {
+	ML_MAP_FOREACH(Map, Iter) {
+		ml_value_t *Error = ml_is_threadsafe(Iter->Key);
+		if (Error) return Error;
+		Error = ml_is_threadsafe(Iter->Value);
+		if (Error) return Error;
+	}
+	return NULL;
+}
+
+#endif
+
 static ml_value_t *ml_is_closure_threadsafe(ml_closure_info_t *Info) {
 	for (ml_inst_t *Inst = Info->Entry; Inst != Info->Halt;) {
 		if (Inst->Opcode == MLI_LINK) {
@@ -307,6 +346,36 @@ static ml_value_t *ML_TYPED_FN(ml_is_threadsafe, MLThreadPortT, ml_value_t *Valu
 
 #endif
 
+ml_value_t *ml_thread_move(ml_value_t *Value) {
+	typeof(ml_thread_move) *function = ml_typed_fn_get(ml_typeof(Value), ml_thread_move);
+	if (function) return function(Value);
+	return ml_is_threadsafe(Value) ?: Value;
+}
+
+static char MLThreadMoved[1] = {0};
+
+static ml_value_t *ML_TYPED_FN(ml_thread_move, MLBufferT, ml_address_t *Buffer) {
+	ml_value_t *Moved = ml_buffer(Buffer->Value, Buffer->Length);
+	Buffer->Value = MLThreadMoved;
+	Buffer->Length = 0;
+	return Moved;
+}
+
+static ml_value_t *ML_TYPED_FN(ml_thread_move, MLBufferViewT, ml_address_t *Buffer) {
+	return ml_error("ThreadError", "%s does not own its contents and cannot be moved to another thread", Buffer->Type->Name);
+}
+
+ML_FUNCTION(MLThreadMove) {
+//@thread::move
+//<Value
+//>any|error
+// Returns a thread-safe value with the contents of :mini:`Value` without copying, or an error if :mini:`Value` cannot be passed to another thread.
+// If :mini:`Value` is mutable (e.g. a :mini:`buffer` or :mini:`array::mutable`) then its contents are transferred to the returned value and :mini:`Value` is left empty.
+// Views into other values (e.g. :mini:`Buffer @ 4` or a slice of an array) cannot be moved since their contents are still reachable from elsewhere.
+	ML_CHECK_ARG_COUNT(1);
+	return ml_thread_move(Args[0]);
+}
+
 ML_FUNCTION(MLThreadSleep) {
 //@thread::sleep
 //<Duration
@@ -564,14 +633,530 @@ static ml_value_t *ML_TYPED_FN(ml_is_threadsafe, MLThreadConditionT, ml_value_t
 	return NULL;
 }
 
+// Calls Fn(Args) from a host thread created by this module, running the thread's own scheduler until the call completes.
+
+typedef struct {
+	ml_state_t Base;
+	ml_value_t *Result;
+} ml_thread_call_t;
+
+static void ml_thread_call_run(ml_thread_call_t *Call, ml_value_t *Value) {
+	Call->Result = Value;
+}
+
+static ml_value_t *ml_thread_call_wait(ml_thread_call_t *Call, ml_value_t *Fn, int Count, ml_value_t **Args) {
+	Call->Result = NULL;
+	ml_call((ml_state_t *)Call, Fn, Count, Args);
+#ifdef ML_SCHEDULER
+	ml_scheduler_queue_t *Queue = (ml_scheduler_queue_t *)ml_context_get_scheduler(Call->Base.Context);
+	while (!Call->Result) {
+		ml_queued_state_t Queued = ml_scheduler_queue_next_wait(Queue);
+		Queued.State->run(Queued.State, Queued.Value);
+	}
+#endif
+	return Call->Result;
+}
+
+// Data parallel sequence operations.
+// The sequence is collected into an array which is split into chunks claimed by a fixed number of host threads.
+// Each thread gets its own context (and scheduler), the last thread to finish combines the chunk results and resumes the caller.
+
+typedef enum {
+	ML_THREAD_BATCH_MAP,
+	ML_THREAD_BATCH_FILTER,
+	ML_THREAD_BATCH_REDUCE
+} ml_thread_batch_kind_t;
+
+typedef struct {
+	ml_state_t Base;
+	ml_value_t *Fn;
+	ml_value_t *_Atomic Error;
+	ml_value_t **Values, **Results;
+#ifndef ML_SCHEDULER
+	ml_value_t *Result;
+#endif
+	ml_thread_batch_kind_t Kind;
+	int Length, ChunkSize, NumChunks, NumThreads;
+	_Atomic int NextChunk, Running;
+} ml_thread_batch_t;
+
+static int ml_thread_batch_error(ml_thread_batch_t *Batch, ml_value_t *Value) {
+	if (!ml_is_error(Value)) return 0;
+	ml_value_t *Expected = NULL;
+	atomic_compare_exchange_strong(&Batch->Error, &Expected, Value);
+	return 1;
+}
+
+static void ml_thread_batch_finish(ml_thread_batch_t *Batch, ml_thread_call_t *Call) {
+	ml_value_t *Result = Batch->Error;
+	if (!Result) switch (Batch->Kind) {
+	case ML_THREAD_BATCH_MAP:
+		Result = ml_list();
+		for (int I = 0; I < Batch->Length; ++I) ml_list_put(Result, Batch->Results[I]);
+		break;
+	case ML_THREAD_BATCH_FILTER:
+		Result = ml_list();
+		for (int I = 0; I < Batch->Length; ++I) {
+			if (Batch->Results[I] != MLNil) ml_list_put(Result, Batch->Values[I]);
+		}
+		break;
+	case ML_THREAD_BATCH_REDUCE:
+		Result = Batch->Results[0];
+		for (int I = 1; I < Batch->NumChunks; ++I) {
+			ml_value_t *Args[2] = {Result, Batch->Results[I]};
+			Result = ml_thread_call_wait(Call, Batch->Fn, 2, Args);
+			if (ml_is_error(Result)) break;
+		}
+		break;
+	}
+#ifdef ML_SCHEDULER
+	ml_state_t *Caller = Batch->Base.Caller;
+	ml_scheduler_t *Scheduler = ml_context_get_scheduler(Caller->Context);
+	Scheduler->add(Scheduler, Caller, Result);
+#else
+	Batch->Result = Result;
+#endif
+}
+
+static void *ml_thread_batch_fn(ml_thread_batch_t *Batch) {
+	ml_thread_call_t Call[1] = {{{NULL, NULL, (ml_state_fn)ml_thread_call_run, ml_context(Batch->Base.Context)}, NULL}};
+#ifdef ML_SCHEDULER
+	ml_default_queue_init(Call->Base.Context, 256);
+#endif
+	ml_value_t **Values = Batch->Values, **Results = Batch->Results;
+	ml_value_t *Fn = Batch->Fn;
+	while (!Batch->Error) {
+		int Chunk = atomic_fetch_add(&Batch->NextChunk, 1);
+		if (Chunk >= Batch->NumChunks) break;
+		int Start = Chunk * Batch->ChunkSize;
+		int End = Start + Batch->ChunkSize;
+		if (End > Batch->Length) End = Batch->Length;
+		if (Batch->Kind == ML_THREAD_BATCH_REDUCE) {
+			ml_value_t *Result = Values[Start];
+			for (int I = Start + 1; I < End; ++I) {
+				ml_value_t *Args[2] = {Result, Values[I]};
+				Result = ml_thread_call_wait(Call, Fn, 2, Args);
+				if (ml_thread_batch_error(Batch, Result)) break;
+			}
+			Results[Chunk] = Result;
+		} else {
+			for (int I = Start; I < End; ++I) {
+				ml_value_t *Args[1] = {Values[I]};
+				ml_value_t *Result = ml_thread_call_wait(Call, Fn, 1, Args);
+				if (ml_thread_batch_error(Batch, Result)) break;
+				Results[I] = Result;
+			}
+		}
+	}
+	if (atomic_fetch_sub(&Batch->Running, 1) == 1) ml_thread_batch_finish(Batch, Call);
+	return NULL;
+}
+
+static void ml_thread_batch_start(ml_thread_batch_t *Batch, ml_value_t *List) {
+	ml_state_t *Caller = Batch->Base.Caller;
+	if (ml_is_error(List)) ML_RETURN(List);
+	int Length = ml_list_length(List);
+	if (!Length) ML_RETURN(Batch->Kind == ML_THREAD_BATCH_REDUCE ? MLNil : ml_list());
+	ml_value_t **Values = Batch->Values = anew(ml_value_t *, Length);
+	ml_list_to_array(List, Values);
+	for (int I = 0; I < Length; ++I) {
+		ml_value_t *Error = ml_is_threadsafe(Values[I] = ml_deref(Values[I]));
+		if (Error) ML_RETURN(Error);
+	}
+	int NumThreads = Batch->NumThreads;
+	if (NumThreads > Length) NumThreads = Length;
+	// Several chunks per thread to balance uneven workloads.
+	int ChunkSize = (Length + 8 * NumThreads - 1) / (8 * NumThreads);
+	if (Batch->Kind == ML_THREAD_BATCH_REDUCE && ChunkSize < 2) ChunkSize = 2;
+	Batch->Length = Length;
+	Batch->ChunkSize = ChunkSize;
+	Batch->NumChunks = (Length + ChunkSize - 1) / ChunkSize;
+	Batch->Results = anew(ml_value_t *, Batch->Kind == ML_THREAD_BATCH_REDUCE ? Batch->NumChunks : Length);
+	// Running counts the started threads plus one for this function, so the batch cannot finish while threads are still being started.
+	Batch->Running = 1;
+	pthread_t Threads[NumThreads];
+	for (int I = 0; I < NumThreads; ++I) {
+		atomic_fetch_add(&Batch->Running, 1);
+		if (pthread_create(Threads + I, NULL, (void *)ml_thread_batch_fn, Batch)) {
+			// The threads already started take over the remaining chunks.
+			atomic_fetch_sub(&Batch->Running, 1);
+			NumThreads = I;
+			break;
+		}
+#ifdef ML_SCHEDULER
+		pthread_detach(Threads[I]);
+#endif
+	}
+	if (!NumThreads) ML_ERROR("ThreadError", "Failed to create thread");
+	if (atomic_fetch_sub(&Batch->Running, 1) == 1) {
+		// Every started thread has already exited, so the results are combined here.
+		ml_thread_call_t Call[1] = {{{NULL, NULL, (ml_state_fn)ml_thread_call_run, ml_context(Batch->Base.Context)}, NULL}};
+#ifdef ML_SCHEDULER
+		ml_default_queue_init(Call->Base.Context, 256);
+#endif
+		ml_thread_batch_finish(Batch, Call);
+	}
+#ifndef ML_SCHEDULER
+	for (int I = 0; I < NumThreads; ++I) pthread_join(Threads[I], NULL);
+	ML_RETURN(Batch->Result);
+#endif
+}
+
+static void ml_thread_batch(ml_state_t *Caller, ml_thread_batch_kind_t Kind, int Count, ml_value_t **Args) {
+	ml_value_t *Error = ml_is_threadsafe(Args[1]);
+	if (Error) ML_RETURN(Error);
+	int NumThreads;
+	if (Count > 2) {
+		NumThreads = ml_integer_value(Args[2]);
+		if (NumThreads <= 0) ML_ERROR("ValueError", "Thread count must be positive");
+	} else {
+		NumThreads = sysconf(_SC_NPROCESSORS_ONLN);
+		if (NumThreads <= 0) NumThreads = 1;
+	}
+	ml_thread_batch_t *Batch = new(ml_thread_batch_t);
+	Batch->Base.Caller = Caller;
+	Batch->Base.Context = Caller->Context;
+	Batch->Base.run = (ml_state_fn)ml_thread_batch_start;
+	Batch->Fn = Args[1];
+	Batch->Kind = Kind;
+	Batch->NumThreads = NumThreads;
+	ml_value_t *Sequence = ml_deref(Args[0]);
+	if (ml_is(Sequence, MLListT)) return ml_thread_batch_start(Batch, Sequence);
+	return ml_call(Batch, (ml_value_t *)MLListT, 1, &Sequence);
+}
+
+ML_METHODX("pmap", MLSequenceT, MLFunctionT) {
+//<Sequence
+//<Fn
+//<Threads?:integer
+//>list
+// Returns the list :mini:`[Fn(V/1), ..., Fn(V/n)]` where :mini:`V/i` are the values produced by :mini:`Sequence`, in order.
+// The calls to :mini:`Fn` are made on :mini:`Threads` host threads (defaults to the number of processors). :mini:`Fn` and each :mini:`V/i` must be thread-safe.
+	return ml_thread_batch(Caller, ML_THREAD_BATCH_MAP, Count, Args);
+}
+
+ML_METHODX("pmap", MLSequenceT, MLFunctionT, MLIntegerT) {
+//!internal
+	return ml_thread_batch(Caller, ML_THREAD_BATCH_MAP, Count, Args);
+}
+
+ML_METHODX("pfilter", MLSequenceT, MLFunctionT) {
+//<Sequence
+//<Fn
+//<Threads?:integer
+//>list
+// Returns the list of values :mini:`V/i` produced by :mini:`Sequence` for which :mini:`Fn(V/i)` is not :mini:`nil`, in order.
+// The calls to :mini:`Fn` are made on :mini:`Threads` host threads (defaults to the number of processors). :mini:`Fn` and each :mini:`V/i` must be thread-safe.
+	return ml_thread_batch(Caller, ML_THREAD_BATCH_FILTER, Count, Args);
+}
+
+ML_METHODX("pfilter", MLSequenceT, MLFunctionT, MLIntegerT) {
+//!internal
+	return ml_thread_batch(Caller, ML_THREAD_BATCH_FILTER, Count, Args);
+}
+
+ML_METHODX("preduce", MLSequenceT, MLFunctionT) {
+//<Sequence
+//<Fn
+//<Threads?:integer
+//>any|nil
+// Returns :mini:`Fn(Fn( ... Fn(V/1, V/2) ..., V/n)` where :mini:`V/i` are the values produced by :mini:`Sequence`, or :mini:`nil` if :mini:`Sequence` is empty. A single value is returned without calling :mini:`Fn`.
+// Consecutive runs of values are reduced on :mini:`Threads` host threads (defaults to the number of processors) and the partial results are then reduced in order, so :mini:`Fn` must be associative. :mini:`Fn` and each :mini:`V/i` must be thread-safe.
+	return ml_thread_batch(Caller, ML_THREAD_BATCH_REDUCE, Count, Args);
+}
+
+ML_METHODX("preduce", MLSequenceT, MLFunctionT, MLIntegerT) {
+//!internal
+	return ml_thread_batch(Caller, ML_THREAD_BATCH_REDUCE, Count, Args);
+}
+
+// Rings are bounded lock-free MPMC queues of pointers using per cell sequence numbers.
+// Semaphores are only used to park consumers when a ring is empty and producers when it is full.
+
+typedef struct {
+	_Atomic size_t Sequence;
+	void *Value;
+} ml_thread_ring_cell_t;
+
+typedef struct {
+	ml_thread_ring_cell_t *Cells;
+	sem_t Available[1], Space[1];
+	size_t Mask;
+	_Atomic size_t Write, Read;
+} ml_thread_ring_t;
+
+static void ml_thread_ring_init(ml_thread_ring_t *Ring, size_t Capacity) {
+	size_t Cells = 1;
+	while (Cells < Capacity) Cells <<= 1;
+	Ring->Cells = anew(ml_thread_ring_cell_t, Cells);
+	for (size_t I = 0; I < Cells; ++I) Ring->Cells[I].Sequence = I;
+	Ring->Mask = Cells - 1;
+	sem_init(Ring->Available, 0, 0);
+	sem_init(Ring->Space, 0, Cells);
+}
+
+static void ml_thread_ring_push(ml_thread_ring_t *Ring, void *Value) {
+	while (sem_wait(Ring->Space));
+	size_t Pos = atomic_load_explicit(&Ring->Write, memory_order_relaxed);
+	ml_thread_ring_cell_t *Cell;
+	for (;;) {
+		Cell = Ring->Cells + (Pos & Ring->Mask);
+		size_t Sequence = atomic_load_explicit(&Cell->Sequence, memory_order_acquire);
+		intptr_t Diff = (intptr_t)Sequence - (intptr_t)Pos;
+		if (Diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&Ring->Write, &Pos, Pos + 1, memory_order_relaxed, memory_order_relaxed)) break;
+		} else {
+			Pos = atomic_load_explicit(&Ring->Write, memory_order_relaxed);
+		}
+	}
+	Cell->Value = Value;
+	atomic_store_explicit(&Cell->Sequence, Pos + 1, memory_order_release);
+	sem_post(Ring->Available);
+}
+
+static void *ml_thread_ring_take(ml_thread_ring_t *Ring) {
+	size_t Pos = atomic_load_explicit(&Ring->Read, memory_order_relaxed);
+	ml_thread_ring_cell_t *Cell;
+	for (;;) {
+		Cell = Ring->Cells + (Pos & Ring->Mask);
+		size_t Sequence = atomic_load_explicit(&Cell->Sequence, memory_order_acquire);
+		intptr_t Diff = (intptr_t)Sequence - (intptr_t)(Pos + 1);
+		if (Diff == 0) {
+			if (atomic_compare_exchange_weak_explicit(&Ring->Read, &Pos, Pos + 1, memory_order_relaxed, memory_order_relaxed)) break;
+		} else {
+			Pos = atomic_load_explicit(&Ring->Read, memory_order_relaxed);
+		}
+	}
+	void *Value = Cell->Value;
+	Cell->Value = NULL;
+	atomic_store_explicit(&Cell->Sequence, Pos + Ring->Mask + 1, memory_order_release);
+	sem_post(Ring->Space);
+	return Value;
+}
+
+static void *ml_thread_ring_pop(ml_thread_ring_t *Ring) {
+	while (sem_wait(Ring->Available));
+	return ml_thread_ring_take(Ring);
+}
+
+static void *ml_thread_ring_try_pop(ml_thread_ring_t *Ring) {
+	if (sem_trywait(Ring->Available)) return NULL;
+	return ml_thread_ring_take(Ring);
+}
+
+typedef struct {
+	ml_type_t *Type;
+	ml_thread_ring_t Ring[1];
+	int Capacity;
+} ml_thread_queue_t;
+
+extern ml_type_t MLThreadQueueT[];
+
+ML_FUNCTION(MLThreadQueue) {
+//@thread::queue
+//<Capacity
+//>thread::queue
+// Creates a new queue with capacity :mini:`Capacity`.
+	ML_CHECK_ARG_COUNT(1);
+	ML_CHECK_ARG_TYPE(0, MLIntegerT);
+	int Capacity = ml_integer_value(Args[0]);
+	if (Capacity <= 0) return ml_error("ValueError", "Queue capacity must be positive");
+	ml_thread_queue_t *Queue = new(ml_thread_queue_t);
+	Queue->Type = MLThreadQueueT;
+	Queue->Capacity = Capacity;
+	ml_thread_ring_init(Queue->Ring, Capacity);
+	return (ml_value_t *)Queue;
+}
+
+ML_TYPE(MLThreadQueueT, (), "thread::queue",
+// A bounded multi-producer multi-consumer queue for thread communication.
+// Unlike :mini:`thread::channel`, senders and receivers on different queues never contend and senders only block when the queue is full.
+	.Constructor = (ml_value_t *)MLThreadQueue
+);
+
+static ml_value_t *ML_TYPED_FN(ml_is_threadsafe, MLThreadQueueT, ml_value_t *Value) {
+	return NULL;
+}
+
+ML_METHOD("send", MLThreadQueueT, MLAnyT) {
+//<Queue
+//<Message
+//>thread::queue
+// Adds :mini:`Message` to :mini:`Queue`. :mini:`Message` must be thread-safe.
+// Blocks if :mini:`Queue` is currently full.
+	ml_thread_queue_t *Queue = (ml_thread_queue_t *)Args[0];
+	ml_value_t *Message = Args[1];
+	ml_value_t *Error = ml_is_threadsafe(Message);
+	if (Error) return Error;
+	ml_thread_ring_push(Queue->Ring, Message);
+	return (ml_value_t *)Queue;
+}
+
+ML_METHOD("recv", MLThreadQueueT) {
+//<Queue
+//>any
+// Removes and returns the next message in :mini:`Queue`, blocking if :mini:`Queue` is empty.
+	ml_thread_queue_t *Queue = (ml_thread_queue_t *)Args[0];
+	return ml_thread_ring_pop(Queue->Ring);
+}
+
+ML_METHOD("poll", MLThreadQueueT) {
+//<Queue
+//>any|nil
+// Removes and returns the next message in :mini:`Queue` if there is one, otherwise returns :mini:`nil` without blocking.
+	ml_thread_queue_t *Queue = (ml_thread_queue_t *)Args[0];
+	return ml_thread_ring_try_pop(Queue->Ring) ?: MLNil;
+}
+
+ML_METHOD("capacity", MLThreadQueueT) {
+//<Queue
+//>integer
+// Returns the capacity of :mini:`Queue`.
+	ml_thread_queue_t *Queue = (ml_thread_queue_t *)Args[0];
+	return ml_integer(Queue->Capacity);
+}
+
+#ifdef ML_SCHEDULER
+
+// Thread pools keep a fixed set of host threads, each with its own context and scheduler, which take jobs from a ring.
+// Each job completes a task by adding it to the submitter's scheduler so that waiters are resumed on the submitting thread.
+
+typedef struct {
+	ml_state_t *Task;
+	ml_value_t *Fn;
+	int Count;
+	ml_value_t *Args[];
+} ml_thread_job_t;
+
+typedef struct {
+	ml_type_t *Type;
+	ml_context_t *Context;
+	ml_thread_ring_t Ring[1];
+	// Held while checking Closed and queueing a job, so no job is queued after the workers have been told to stop.
+	pthread_mutex_t Lock[1];
+	int Size, Closed;
+} ml_thread_pool_t;
+
+static void *ml_thread_pool_fn(ml_thread_pool_t *Pool) {
+	ml_thread_call_t Call[1] = {{{NULL, NULL, (ml_state_fn)ml_thread_call_run, ml_context(Pool->Context)}, NULL}};
+	ml_default_queue_init(Call->Base.Context, 256);
+	for (;;) {
+		ml_thread_job_t *Job = ml_thread_ring_pop(Pool->Ring);
+		if (!Job->Fn) break;
+		ml_value_t *Result = ml_thread_call_wait(Call, Job->Fn, Job->Count, Job->Args);
+		ml_state_t *Task = Job->Task;
+		ml_scheduler_t *Scheduler = ml_context_get_scheduler(Task->Context);
+		Scheduler->add(Scheduler, Task, Result);
+	}
+	return NULL;
+}
+
+static void ml_thread_pool_call(ml_state_t *Caller, ml_thread_pool_t *Pool, int Count, ml_value_t **Args) {
+	ML_CHECKX_ARG_COUNT(1);
+	for (int I = 0; I < Count; ++I) {
+		Args[I] = ml_deref(Args[I]);
+		ml_value_t *Error = ml_is_threadsafe(Args[I]);
+		if (Error) ML_RETURN(Error);
+	}
+	ml_thread_job_t *Job = xnew(ml_thread_job_t, Count - 1, ml_value_t *);
+	Job->Task = ml_task_state(Caller->Context);
+	Job->Fn = Args[Count - 1];
+	Job->Count = Count - 1;
+	for (int I = 0; I < Count - 1; ++I) Job->Args[I] = Args[I];
+	pthread_mutex_lock(Pool->Lock);
+	if (Pool->Closed) {
+		pthread_mutex_unlock(Pool->Lock);
+		ML_ERROR("ThreadError", "Thread pool is closed");
+	}
+	ml_thread_ring_push(Pool->Ring, Job);
+	pthread_mutex_unlock(Pool->Lock);
+	ML_RETURN(Job->Task);
+}
+
+extern ml_type_t MLThreadPoolT[];
+
+ML_FUNCTIONX(MLThreadPool) {
+//@thread::pool
+//<Size:integer
+//<Capacity?:integer
+//>thread::pool
+// Returns a new pool of :mini:`Size` worker threads with a queue for up to :mini:`Capacity` pending calls (default :mini:`256`).
+	ML_CHECKX_ARG_COUNT(1);
+	ML_CHECKX_ARG_TYPE(0, MLIntegerT);
+	int Size = ml_integer_value(Args[0]);
+	if (Size <= 0) ML_ERROR("ValueError", "Thread pool size must be positive");
+	int Capacity = 256;
+	if (Count > 1) {
+		ML_CHECKX_ARG_TYPE(1, MLIntegerT);
+		Capacity = ml_integer_value(Args[1]);
+		if (Capacity <= 0) ML_ERROR("ValueError", "Thread pool capacity must be positive");
+	}
+	ml_thread_pool_t *Pool = new(ml_thread_pool_t);
+	Pool->Type = MLThreadPoolT;
+	Pool->Context = Caller->Context;
+	Pool->Size = Size;
+	pthread_mutex_init(Pool->Lock, NULL);
+	ml_thread_ring_init(Pool->Ring, Capacity);
+	for (int I = 0; I < Size; ++I) {
+		pthread_t Thread;
+		if (pthread_create(&Thread, NULL, (void *)ml_thread_pool_fn, Pool)) ML_ERROR("ThreadError", "Failed to create thread");
+		pthread_detach(Thread);
+	}
+	ML_RETURN(Pool);
+}
+
+ML_TYPE(MLThreadPoolT, (MLFunctionT), "thread::pool",
+// A pool of worker threads.
+//
+// :mini:`(P: thread::pool)(Args: any, ..., Fn: function): task`
+//    Queues :mini:`Fn(Args)` to run on one of the threads in :mini:`P` and returns a task which is completed with the result. :mini:`Fn` and :mini:`Args` must be thread-safe.
+//    Blocks if the queue of pending calls is full.
+	.call = (void *)ml_thread_pool_call,
+	.Constructor = (ml_value_t *)MLThreadPool
+);
+
+static ml_value_t *ML_TYPED_FN(ml_is_threadsafe, MLThreadPoolT, ml_value_t *Value) {
+	return NULL;
+}
+
+ML_METHOD("size", MLThreadPoolT) {
+//<Pool
+//>integer
+// Returns the number of threads in :mini:`Pool`.
+	ml_thread_pool_t *Pool = (ml_thread_pool_t *)Args[0];
+	return ml_integer(Pool->Size);
+}
+
+ML_METHOD("close", MLThreadPoolT) {
+//<Pool
+//>nil
+// Stops the threads in :mini:`Pool` once all pending calls have completed. No further calls can be added to :mini:`Pool`.
+	ml_thread_pool_t *Pool = (ml_thread_pool_t *)Args[0];
+	pthread_mutex_lock(Pool->Lock);
+	int Closed = Pool->Closed;
+	Pool->Closed = 1;
+	pthread_mutex_unlock(Pool->Lock);
+	if (Closed) return MLNil;
+	for (int I = 0; I < Pool->Size; ++I) {
+		ml_thread_job_t *Job = new(ml_thread_job_t);
+		ml_thread_ring_push(Pool->Ring, Job);
+	}
+	return MLNil;
+}
+
+#endif
+
 void ml_thread_init(stringmap_t *Globals) {
 #include "ml_thread_init.c"
 	stringmap_insert(MLThreadT->Exports, "sleep", MLThreadSleep);
 	stringmap_insert(MLThreadT->Exports, "channel", MLThreadChannelT);
+	stringmap_insert(MLThreadT->Exports, "queue", MLThreadQueueT);
+	stringmap_insert(MLThreadT->Exports, "move", MLThreadMove);
 	stringmap_insert(MLThreadT->Exports, "mutex", MLThreadMutexT);
 	stringmap_insert(MLThreadT->Exports, "condition", MLThreadConditionT);
 #ifdef ML_SCHEDULER
 	stringmap_insert(MLThreadT->Exports, "port", MLThreadPortT);
+	stringmap_insert(MLThreadT->Exports, "pool", MLThreadPoolT);
 #endif
 	if (Globals) {
 		stringmap_insert(Globals, "thread", MLThreadT);
@@ -13,6 +13,7 @@ extern ml_type_t MLThreadT[];
 void ml_thread_init(stringmap_t *Globals);
 void ml_default_thread_init(ml_context_t *Context);
 ml_value_t *ml_is_threadsafe(ml_value_t *Value);
+ml_value_t *ml_thread_move(ml_value_t *Value);
 
 #ifdef __cplusplus
 }
@@ -6,6 +6,7 @@
 #include <stdarg.h>
 #include <string.h>
 #include <stdint.h>
+#include <math.h>
 
 #include "ml_compiler2.h"
 #include "ml_runtime.h"
@@ -1477,6 +1478,136 @@ ML_FUNCTION(MLIsConstant) {
 	return MLNil;
 }
 
+// Sorting //
+
+typedef enum {
+	ML_SORT_INTEGER, ML_SORT_REAL, ML_SORT_STRING,
+	ML_SORT_KINDS
+} ml_sort_kind_t;
+
+#define ML_SORT_OPS 4
+
+static ml_value_t *MLSortOps[ML_SORT_OPS];
+// Bit (Cmp + 1) is set if A op B holds when A <> B = Cmp, for <, >, <= and >=.
+static const int MLSortMasks[ML_SORT_OPS] = {1, 4, 3, 6};
+static ml_type_t *MLSortTypes[ML_SORT_KINDS];
+// Builtin comparison methods as defined at startup, a sort only runs natively
+// if its comparison resolves to the same function (i.e. not redefined).
+static ml_value_t *MLSortBuiltins[ML_SORT_KINDS][ML_SORT_OPS];
+
+static void ml_values_sort_init() {
+	ml_methods_t *Methods = ml_context_get_static(MLRootContext, ML_METHODS_INDEX);
+	MLSortOps[0] = LessMethod;
+	MLSortOps[1] = GreaterMethod;
+	MLSortOps[2] = LessEqualMethod;
+	MLSortOps[3] = GreaterEqualMethod;
+	ml_value_t *Samples[ML_SORT_KINDS] = {ml_integer(1), ml_real(1), ml_cstring("")};
+	for (int Kind = 0; Kind < ML_SORT_KINDS; ++Kind) {
+		ml_value_t *Args[2] = {Samples[Kind], Samples[Kind]};
+		MLSortTypes[Kind] = ml_typeof(Samples[Kind]);
+		for (int Op = 0; Op < ML_SORT_OPS; ++Op) {
+			MLSortBuiltins[Kind][Op] = ml_method_search(Methods, (ml_method_t *)MLSortOps[Op], 2, Args);
+		}
+	}
+#ifdef ML_BIGINT
+	MLSortTypes[ML_SORT_INTEGER] = NULL;
+#endif
+}
+
+typedef struct {
+	union {
+		int64_t Integer;
+		double Real;
+		struct { const char *Chars; size_t Length; };
+	};
+	size_t Index;
+} ml_sort_entry_t;
+
+static inline int ml_sort_compare(ml_sort_kind_t Kind, const ml_sort_entry_t *A, const ml_sort_entry_t *B) {
+	switch (Kind) {
+	case ML_SORT_INTEGER: return (A->Integer > B->Integer) - (A->Integer < B->Integer);
+	case ML_SORT_REAL: return (A->Real > B->Real) - (A->Real < B->Real);
+	default:
+		if (A->Length < B->Length) {
+			return memcmp(A->Chars, B->Chars, A->Length) > 0 ? 1 : -1;
+		} else if (A->Length > B->Length) {
+			return memcmp(A->Chars, B->Chars, B->Length) < 0 ? -1 : 1;
+		} else {
+			int Compare = memcmp(A->Chars, B->Chars, A->Length);
+			return (Compare > 0) - (Compare < 0);
+		}
+	}
+}
+
+int ml_values_sort(ml_context_t *Context, ml_value_t *Compare, size_t Length, ml_value_t **Values, void **Items) {
+	if (Length < 2) return 0;
+	int Op = 0;
+	while (MLSortOps[Op] != Compare) if (++Op == ML_SORT_OPS) return 0;
+	ml_type_t *Type = ml_typeof(Values[0]);
+	ml_sort_kind_t Kind = 0;
+	while (MLSortTypes[Kind] != Type) if (++Kind == ML_SORT_KINDS) return 0;
+	ml_methods_t *Methods = ml_context_get_static(Context, ML_METHODS_INDEX);
+	ml_value_t *Args[2] = {Values[0], Values[0]};
+	if (ml_method_search(Methods, (ml_method_t *)Compare, 2, Args) != MLSortBuiltins[Kind][Op]) return 0;
+	ml_sort_entry_t *Source = asnew(ml_sort_entry_t, Length);
+	ml_sort_entry_t *Dest = asnew(ml_sort_entry_t, Length);
+	for (size_t I = 0; I < Length; ++I) {
+		ml_value_t *Value = Values[I];
+		if (ml_typeof(Value) != Type) return 0;
+		ml_sort_entry_t *Entry = Source + I;
+		Entry->Index = I;
+		switch (Kind) {
+		case ML_SORT_INTEGER:
+#ifdef ML_NANBOXING
+			Entry->Integer = ml_integer32_value(Value);
+#else
+			Entry->Integer = ml_integer64_value(Value);
+#endif
+			break;
+		case ML_SORT_REAL:
+			Entry->Real = ml_double_value(Value);
+			if (isnan(Entry->Real)) return 0;
+			break;
+		default:
+			Entry->Chars = ml_string_value(Value);
+			Entry->Length = ml_string_length(Value);
+			break;
+		}
+	}
+	// Same bottom-up merge (block boundaries and tie rule) as the generic sorts,
+	// so the result is identical to calling Compare on each pair.
+	int Mask = MLSortMasks[Op];
+	for (size_t BlockSize = 1; BlockSize < Length; BlockSize *= 2) {
+		ml_sort_entry_t *Target = Dest;
+		for (size_t Start = 0; Start < Length; Start += 2 * BlockSize) {
+			ml_sort_entry_t *IndexA = Source + Start;
+			ml_sort_entry_t *LimitA = Length - Start > BlockSize ? IndexA + BlockSize : Source + Length;
+			ml_sort_entry_t *IndexB = LimitA;
+			ml_sort_entry_t *LimitB = Source + Length - LimitA > BlockSize ? LimitA + BlockSize : Source + Length;
+			while (IndexA < LimitA && IndexB < LimitB) {
+				if ((Mask >> (ml_sort_compare(Kind, IndexA, IndexB) + 1)) & 1) {
+					*Target++ = *IndexA++;
+				} else {
+					*Target++ = *IndexB++;
+				}
+			}
+			Target = mempcpy(Target, IndexA, (LimitA - IndexA) * sizeof(ml_sort_entry_t));
+			Target = mempcpy(Target, IndexB, (LimitB - IndexB) * sizeof(ml_sort_entry_t));
+		}
+		ml_sort_entry_t *Temp = Source;
+		Source = Dest;
+		Dest = Temp;
+	}
+	void **Copy = anew(void *, Length);
+	memcpy(Copy, Values, Length * sizeof(void *));
+	for (size_t I = 0; I < Length; ++I) Values[I] = Copy[Source[I].Index];
+	if (Items) {
+		memcpy(Copy, Items, Length * sizeof(void *));
+		for (size_t I = 0; I < Length; ++I) Items[I] = Copy[Source[I].Index];
+	}
+	return 1;
+}
+
 // Iterators //
 
 void ml_iterate(ml_state_t *Caller, ml_value_t *Value) {
@@ -2324,6 +2455,7 @@ void ml_init(const char *ExecName, stringmap_t *Globals) {
 	ml_slice_init();
 	ml_map_init();
 	ml_set_init();
+	ml_values_sort_init();
 	ml_sequence_init(Globals);
 	ml_object_init(Globals);
 	ml_compiler_init(Globals);
@@ -327,6 +327,7 @@ void ml_value_find_all(ml_value_t *Value, void *Data, ml_value_find_fn RefFn);
 int ml_value_is_constant(ml_value_t *Value);
 
 void ml_values_order(ml_state_t *Caller, size_t Length, ml_value_t **Values, ml_value_t *Function, void (*finish)(ml_state_t *, size_t, int32_t *));
+int ml_values_sort(ml_context_t *Context, ml_value_t *Compare, size_t Length, ml_value_t **Values, void **Items);
 
 /// @}
 
@@ -825,6 +826,7 @@ struct ml_string_t {
 
 extern ml_type_t MLAddressT[];
 extern ml_type_t MLBufferT[];
+extern ml_type_t MLBufferViewT[];
 extern ml_type_t MLStringT[];
 
 extern ml_type_t MLRegexT[];
@@ -854,6 +856,7 @@ ml_value_t *ml_string(const char *Value, int Length) __attribute__((malloc));
 ml_value_t *ml_string_checked(const char *Value, int Length) __attribute__((malloc));
 ml_value_t *ml_string_unchecked(const char *Value, int Length) __attribute__((malloc));
 ml_value_t *ml_string_copy(const char *Value, int Length) __attribute__((malloc));
+ml_value_t *ml_string_intern(const char *Value, int Length);
 ml_value_t *ml_string_format(const char *Format, ...) __attribute__((malloc, format(printf, 1, 2)));
 #define ml_string_value ml_address_value
 #define ml_string_length ml_address_length
@@ -864,8 +867,8 @@ ml_value_t *ml_string_format(const char *Format, ...) __attribute__((malloc, for
 	(ml_value_t *)&String ## __COUNTER__; \
 })
 
-ml_value_t *ml_regex(const char *Value, int Length) __attribute__((malloc));
-ml_value_t *ml_regexi(const char *Value, int Length) __attribute__((malloc));
+ml_value_t *ml_regex(const char *Value, int Length);
+ml_value_t *ml_regexi(const char *Value, int Length);
 const char *ml_regex_pattern(const ml_value_t *Value) __attribute__((pure));
 
 int ml_regex_match(ml_value_t *Value, const char *Subject, int Length);
@@ -943,11 +946,28 @@ ml_value_t *ml_stringbuffer_get_value(ml_stringbuffer_t *Buffer) __attribute__ (
 ml_value_t *ml_stringbuffer_to_address(ml_stringbuffer_t *Buffer) __attribute__ ((malloc));
 ml_value_t *ml_stringbuffer_to_buffer(ml_stringbuffer_t *Buffer) __attribute__ ((malloc));
 ml_value_t *ml_stringbuffer_to_string(ml_stringbuffer_t *Buffer) __attribute__ ((malloc));
+ml_value_t *ml_stringbuffer_to_rope(ml_stringbuffer_t *Buffer) __attribute__ ((malloc));
+ml_value_t *ml_stringbuffer_intern(ml_stringbuffer_t *Buffer);
 
 size_t ml_stringbuffer_reader(ml_stringbuffer_t *Buffer, size_t Length);
 
 int ml_stringbuffer_drain(ml_stringbuffer_t *Buffer, void *Data, int (*callback)(void *, const char *, size_t));
 
+// Ropes //
+
+typedef struct ml_rope_t ml_rope_t;
+
+extern ml_type_t MLStringRopeT[];
+
+// Creates a rope referencing (not copying) Length bytes at Chars.
+ml_value_t *ml_rope(const char *Chars, size_t Length);
+ml_value_t *ml_rope_concat(ml_value_t *A, ml_value_t *B);
+// Returns the bytes from Start to End - 1 of Rope, sharing its contents.
+ml_value_t *ml_rope_slice(ml_value_t *Rope, size_t Start, size_t End);
+size_t ml_rope_length(ml_value_t *Rope);
+// Flattens Rope into a string, which is cached in Rope.
+ml_value_t *ml_rope_string(ml_value_t *Rope);
+
 // Defines for old function names
 
 #define ml_stringbuffer_add ml_stringbuffer_write
@@ -980,7 +1000,10 @@ struct ml_list_t {
 	ml_type_t *Type;
 	ml_list_node_t *Head, *Tail;
 	ml_list_node_t *CachedNode;
+	ml_list_node_t **Nodes;
 	int Length, CachedIndex;
+	int Indexed, Capacity, Offset;
+	char NodesLock;
 };
 
 ml_value_t *ml_list() __attribute__((malloc));
@@ -1143,7 +1166,7 @@ ml_value_t *ml_method_wrap(ml_value_t *Function, int Count, ml_type_t **Types);
 typedef struct ml_method_cached_t ml_method_cached_t;
 
 struct ml_method_cached_t {
-	ml_method_cached_t *Next, *MethodNext;
+	ml_method_cached_t *MethodNext;
 	ml_methods_t *Methods;
 	ml_method_t *Method;
 	ml_value_t *Callback;
@@ -1154,6 +1177,49 @@ struct ml_method_cached_t {
 ml_method_cached_t *ml_method_search_cached(ml_methods_t *Methods, ml_method_t *Method, int Count, ml_value_t **Args);
 ml_method_cached_t *ml_method_check_cached(ml_methods_t *Methods, ml_method_t *Method, ml_method_cached_t *Cached, int Count, ml_value_t **Args);
 
+// Inline caches for method call sites.
+// Each cache is immutable once published, a miss replaces the pointer in the call site with an updated copy.
+// Caches are invalidated by any method definition (which increments MLMethodEpoch) or by a change in method context.
+
+#define ML_METHOD_INLINE_CACHE_SIZE 4
+
+typedef struct {
+	ml_methods_t *Methods;
+	uint64_t Epoch;
+	int Size;
+	ml_method_cached_t *Entries[ML_METHOD_INLINE_CACHE_SIZE];
+} ml_method_inline_cache_t;
+
+extern uint64_t MLMethodEpoch;
+
+#ifdef ML_THREADS
+#define ML_METHOD_INLINE_LOAD(PTR) __atomic_load_n(PTR, __ATOMIC_ACQUIRE)
+#else
+#define ML_METHOD_INLINE_LOAD(PTR) *(PTR)
+#endif
+
+ml_value_t *ml_method_inline_update(ml_methods_t *Methods, ml_method_t *Method, ml_method_inline_cache_t **Slot, int Count, ml_value_t **Args);
+
+static inline int ml_method_inline_match(ml_method_cached_t *Cached, int Count, ml_value_t **Args) {
+	for (int I = Count; --I >= 0;) if (ml_typeof_deref(Args[I]) != Cached->Types[I]) return 0;
+	return 1;
+}
+
+static inline ml_value_t *ml_method_inline_search(ml_methods_t *Methods, ml_method_t *Method, ml_method_inline_cache_t **Slot, int Count, ml_value_t **Args) {
+	ml_method_inline_cache_t *Cache = ML_METHOD_INLINE_LOAD(Slot);
+	if (__builtin_expect(Cache && Cache->Methods == Methods && Cache->Epoch == ML_METHOD_INLINE_LOAD(&MLMethodEpoch), 1)) {
+		for (int I = 0; I < Cache->Size; ++I) {
+			ml_method_cached_t *Cached = Cache->Entries[I];
+			if (ml_method_inline_match(Cached, Count, Args)) {
+				ml_value_t *Callback = ML_METHOD_INLINE_LOAD(&Cached->Callback);
+				if (__builtin_expect(Callback != NULL, 1)) return Callback;
+				break;
+			}
+		}
+	}
+	return ml_method_inline_update(Methods, Method, Slot, Count, Args);
+}
+
 ml_value_t *ml_no_method_error(ml_method_t *Method, int Count, ml_value_t **Args);
 
 #define ML_CATEGORY "?"
@@ -1233,6 +1299,7 @@ ml_methods_t *ml_methods_context(ml_context_t *Context);
 
 typedef struct ml_map_t ml_map_t;
 typedef struct ml_map_node_t ml_map_node_t;
+typedef struct ml_map_table_t ml_map_table_t;
 typedef enum {
 	MAP_ORDER_INSERT,
 	MAP_ORDER_LRU,
@@ -1248,6 +1315,7 @@ struct ml_map_t {
 	ml_type_t *Type;
 	ml_map_node_t *Head, *Tail, *Root;
 	ml_method_cached_t *Cached;
+	ml_map_table_t *Table;
 	int Size;
 	ml_map_order_t Order;
 };
@@ -1377,6 +1445,7 @@ void ml_names_add(ml_value_t *Names, ml_value_t *Value);
 
 typedef struct ml_set_t ml_set_t;
 typedef struct ml_set_node_t ml_set_node_t;
+typedef struct ml_set_table_t ml_set_table_t;
 typedef enum {
 	SET_ORDER_INSERT,
 	SET_ORDER_LRU,
@@ -1391,6 +1460,7 @@ struct ml_set_t {
 	ml_type_t *Type;
 	ml_set_node_t *Head, *Tail, *Root;
 	ml_method_cached_t *Cached;
+	ml_set_table_t *Table;
 	int Size;
 	ml_set_order_t Order;
 };
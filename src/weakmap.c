@@ -7,7 +7,7 @@
 struct weakmap_node_t {
 	const char *Key;
 	void *Value;
-	size_t Hash, Offset;
+	size_t Hash, Offset, Length;
 };
 
 static inline size_t weakmap_hash(const char *Key, int Length) {
@@ -34,6 +34,7 @@ static void *weakmap_grow(weakmap_t *Map, size_t Size) {
 		weakmap_node_t Insert;
 		Insert.Key = Old->Key;
 		Insert.Hash = Old->Hash;
+		Insert.Length = Old->Length;
 		Insert.Value = Old->Value;
 		Insert.Offset = 0;
 		size_t Index = Insert.Hash & Mask;
@@ -78,7 +79,7 @@ int weakmap_check(weakmap_t *Map) {
 	weakmap_node_t *Node = Map->Nodes;
 	if (Node) for (int I = Map->Mask + 1; --I >= 0; ++Node) {
 		if (Node->Value) {
-			if (weakmap_hash(Node->Key, strlen(Node->Key)) != Node->Hash) {
+			if (weakmap_hash(Node->Key, Node->Length) != Node->Hash) {
 				Corrupted = 1;
 				fprintf(stderr, "Weakmap corrupted\n");
 				void *Base = GC_base((void *)(Node->Key - 8));
@@ -109,6 +110,7 @@ void *weakmap_insert(weakmap_t *Map, const char *Key, int Length, void *(*missin
 		weakmap_node_t *Node = Nodes + Index;
 		Node->Key = weakmap_copy_key(Key, Length);
 		Node->Hash = Hash;
+		Node->Length = Length;
 		void *Result = Node->Value = missing(Node->Key, Length);
 		GC_general_register_disappearing_link(&Node->Value, Result);
 #ifdef ML_HOSTTHREADS
@@ -122,8 +124,8 @@ void *weakmap_insert(weakmap_t *Map, const char *Key, int Length, void *(*missin
 	size_t Offset = 0;
 	weakmap_node_t *Node = Nodes + Index;
 	while (Offset <= Node->Offset) {
-		if (Node->Hash == Hash) {
-			if (Node->Value && !strncmp(Node->Key, Key, Length)) {
+		if (Node->Hash == Hash && Node->Length == Length) {
+			if (Node->Value && !memcmp(Node->Key, Key, Length)) {
 #ifdef ML_HOSTTHREADS
 				pthread_mutex_unlock(Map->Lock);
 #endif
@@ -146,6 +148,7 @@ void *weakmap_insert(weakmap_t *Map, const char *Key, int Length, void *(*missin
 	weakmap_node_t Insert;
 	Insert.Hash = Hash;
 	Insert.Key = weakmap_copy_key(Key, Length);
+	Insert.Length = Length;
 	Insert.Offset = Offset;
 	void *Result = Insert.Value = missing(Insert.Key, Length);
 	//fprintf(stderr, "Creating missing value for key %s: space %ld ->", Insert.Key, Map->Space);